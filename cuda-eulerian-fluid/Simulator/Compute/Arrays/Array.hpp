@@ -20,7 +20,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         using LocationTag = Location::DeviceTag;
         static constexpr LocationTag Location = Location::Device;
 
-        using Ref          = Ref<Array>;
+        using Ref          = HF::Ref<Array>;
         using Value        = _Value;
         using BuiltInValue = typename Traits<Value>::BuiltInType;
         using Dims         = IntN<_Order>;
@@ -0,0 +1,226 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_BIT_MASK_ACCESSOR_HPP
+#define HF_SIMULATOR_COMPUTE_BIT_MASK_ACCESSOR_HPP
+
+#include <Simulator/Simulator.hpp>
+
+#if defined(_MSC_VER) && !defined(__CUDA_ARCH__)
+#include <intrin.h>
+#endif
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    namespace Detail
+    {
+        /**
+         * \brief Atomically sets the given bits of a word, as cells sharing a word may be written
+         *        by different threads.
+         */
+        HF_HDINLINE void atomicSetBits(uint* word, uint bits)
+        {
+            #if defined(__CUDA_ARCH__)
+            atomicOr(word, bits);
+            #elif defined(_MSC_VER)
+            _InterlockedOr(reinterpret_cast<volatile long*>(word), long(bits));
+            #else
+            __atomic_fetch_or(word, bits, __ATOMIC_RELAXED);
+            #endif
+        }
+
+        /**
+         * \brief Atomically clears the given bits of a word.
+         */
+        HF_HDINLINE void atomicClearBits(uint* word, uint bits)
+        {
+            #if defined(__CUDA_ARCH__)
+            atomicAnd(word, ~bits);
+            #elif defined(_MSC_VER)
+            _InterlockedAnd(reinterpret_cast<volatile long*>(word), long(~bits));
+            #else
+            __atomic_fetch_and(word, ~bits, __ATOMIC_RELAXED);
+            #endif
+        }
+    }
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Reads a mask of one bit per cell, packed along the X axis into the words of a buffer
+     *        whose first dimension is that of the mask divided by WordBits (rounded up). Cells
+     *        read as 0 or 1, and rows can also be read a word (i.e. WordBits cells) at a time.
+     * \tparam _Buffer Type of the buffer holding the words.
+     */
+    template <typename _Buffer>
+    struct BitMaskConstAccessor
+    {
+    public:
+        static constexpr uint Order = _Buffer::Order;
+
+        using Buffer        = _Buffer;
+        using WordAccessor  = typename _Buffer::ConstAccessor;
+        using Word          = typename _Buffer::Value;
+        using Value         = uchar;
+        using Index         = typename _Buffer::Index;
+
+        static_assert(std::is_same<Word, uint>::value, "Bit masks must be packed into 32-bit words.");
+
+        static constexpr uint WordBits  = 32;
+        static constexpr uint WordShift = 5;
+
+        /**
+         * \brief Rows are read a word at a time with getWord, instead of through pointers.
+         */
+        static constexpr bool IsRowContiguous = true;
+
+    public:
+        BitMaskConstAccessor() = default;
+
+        BitMaskConstAccessor(const WordAccessor& words, const Index& dims)
+            : _words(words)
+            , _maxIdx(dims - 1)
+        {
+        }
+
+        HF_COPY_IMPLEMENTATION(BitMaskConstAccessor, default)
+
+        HF_MOVE_IMPLEMENTATION(BitMaskConstAccessor, default)
+
+    public:
+        /**
+         * \brief Reads the bit of the cell at the given index. Indices outside of the mask are
+         *        clamped to its edges.
+         */
+        HF_HDINLINE Value getValue(const Index& idx) const
+        {
+            const Index cellIdx = clamp(idx, Index(0), _maxIdx);
+            return Value((getWord(cellIdx) >> (cellIdx[0] & (WordBits - 1))) & 1u);
+        }
+
+        /**
+         * \brief Reads the word holding the bit of the cell at the given index, bit i being that
+         *        of the cell at X = (idx.x & ~(WordBits - 1)) + i. Words outside of the mask are
+         *        clamped to its edges.
+         */
+        HF_HDINLINE Word getWord(const Index& idx) const
+        {
+            return _words.getValue(getWordIndex(idx));
+        }
+
+        /**
+         * \brief Returns the largest valid index, i.e. the dimensions of the mask minus one.
+         */
+        HF_HDINLINE const Index& getMaxIndex() const
+        {
+            return _maxIdx;
+        }
+
+        /**
+         * \brief Returns the index of the word holding the bit of the cell at the given index.
+         */
+        static HF_HDINLINE Index getWordIndex(const Index& idx)
+        {
+            Index wordIdx = idx;
+            wordIdx[0] >>= WordShift;
+
+            return wordIdx;
+        }
+
+    private:
+        WordAccessor _words;
+        Index        _maxIdx;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Reads and writes a mask of one bit per cell (see BitMaskConstAccessor). Writes are
+     *        atomic, so that threads may write neighbouring cells sharing a word.
+     * \tparam _Buffer Type of the buffer holding the words.
+     */
+    template <typename _Buffer>
+    struct BitMaskAccessor
+    {
+    public:
+        static constexpr uint Order = _Buffer::Order;
+
+        using Buffer        = _Buffer;
+        using WordAccessor  = typename _Buffer::Accessor;
+        using ConstAccessor = BitMaskConstAccessor<_Buffer>;
+        using Word          = typename _Buffer::Value;
+        using Value         = uchar;
+        using Index         = typename _Buffer::Index;
+
+        static constexpr uint WordBits  = ConstAccessor::WordBits;
+        static constexpr uint WordShift = ConstAccessor::WordShift;
+
+        /**
+         * \brief Rows are read a word at a time with getWord, instead of through pointers.
+         */
+        static constexpr bool IsRowContiguous = true;
+
+    public:
+        BitMaskAccessor() = default;
+
+        BitMaskAccessor(const WordAccessor& words, const Index& dims)
+            : _words(words)
+            , _maxIdx(dims - 1)
+        {
+        }
+
+        HF_COPY_IMPLEMENTATION(BitMaskAccessor, default)
+
+        HF_MOVE_IMPLEMENTATION(BitMaskAccessor, default)
+
+    public:
+        /**
+         * \brief Reads the bit of the cell at the given index. Indices outside of the mask are
+         *        clamped to its edges.
+         */
+        HF_HDINLINE Value getValue(const Index& idx) const
+        {
+            const Index cellIdx = clamp(idx, Index(0), _maxIdx);
+            return Value((getWord(cellIdx) >> (cellIdx[0] & (WordBits - 1))) & 1u);
+        }
+
+        /**
+         * \brief Sets (value != 0) or clears the bit of the cell at the given index.
+         */
+        HF_HDINLINE void setValue(const Index& idx, const Value& value)
+        {
+            Word* word = _words.getPtr(ConstAccessor::getWordIndex(idx));
+            const Word bit = 1u << (idx[0] & (WordBits - 1));
+
+            if (value != 0)
+                Detail::atomicSetBits(word, bit);
+            else
+                Detail::atomicClearBits(word, bit);
+        }
+
+        /**
+         * \brief Reads the word holding the bit of the cell at the given index (see
+         *        BitMaskConstAccessor::getWord).
+         */
+        HF_HDINLINE Word getWord(const Index& idx) const
+        {
+            return _words.getValue(ConstAccessor::getWordIndex(idx));
+        }
+
+        /**
+         * \brief Returns the largest valid index, i.e. the dimensions of the mask minus one.
+         */
+        HF_HDINLINE const Index& getMaxIndex() const
+        {
+            return _maxIdx;
+        }
+
+    private:
+        WordAccessor _words;
+        Index        _maxIdx;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_BIT_MASK_ACCESSOR_HPP */
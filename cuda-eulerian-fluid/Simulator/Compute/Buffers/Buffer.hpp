@@ -9,16 +9,25 @@
 #include <Simulator/Compute/Buffers/BufferCoordMode.hpp>
 #include <Simulator/Compute/Buffers/BufferFilterMode.hpp>
 #include <Simulator/Compute/Buffers/BufferSampler.hpp>
+#include <Simulator/Compute/Buffers/BufferStorage.hpp>
 #include <Simulator/Compute/Buffers/LinearIndexer.hpp>
 #include <Simulator/Compute/Buffers/MortonIndexer.hpp>
+#include <Simulator/Compute/Buffers/NumpyFormat.hpp>
 #include <Simulator/Compute/Buffers/TiledIndexer.hpp>
-#include <Simulator/ThirdParty/npy.hpp>
+#include <Simulator/Compute/Memory/DeviceMemoryResource.hpp>
+#include <Simulator/Compute/Memory/HostMemoryResource.hpp>
+#include <Simulator/Compute/Memory/MappedFileMemoryResource.hpp>
+#include <Simulator/Utility/Memory/MappedFile.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Compute)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <typename _Location, uint _Order, typename _Value, typename _Indexer>
+    /**
+     * \brief Base of the buffers holding values of the given type, kept in memory as the given
+     *        storage type (see BufferStorage).
+     */
+    template <typename _Location, uint _Order, typename _Value, typename _Indexer, typename _Storage = _Value>
     class BaseBuffer
     {
     public:
@@ -29,6 +38,8 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
         using Base          = BaseBuffer;
         using Value         = _Value;
+        using Storage       = _Storage;
+        using Conversion    = BufferStorage<_Value, _Storage>;
         using Dims          = IntN<_Order>;
         using Index         = IntN<_Order>;
         using Coords        = FloatN<_Order>;
@@ -77,7 +88,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          * \brief 
          * \return 
          */
-        const Value* getPtr() const
+        const Storage* getPtr() const
         {
             return _ptr;
         }
@@ -86,7 +97,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          * \brief 
          * \return 
          */
-        Value* getPtr()
+        Storage* getPtr()
         {
             return _ptr;
         }
@@ -97,7 +108,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         ConstAccessor getConstAccessor() const
         {
-            return ConstAccessor(_indexer, _ptr);
+            return ConstAccessor(_indexer, _ptr, _dims);
         }
         
         /**
@@ -106,7 +117,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         Accessor getAccessor()
         {
-            return Accessor(_indexer, _ptr);
+            return Accessor(_indexer, _ptr, _dims);
         }
 
         /**
@@ -134,43 +145,66 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         }
 
     protected:
-        Dims    _dims;
-        uint    _storage;
-        Value*  _ptr;
-        Indexer _indexer;
+        Dims     _dims;
+        uint     _storage;
+        Storage* _ptr;
+        Indexer  _indexer;
     };
 
+    template <typename _Location, uint _Order, typename _Value, typename _Indexer, typename _Storage>
+    constexpr typename BaseBuffer<_Location, _Order, _Value, _Indexer, _Storage>::LocationTag BaseBuffer<_Location, _Order, _Value, _Indexer, _Storage>::Location;
+
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <typename _Location, uint _Order, typename _Value, typename _Indexer>
+    template <typename _Location, uint _Order, typename _Value, typename _Indexer, typename _Storage = _Value>
     class Buffer;
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint _Order, typename _Value, typename _Indexer>
-    class Buffer<Location::HostTag, _Order, _Value, _Indexer> : public BaseBuffer<Location::HostTag, _Order, _Value, _Indexer>
+    template <uint _Order, typename _Value, typename _Indexer, typename _Storage>
+    class Buffer<Location::HostTag, _Order, _Value, _Indexer, _Storage> : public BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>
     {
     public:
-        using Ref           = Ref<Buffer>;
-        using Value         = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer>::Value;
-        using Dims          = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer>::Dims;
-        using Index         = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer>::Index;
-        using Indexer       = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer>::Indexer;
-        using Accessor      = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer>::Accessor;
-        using ConstAccessor = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer>::ConstAccessor;
+        using Ref           = HF::Ref<Buffer>;
+        using Value         = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::Value;
+        using Storage       = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::Storage;
+        using Conversion    = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::Conversion;
+        using Dims          = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::Dims;
+        using Index         = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::Index;
+        using Indexer       = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::Indexer;
+        using Accessor      = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::Accessor;
+        using ConstAccessor = typename BaseBuffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::ConstAccessor;
+
+        /**
+         * \brief Alignment of the host allocations, in bytes.
+         */
+        static constexpr std::size_t Alignment = 64;
+
+        /**
+         * \brief Alignment of the rows of buffers created with BufferFlags::AlignRows, in
+         *        elements. The smallest no. of elements spanning a multiple of Alignment bytes.
+         */
+        static constexpr uint RowAlignment = uint(Alignment / std::min(Alignment, sizeof(Storage) & (~sizeof(Storage) + 1)));
+
+        /**
+         * \brief Max. size of the staging block used to write buffers not laid out linearly into
+         *        files, in bytes.
+         */
+        static constexpr std::size_t StagingSize = 4 * 1024 * 1024;
 
     protected:
-        Buffer(const Dims& dims, BufferFlags flags)
-            : BaseBuffer<Location::HostTag, _Order, Value, Indexer>::BaseBuffer(dims)
+        Buffer(const Dims& dims, BufferFlags flags, const MemoryResource::Ref& resource, bool zeroed)
+            : BaseBuffer<Location::HostTag, _Order, Value, Indexer, Storage>::BaseBuffer(dims)
             , _flags(flags)
+            , _resource(resource)
         {
             // Initialize and determine storage required by the indexer.
 
-            _storage = _indexer.setup(dims);
+            this->_storage = setupIndexer(this->_indexer, dims, flags);
 
-            // Acquire host-allocated memory.
+            // Acquire host-allocated memory from the resource.
 
-            HF_CUDA(MallocHost(&_ptr, sizeof(Value) * _storage, static_cast<unsigned>(flags)));
+            this->_ptr = static_cast<Storage*>(_resource->allocate(sizeof(Storage) * this->_storage, Alignment, zeroed));
         }
 
     public:
@@ -178,10 +212,10 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
         ~Buffer()
         {
-            // Free host-allocated memory and reset pointer.
+            // Return host-allocated memory and reset pointer.
 
-            HF_IGNORE_THROW(HF_CUDA(FreeHost(_ptr)));
-            _ptr = nullptr;
+            _resource->deallocate(this->_ptr, sizeof(Storage) * this->_storage, Alignment);
+            this->_ptr = nullptr;
         }
 
         HF_COPY_IMPLEMENTATION(Buffer, delete)
@@ -199,89 +233,358 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         }
 
         /**
-         * \brief
-         * \param fileName
-         * \return
+         * \brief Returns the memory resource the buffer storage was acquired from.
          */
-        bool loadFromFile(const std::string& filename) const
+        const MemoryResource::Ref& getMemoryResource() const
         {
-            // TODO.
-            return false;
+            return _resource;
         }
 
         /**
-         * \brief
-         * \param fileName
-         * \return
+         * \brief Loads the contents of the buffer from a NumPy (.npy) file, whose shape must be
+         *        the dimensions of the buffer in reverse order (i.e. the X axis last), followed by
+         *        the no. of components for vector values. Any scalar type is converted.
+         *
+         *        Files laid out exactly as the storage of the buffer are not read at all: the
+         *        storage is replaced by a copy-on-write mapping of the file, so pages are only
+         *        read once accessed. Otherwise, the contents are converted in parallel.
+         * \param filename Path to the file.
+         * \return Whether the file could be loaded into the buffer.
          */
-        bool saveToFile(const std::string& filename) const
+        bool loadFromFile(const std::string& filename)
         {
-            // Determine total amount of elements in the buffer.
+            using Element = NumpyElement<Value>;
+
+            const MappedFile::Ref file = MappedFile::Create(filename);
+            NumpyHeader header;
 
-            const ulong count = compMul(_dims);
+            if (!file->isValid() || !NumpyFormat::readHeader(file->getData(), file->getSize(), header))
+                return false;
 
-            // Copy shape into intermediate buffer.
+            // Check the shape and size of the payload.
 
             std::vector<ulong> shape;
-            shape.reserve(_Order);
 
-            for (ulong i = _Order; i > 0; --i)
-                shape.push_back(_dims[i - 1]);
+            for (uint i = _Order; i > 0; --i)
+                shape.push_back(ulong(this->_dims[i - 1]));
+
+            if (Element::Components > 1)
+                shape.push_back(Element::Components);
+
+            const ulong count = compMul(this->_dims);
+            const std::size_t payloadSize = NumpyFormat::getScalarSize(header.descr) * Element::Components * count;
+
+            if (header.shape != shape || payloadSize == 0 || file->getSize() - header.payloadOffset < payloadSize)
+                return false;
 
-            // Copy buffer contents into intermediate buffer.
+            // Use the payload in place if possible.
 
-            std::vector<_Value> data;
-            data.reserve(count);
-            std::copy(_ptr, _ptr + count, std::back_inserter<std::vector<_Value>>(data));
+            if (canMapFile(file, header))
+            {
+                const MemoryResource::Ref resource = MappedFileMemoryResource::Create(file, header.payloadOffset, payloadSize, _resource);
 
-            // Write buffer into Numpy format
+                _resource->deallocate(this->_ptr, sizeof(Storage) * this->_storage, Alignment);
+                _resource = resource;
+
+                this->_ptr = reinterpret_cast<Storage*>(file->getData() + header.payloadOffset);
+                return true;
+            }
+
+            return convertFromFile(file, header);
+        }
+
+        /**
+         * \brief Saves the contents of the buffer into a NumPy (.npy) file, with the dimensions
+         *        of the buffer in reverse order (i.e. the X axis last) as its shape, followed by
+         *        the no. of components for vector values. Values kept in another storage type
+         *        are written as their value type.
+         *
+         *        The file is streamed: unpadded linear storage is written straight from the
+         *        buffer, and any other layout is de-swizzled through a staging block of at most
+         *        StagingSize bytes.
+         * \param filename Path to the file.
+         * \return Whether the buffer could be saved.
+         */
+        bool saveToFile(const std::string& filename) const
+        {
+            using Element = NumpyElement<Value>;
+            using Scalar = typename Element::Scalar;
+
+            std::ofstream stream(filename, std::ofstream::binary);
+
+            if (!stream.good())
+                return false;
+
+            // Write header.
+
+            NumpyHeader header;
+            header.descr = NumpyFormat::getDescr<Scalar>();
+            header.fortranOrder = false;
+
+            for (uint i = _Order; i > 0; --i)
+                header.shape.push_back(ulong(this->_dims[i - 1]));
+
+            if (Element::Components > 1)
+                header.shape.push_back(Element::Components);
+
+            NumpyFormat::writeHeader(stream, header);
+
+            // Write payload, directly if storage is laid out as the file, or otherwise through
+            // the staging block, a bunch of rows at a time.
+
+            const std::size_t elementSize = sizeof(Scalar) * Element::Components;
+            const bool isPacked = Conversion::IsNative && sizeof(Value) == elementSize;
+            const ulong count = compMul(this->_dims);
+
+            if (std::is_same<Indexer, LinearIndexer<_Order>>::value && this->_storage == count && isPacked)
+            {
+                const char* data = reinterpret_cast<const char*>(this->_ptr);
+                const std::size_t size = sizeof(Value) * count;
+
+                for (std::size_t offset = 0; offset < size; offset += StagingSize)
+                    stream.write(data + offset, std::streamsize(std::min(StagingSize, size - offset)));
+            }
+            else
+            {
+                const uint rowLength = uint(this->_dims[0]);
+                const uint rowCount = uint(count / rowLength);
+                const uint chunkRowCount = uint(std::max<std::size_t>(1, StagingSize / (elementSize * rowLength)));
+                const Dims dims = this->_dims;
+                const ConstAccessor accessor = this->getConstAccessor();
+
+                const std::unique_ptr<Scalar, AlignedDeleter> staging(static_cast<Scalar*>(alignedAlloc(elementSize * rowLength * std::min(chunkRowCount, rowCount), Alignment)));
+
+                for (uint firstRow = 0; firstRow < rowCount; firstRow += chunkRowCount)
+                {
+                    const uint chunkRows = std::min(chunkRowCount, rowCount - firstRow);
+
+                    HostExecutor::parallelFor(chunkRows, rowLength, [&](uint begin, uint end)
+                    {
+                        for (uint i = begin; i < end; ++i)
+                        {
+                            Index index;
+                            uint remainder = firstRow + i;
+
+                            for (uint axis = 1; axis < _Order; ++axis)
+                            {
+                                index[axis] = int(remainder % uint(dims[axis]));
+                                remainder /= uint(dims[axis]);
+                            }
+
+                            index[0] = 0;
+                            Scalar* dst = staging.get() + ulong(i) * rowLength * Element::Components;
+
+                            if (Indexer::IsRowContiguous && isPacked)
+                            {
+                                std::memcpy(dst, accessor.getPtr(index), elementSize * rowLength);
+                                continue;
+                            }
+
+                            for (uint x = 0; x < rowLength; ++x)
+                            {
+                                index[0] = int(x);
+                                Value value = accessor.getValue(index);
+
+                                for (uint c = 0; c < Element::Components; ++c)
+                                    *dst++ = Element::getComponent(value, c);
+                            }
+                        }
+                    });
+
+                    stream.write(reinterpret_cast<const char*>(staging.get()), std::streamsize(elementSize * rowLength * chunkRows));
+                }
+            }
+
+            return stream.good();
+        }
+
+        /**
+         * \brief Returns the size of the storage a buffer of the given dimensions would acquire
+         *        from its memory resource, in bytes.
+         * \param dims Dimensions of the buffer.
+         * \param flags Flags of the buffer.
+         */
+        static std::size_t getStorageSize(const Dims& dims, BufferFlags flags = BufferFlags::Default)
+        {
+            Indexer indexer;
+            return sizeof(Storage) * setupIndexer(indexer, dims, flags);
+        }
+
+    private:
+        bool canMapFile(const MappedFile::Ref& file, const NumpyHeader& header) const
+        {
+            #if HF_HOST_MEMORY_MAPPING == true
+            using Element = NumpyElement<Value>;
+            using Scalar = typename Element::Scalar;
+
+            // The payload must match the storage byte by byte, which must thus be unpadded and
+            // linear, and be suitably aligned. Page-locked storage is never replaced.
+
+            const bool isLinear = std::is_same<Indexer, LinearIndexer<_Order>>::value && this->_storage == uint(compMul(this->_dims));
+            const bool isPacked = Conversion::IsNative && sizeof(Value) == sizeof(Scalar) * Element::Components;
+            const bool isAligned = (reinterpret_cast<std::uintptr_t>(file->getData()) + header.payloadOffset) % alignof(Value) == 0;
+
+            return file->isMapped() && isLinear && isPacked && isAligned && !header.fortranOrder
+                && header.descr == NumpyFormat::getDescr<Scalar>();
+            #else
+            return false;
+            #endif
+        }
+
+        bool convertFromFile(const MappedFile::Ref& file, const NumpyHeader& header)
+        {
+            using Element = NumpyElement<Value>;
+            using Scalar = typename Element::Scalar;
+
+            const auto reader = NumpyFormat::getScalarReader<Scalar>(header.descr);
+
+            if (reader == nullptr)
+                return false;
+
+            const char* payload = file->getData() + header.payloadOffset;
+            const std::size_t scalarSize = NumpyFormat::getScalarSize(header.descr);
+            const uint rowLength = uint(this->_dims[0]);
+            const uint rowCount = uint(compMul(this->_dims) / rowLength);
+            const Dims dims = this->_dims;
+            const bool fortranOrder = header.fortranOrder;
+            Accessor accessor = this->getAccessor();
+
+            file->adviseSequential(header.payloadOffset, scalarSize * Element::Components * rowCount * rowLength);
+
+            // Convert row by row. Elements of C-ordered files are stored with X varying fastest,
+            // and those of Fortran-ordered ones with X varying slowest (besides components).
+
+            HostExecutor::parallelFor(rowCount, rowLength, [&](uint begin, uint end)
+            {
+                for (uint row = begin; row < end; ++row)
+                {
+                    Index index;
+                    uint remainder = row;
+
+                    for (uint axis = 1; axis < _Order; ++axis)
+                    {
+                        index[axis] = int(remainder % uint(dims[axis]));
+                        remainder /= uint(dims[axis]);
+                    }
+
+                    for (uint x = 0; x < rowLength; ++x)
+                    {
+                        index[0] = int(x);
+
+                        ulong element = 0;
+
+                        if (fortranOrder)
+                        {
+                            for (uint axis = 0; axis < _Order; ++axis)
+                                element = element * ulong(dims[axis]) + ulong(index[axis]);
+                        }
+                        else
+                        {
+                            element = ulong(row) * rowLength + x;
+                        }
+
+                        Value value;
+
+                        for (uint c = 0; c < Element::Components; ++c)
+                        {
+                            const ulong offset = fortranOrder ? ulong(c) * rowCount * rowLength + element
+                                                              : element * Element::Components + c;
+
+                            Element::getComponent(value, c) = reader(payload + scalarSize * offset);
+                        }
+
+                        accessor.setValue(index, value);
+                    }
+                }
+            });
 
-            npy::SaveArrayAsNumpy(filename, false, _Order, shape.data(), data);
             return true;
         }
 
+        static uint setupIndexer(Indexer& indexer, const Dims& dims, BufferFlags flags)
+        {
+            using IsRowContiguous = std::integral_constant<bool, Indexer::IsRowContiguous>;
+            return setupIndexer(IsRowContiguous(), indexer, dims, flags);
+        }
 
-    protected:
-        BufferFlags _flags;
+        static uint setupIndexer(std::true_type, Indexer& indexer, const Dims& dims, BufferFlags flags)
+        {
+            const uint rowAlignment = hasFlags(flags, BufferFlags::AlignRows) ? RowAlignment : 1;
+            return indexer.setup(dims, rowAlignment, int(getHaloWidth(flags)));
+        }
+
+        static uint setupIndexer(std::false_type, Indexer& indexer, const Dims& dims, BufferFlags)
+        {
+            return indexer.setup(dims);
+        }
 
+    protected:
+        BufferFlags         _flags;
+        MemoryResource::Ref _resource;
 
     public:
         static Ref Create(const Dims& dims, BufferFlags flags = BufferFlags::Default)
         {
-            return Ref(new Buffer(dims, flags));
+            return Ref(new Buffer(dims, flags, HostMemoryResource::Get(flags), false));
+        }
+
+        /**
+         * \brief Creates a new buffer whose storage is acquired from the given memory resource.
+         * \param dims Dimensions of the buffer.
+         * \param resource Memory resource to acquire the storage from.
+         * \param zeroed Whether the buffer must start zero-filled.
+         * \param flags Flags of the buffer. Only the layout ones (i.e. AlignRows and the halo)
+         *              are honored, allocation policies being up to the resource.
+         */
+        static Ref Create(const Dims& dims, const MemoryResource::Ref& resource, bool zeroed = false, BufferFlags flags = BufferFlags::Default)
+        {
+            return Ref(new Buffer(dims, flags, resource, zeroed));
         }
 
         static Ref CreateWithParametersFrom(const Ref& other, const Dims& dims)
         {
-            return Create(dims, other->_flags);
+            return Ref(new Buffer(dims, other->_flags, other->_resource, false));
         }
     };
 
+    template <uint _Order, typename _Value, typename _Indexer, typename _Storage>
+    constexpr std::size_t Buffer<Location::HostTag, _Order, _Value, _Indexer, _Storage>::StagingSize;
+
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint _Order, typename _Value, typename _Indexer>
-    class Buffer<Location::DeviceTag, _Order, _Value, _Indexer> : public BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer>
+    #if HF_CPU_ONLY == false
+
+    template <uint _Order, typename _Value, typename _Indexer, typename _Storage>
+    class Buffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage> : public BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>
     {
     public:
-        using Ref           = Ref<Buffer>;
-        using Value         = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer>::Value;
-        using Dims          = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer>::Dims;
-        using Index         = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer>::Index;
-        using Indexer       = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer>::Indexer;
-        using Accessor      = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer>::Accessor;
-        using ConstAccessor = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer>::ConstAccessor;
+        using Ref           = HF::Ref<Buffer>;
+        using Value         = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::Value;
+        using Storage       = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::Storage;
+        using Conversion    = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::Conversion;
+        using Dims          = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::Dims;
+        using Index         = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::Index;
+        using Indexer       = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::Indexer;
+        using Accessor      = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::Accessor;
+        using ConstAccessor = typename BaseBuffer<Location::DeviceTag, _Order, _Value, _Indexer, _Storage>::ConstAccessor;
+
+        /**
+         * \brief Alignment of the device allocations, in bytes.
+         */
+        static constexpr std::size_t Alignment = 256;
 
     protected:
-        Buffer(const Dims& dims)
-            : BaseBuffer<Location::DeviceTag, _Order, Value, Indexer>::BaseBuffer(dims)
+        Buffer(const Dims& dims, const MemoryResource::Ref& resource, bool zeroed)
+            : BaseBuffer<Location::DeviceTag, _Order, Value, Indexer, Storage>::BaseBuffer(dims)
+            , _resource(resource)
         {
             // Initialize and determine storage required by the indexer.
 
-            _storage = _indexer.setup(dims);
+            this->_storage = this->_indexer.setup(dims);
 
-            // Acquire device-allocated memory.
+            // Acquire device-allocated memory from the resource.
 
-            HF_CUDA(Malloc(&_ptr, sizeof(Value) * _storage));
+            this->_ptr = static_cast<Storage*>(_resource->allocate(sizeof(Storage) * this->_storage, Alignment, zeroed));
         }
 
     public:
@@ -289,82 +592,149 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
         ~Buffer()
         {
-            // Free device-allocated memory and reset pointer.
+            // Return device-allocated memory and reset pointer.
 
-            HF_IGNORE_THROW(HF_CUDA(Free(_ptr)));
-            _ptr = nullptr;
+            _resource->deallocate(this->_ptr, sizeof(Storage) * this->_storage, Alignment);
+            this->_ptr = nullptr;
         }
 
         HF_COPY_IMPLEMENTATION(Buffer, delete)
         
         HF_MOVE_IMPLEMENTATION(Buffer, default)
 
+    public:
+        /**
+         * \brief Returns the memory resource the buffer storage was acquired from.
+         */
+        const MemoryResource::Ref& getMemoryResource() const
+        {
+            return _resource;
+        }
+
+    protected:
+        MemoryResource::Ref _resource;
+
     public:
         static Ref Create(const Dims& dims)
         {
-            return Ref(new Buffer(dims));
+            return Ref(new Buffer(dims, DeviceMemoryResource::Get(), false));
+        }
+
+        /**
+         * \brief Creates a new buffer whose storage is acquired from the given memory resource.
+         * \param dims Dimensions of the buffer.
+         * \param resource Memory resource to acquire the storage from.
+         * \param zeroed Whether the buffer must start zero-filled.
+         */
+        static Ref Create(const Dims& dims, const MemoryResource::Ref& resource, bool zeroed = false)
+        {
+            return Ref(new Buffer(dims, resource, zeroed));
         }
 
         static Ref CreateWithParametersFrom(const Ref& other, const Dims& dims)
         {
-            return Create(dims);
+            return Ref(new Buffer(dims, other->_resource, false));
         }
     };
 
+    #endif
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    namespace Detail
+    {
+        /**
+         * \brief Returns the flags of a buffer that change how its storage is laid out, i.e. the
+         *        row alignment and the halo. Buffers without flags (e.g. device ones) are never
+         *        padded.
+         */
+        template <typename Buffer, typename = void>
+        struct LayoutFlags
+        {
+            static BufferFlags get(const Buffer& /* buffer */)
+            {
+                return BufferFlags::Default;
+            }
+        };
+
+        template <typename Buffer>
+        struct LayoutFlags<Buffer, typename std::conditional<true, void, decltype(std::declval<const Buffer&>().getFlags())>::type>
+        {
+            static BufferFlags get(const Buffer& buffer)
+            {
+                return buffer.getFlags() & (BufferFlags::AlignRows | BufferFlags::HaloMask);
+            }
+        };
+    }
+
+    /**
+     * \brief Returns whether two buffers of the same dimensions store their values the same way,
+     *        so that one can be copied into the other as raw storage. Equal storage sizes are not
+     *        enough: e.g. 6x2 floats take 32 elements both with aligned rows and with a halo.
+     */
+    template <typename SrcBuffer, typename DstBuffer>
+    bool hasSameLayout(const SrcBuffer& src, const DstBuffer& dst)
+    {
+        return std::is_same<typename SrcBuffer::Indexer, typename DstBuffer::Indexer>::value
+            && std::is_same<typename SrcBuffer::Storage, typename DstBuffer::Storage>::value
+            && src.getStorage() == dst.getStorage()
+            && Detail::LayoutFlags<SrcBuffer>::get(src) == Detail::LayoutFlags<DstBuffer>::get(dst);
+    }
+
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
     template <typename L, uint O, typename T, typename I> using HBuffer = typename Buffer<L, O, T, I>::Ref;
 
-    template <uint O, typename T>         using HostBuffer            = Buffer<Location::HostTag, O, T, LinearIndexer<O>>;
-    template <uint O, typename T>         using HostMortonBuffer      = Buffer<Location::HostTag, O, T, MortonIndexer<O>>;
-    template <uint O, typename T, uint S> using HostTiledBuffer       = Buffer<Location::HostTag, O, T, TiledIndexer<O, S>>;
-    template <uint O, typename T>         using DeviceBuffer          = Buffer<Location::DeviceTag, O, T, LinearIndexer<O>>;
-    template <uint O, typename T>         using DeviceMortonBuffer    = Buffer<Location::DeviceTag, O, T, MortonIndexer<O>>;
-    template <uint O, typename T, uint S> using DeviceTiledBuffer     = Buffer<Location::DeviceTag, O, T, TiledIndexer<O, S>>;
-    template <uint O, typename T>         using HostBufferRef         = typename HostBuffer<O, T>::Ref;
-    template <uint O, typename T>         using HostMortonBufferRef   = typename HostMortonBuffer<O, T>::Ref;
-    template <uint O, typename T, uint S> using HostTiledBufferRef    = typename HostTiledBuffer<O, T, S>::Ref;
-    template <uint O, typename T>         using DeviceBufferRef       = typename DeviceBuffer<O, T>::Ref;
-    template <uint O, typename T>         using DeviceMortonBufferRef = typename DeviceMortonBuffer<O, T>::Ref;
-    template <uint O, typename T, uint S> using DeviceTiledBufferRef  = typename DeviceTiledBuffer<O, T, S>::Ref;
-
-    template <typename T>         using HostBuffer1          = HostBuffer<1, T>;
-    template <typename T>         using HostBuffer2          = HostBuffer<2, T>;
-    template <typename T>         using HostBuffer3          = HostBuffer<3, T>;
-    template <typename T>         using HostMortonBuffer1    = HostMortonBuffer<1, T>;
-    template <typename T>         using HostMortonBuffer2    = HostMortonBuffer<2, T>;
-    template <typename T>         using HostMortonBuffer3    = HostMortonBuffer<3, T>;
-    template <typename T, uint S> using HostTiledBuffer1     = HostTiledBuffer<1, T, S>;
-    template <typename T, uint S> using HostTiledBuffer2     = HostTiledBuffer<2, T, S>;
-    template <typename T, uint S> using HostTiledBuffer3     = HostTiledBuffer<3, T, S>;
-    template <typename T>         using HostBuffer1Ref       = typename HostBuffer1<T>::Ref; 
-    template <typename T>         using HostBuffer2Ref       = typename HostBuffer2<T>::Ref;
-    template <typename T>         using HostBuffer3Ref       = typename HostBuffer3<T>::Ref;
-    template <typename T>         using HostMortonBuffer1Ref = typename HostMortonBuffer1<T>::Ref;
-    template <typename T>         using HostMortonBuffer2Ref = typename HostMortonBuffer2<T>::Ref;
-    template <typename T>         using HostMortonBuffer3Ref = typename HostMortonBuffer3<T>::Ref;
-    template <typename T, uint S> using HostTiledBuffer1Ref  = typename HostTiledBuffer1<T, S>::Ref;
-    template <typename T, uint S> using HostTiledBuffer2Ref  = typename HostTiledBuffer2<T, S>::Ref;
-    template <typename T, uint S> using HostTiledBuffer3Ref  = typename HostTiledBuffer3<T, S>::Ref;
+    template <uint O, typename T, typename S = T>                      using HostBuffer            = Buffer<Location::HostTag, O, T, LinearIndexer<O>, S>;
+    template <uint O, typename T>                                      using HostMortonBuffer      = Buffer<Location::HostTag, O, T, MortonIndexer<O>>;
+    template <uint O, typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBuffer       = Buffer<Location::HostTag, O, T, TiledIndexer<O, SX, SY, SZ>>;
+    template <uint O, typename T, typename S = T>                      using DeviceBuffer          = Buffer<Location::DeviceTag, O, T, LinearIndexer<O>, S>;
+    template <uint O, typename T>                                      using DeviceMortonBuffer    = Buffer<Location::DeviceTag, O, T, MortonIndexer<O>>;
+    template <uint O, typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBuffer     = Buffer<Location::DeviceTag, O, T, TiledIndexer<O, SX, SY, SZ>>;
+    template <uint O, typename T, typename S = T>                      using HostBufferRef         = typename HostBuffer<O, T, S>::Ref;
+    template <uint O, typename T>                                      using HostMortonBufferRef   = typename HostMortonBuffer<O, T>::Ref;
+    template <uint O, typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBufferRef    = typename HostTiledBuffer<O, T, SX, SY, SZ>::Ref;
+    template <uint O, typename T, typename S = T>                      using DeviceBufferRef       = typename DeviceBuffer<O, T, S>::Ref;
+    template <uint O, typename T>                                      using DeviceMortonBufferRef = typename DeviceMortonBuffer<O, T>::Ref;
+    template <uint O, typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBufferRef  = typename DeviceTiledBuffer<O, T, SX, SY, SZ>::Ref;
+
+    template <typename T>                                      using HostBuffer1          = HostBuffer<1, T>;
+    template <typename T>                                      using HostBuffer2          = HostBuffer<2, T>;
+    template <typename T>                                      using HostBuffer3          = HostBuffer<3, T>;
+    template <typename T>                                      using HostMortonBuffer1    = HostMortonBuffer<1, T>;
+    template <typename T>                                      using HostMortonBuffer2    = HostMortonBuffer<2, T>;
+    template <typename T>                                      using HostMortonBuffer3    = HostMortonBuffer<3, T>;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBuffer1     = HostTiledBuffer<1, T, SX, SY, SZ>;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBuffer2     = HostTiledBuffer<2, T, SX, SY, SZ>;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBuffer3     = HostTiledBuffer<3, T, SX, SY, SZ>;
+    template <typename T>                                      using HostBuffer1Ref       = typename HostBuffer1<T>::Ref; 
+    template <typename T>                                      using HostBuffer2Ref       = typename HostBuffer2<T>::Ref;
+    template <typename T>                                      using HostBuffer3Ref       = typename HostBuffer3<T>::Ref;
+    template <typename T>                                      using HostMortonBuffer1Ref = typename HostMortonBuffer1<T>::Ref;
+    template <typename T>                                      using HostMortonBuffer2Ref = typename HostMortonBuffer2<T>::Ref;
+    template <typename T>                                      using HostMortonBuffer3Ref = typename HostMortonBuffer3<T>::Ref;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBuffer1Ref  = typename HostTiledBuffer1<T, SX, SY, SZ>::Ref;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBuffer2Ref  = typename HostTiledBuffer2<T, SX, SY, SZ>::Ref;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using HostTiledBuffer3Ref  = typename HostTiledBuffer3<T, SX, SY, SZ>::Ref;
                                                              
-    template <typename T>         using DeviceBuffer1          = DeviceBuffer<1, T>;
-    template <typename T>         using DeviceBuffer2          = DeviceBuffer<2, T>;
-    template <typename T>         using DeviceBuffer3          = DeviceBuffer<3, T>;
-    template <typename T>         using DeviceMortonBuffer1    = DeviceMortonBuffer<1, T>;
-    template <typename T>         using DeviceMortonBuffer2    = DeviceMortonBuffer<2, T>;
-    template <typename T>         using DeviceMortonBuffer3    = DeviceMortonBuffer<3, T>;
-    template <typename T, uint S> using DeviceTiledBuffer1     = DeviceTiledBuffer<1, T, S>;
-    template <typename T, uint S> using DeviceTiledBuffer2     = DeviceTiledBuffer<2, T, S>;
-    template <typename T, uint S> using DeviceTiledBuffer3     = DeviceTiledBuffer<3, T, S>;
-    template <typename T>         using DeviceBuffer1Ref       = typename DeviceBuffer1<T>::Ref; 
-    template <typename T>         using DeviceBuffer2Ref       = typename DeviceBuffer2<T>::Ref;
-    template <typename T>         using DeviceBuffer3Ref       = typename DeviceBuffer3<T>::Ref;
-    template <typename T>         using DeviceMortonBuffer1Ref = typename DeviceMortonBuffer1<T>::Ref;
-    template <typename T>         using DeviceMortonBuffer2Ref = typename DeviceMortonBuffer2<T>::Ref;
-    template <typename T>         using DeviceMortonBuffer3Ref = typename DeviceMortonBuffer3<T>::Ref;
-    template <typename T, uint S> using DeviceTiledBuffer1Ref  = typename DeviceTiledBuffer1<T, S>::Ref;
-    template <typename T, uint S> using DeviceTiledBuffer2Ref  = typename DeviceTiledBuffer2<T, S>::Ref;
-    template <typename T, uint S> using DeviceTiledBuffer3Ref  = typename DeviceTiledBuffer3<T, S>::Ref;
+    template <typename T>                                      using DeviceBuffer1          = DeviceBuffer<1, T>;
+    template <typename T>                                      using DeviceBuffer2          = DeviceBuffer<2, T>;
+    template <typename T>                                      using DeviceBuffer3          = DeviceBuffer<3, T>;
+    template <typename T>                                      using DeviceMortonBuffer1    = DeviceMortonBuffer<1, T>;
+    template <typename T>                                      using DeviceMortonBuffer2    = DeviceMortonBuffer<2, T>;
+    template <typename T>                                      using DeviceMortonBuffer3    = DeviceMortonBuffer<3, T>;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBuffer1     = DeviceTiledBuffer<1, T, SX, SY, SZ>;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBuffer2     = DeviceTiledBuffer<2, T, SX, SY, SZ>;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBuffer3     = DeviceTiledBuffer<3, T, SX, SY, SZ>;
+    template <typename T>                                      using DeviceBuffer1Ref       = typename DeviceBuffer1<T>::Ref; 
+    template <typename T>                                      using DeviceBuffer2Ref       = typename DeviceBuffer2<T>::Ref;
+    template <typename T>                                      using DeviceBuffer3Ref       = typename DeviceBuffer3<T>::Ref;
+    template <typename T>                                      using DeviceMortonBuffer1Ref = typename DeviceMortonBuffer1<T>::Ref;
+    template <typename T>                                      using DeviceMortonBuffer2Ref = typename DeviceMortonBuffer2<T>::Ref;
+    template <typename T>                                      using DeviceMortonBuffer3Ref = typename DeviceMortonBuffer3<T>::Ref;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBuffer1Ref  = typename DeviceTiledBuffer1<T, SX, SY, SZ>::Ref;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBuffer2Ref  = typename DeviceTiledBuffer2<T, SX, SY, SZ>::Ref;
+    template <typename T, uint SX, uint SY = SX, uint SZ = SY> using DeviceTiledBuffer3Ref  = typename DeviceTiledBuffer3<T, SX, SY, SZ>::Ref;
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
 }
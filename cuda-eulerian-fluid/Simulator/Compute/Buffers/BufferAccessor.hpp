@@ -15,17 +15,26 @@ HF_BEGIN_NAMESPACE(HF, Compute)
     public:
         static constexpr uint Order = _Buffer::Order;
         
-        using Buffer  = _Buffer;
-        using Value   = typename _Buffer::Value;
-        using Index   = typename _Buffer::Index;
-        using Indexer = typename _Buffer::Indexer;
+        using Buffer     = _Buffer;
+        using Value      = typename _Buffer::Value;
+        using Storage    = typename _Buffer::Storage;
+        using Conversion = typename _Buffer::Conversion;
+        using Index      = typename _Buffer::Index;
+        using Indexer    = typename _Buffer::Indexer;
+
+        /**
+         * \brief Whether rows along the X axis can be walked with plain pointer arithmetic. Values
+         *        not stored natively must go through getValue and setValue instead.
+         */
+        static constexpr bool IsRowContiguous = Indexer::IsRowContiguous && Conversion::IsNative;
 
     public:
         BufferAccessor() = default;
 
-        BufferAccessor(const Indexer& indexer, Value* ptr)
+        BufferAccessor(const Indexer& indexer, Storage* ptr, const Index& dims)
             : _indexer(indexer)
             , _ptr(ptr)
+            , _maxIdx(dims - 1)
         {
         }
 
@@ -36,13 +45,14 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
     public:
         /**
-         * \brief 
+         * \brief Reads the value at the given index. Indices outside of the buffer are clamped to
+         *        its edges, like the device surfaces do in clamp boundary mode.
          * \param idx 
          * \return 
          */
         HF_HDINLINE Value getValue(const Index& idx) const
         {
-            return _ptr[_indexer.computeOffset(idx)];
+            return Conversion::load(_ptr[_indexer.computeOffset(clamp(idx, Index(0), _maxIdx))]);
         }
 
         /**
@@ -52,14 +62,14 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         HF_HDINLINE void setValue(const Index& idx, const Value& value)
         {
-            _ptr[_indexer.computeOffset(idx)] = value;
+            _ptr[_indexer.computeOffset(idx)] = Conversion::store(value);
         }
 
         /**
          * \brief
          * \return
          */
-        HF_HDINLINE Value* getPtr()
+        HF_HDINLINE Storage* getPtr()
         {
             return _ptr;
         }
@@ -68,7 +78,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          * \brief
          * \return
          */
-        HF_HDINLINE Value const* getPtr() const
+        HF_HDINLINE Storage const* getPtr() const
         {
             return _ptr;
         }
@@ -77,14 +87,49 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          * \brief
          * \return
          */
-        HF_HDINLINE Value const* getPtr(const Index& idx) const
+        HF_HDINLINE Storage* getPtr(const Index& idx)
+        {
+            return &_ptr[_indexer.computeOffset(idx)];
+        }
+
+        /**
+         * \brief
+         * \return
+         */
+        HF_HDINLINE Storage const* getPtr(const Index& idx) const
         {
             return &_ptr[_indexer.computeOffset(idx)];
         }
 
+        /**
+         * \brief Returns the distance (in elements) between neighbouring indices along each axis.
+         *        Only available when the indexer is row contiguous.
+         */
+        HF_HDINLINE const Index& getStride() const
+        {
+            return _indexer.getStride();
+        }
+
+        /**
+         * \brief Returns the indexer mapping indices to offsets into the storage.
+         */
+        HF_HDINLINE const Indexer& getIndexer() const
+        {
+            return _indexer;
+        }
+
+        /**
+         * \brief Returns the largest valid index, i.e. the dimensions of the buffer minus one.
+         */
+        HF_HDINLINE const Index& getMaxIndex() const
+        {
+            return _maxIdx;
+        }
+
     private:
-        Indexer _indexer;
-        Value*  _ptr;
+        Indexer  _indexer;
+        Storage* _ptr;
+        Index    _maxIdx;
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
@@ -97,18 +142,26 @@ HF_BEGIN_NAMESPACE(HF, Compute)
     public:
         static constexpr uint Order = _Buffer::Order;
 
-        using Buffer  = _Buffer;
-        using Value   = typename _Buffer::Value;
-        using Index   = typename _Buffer::Index;
-        using Indexer = typename _Buffer::Indexer;
-        
+        using Buffer     = _Buffer;
+        using Value      = typename _Buffer::Value;
+        using Storage    = typename _Buffer::Storage;
+        using Conversion = typename _Buffer::Conversion;
+        using Index      = typename _Buffer::Index;
+        using Indexer    = typename _Buffer::Indexer;
+
+        /**
+         * \brief Whether rows along the X axis can be walked with plain pointer arithmetic. Values
+         *        not stored natively must go through getValue and setValue instead.
+         */
+        static constexpr bool IsRowContiguous = Indexer::IsRowContiguous && Conversion::IsNative;
 
     public:
         BufferConstAccessor() = default;
 
-        BufferConstAccessor(const Indexer& indexer, Value* ptr)
+        BufferConstAccessor(const Indexer& indexer, Storage* ptr, const Index& dims)
             : _indexer(indexer)
             , _ptr(ptr)
+            , _maxIdx(dims - 1)
         {
         }
 
@@ -118,20 +171,21 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
     public:
         /**
-         * \brief
+         * \brief Reads the value at the given index. Indices outside of the buffer are clamped to
+         *        its edges, like the device surfaces do in clamp boundary mode.
          * \param idx
          * \return
          */
         HF_HDINLINE Value getValue(const Index& idx) const
         {
-            return _ptr[_indexer.computeOffset(idx)];
+            return Conversion::load(_ptr[_indexer.computeOffset(clamp(idx, Index(0), _maxIdx))]);
         }
 
         /**
          * \brief
          * \return
          */
-        HF_HDINLINE Value* getPtr() const
+        HF_HDINLINE Storage* getPtr() const
         {
             return _ptr;
         }
@@ -140,14 +194,40 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          * \brief
          * \return
          */
-        HF_HDINLINE Value* getPtr(const Index& idx) const
+        HF_HDINLINE Storage* getPtr(const Index& idx) const
         {
             return &_ptr[_indexer.computeOffset(idx)];
         }
 
+        /**
+         * \brief Returns the distance (in elements) between neighbouring indices along each axis.
+         *        Only available when the indexer is row contiguous.
+         */
+        HF_HDINLINE const Index& getStride() const
+        {
+            return _indexer.getStride();
+        }
+
+        /**
+         * \brief Returns the indexer mapping indices to offsets into the storage.
+         */
+        HF_HDINLINE const Indexer& getIndexer() const
+        {
+            return _indexer;
+        }
+
+        /**
+         * \brief Returns the largest valid index, i.e. the dimensions of the buffer minus one.
+         */
+        HF_HDINLINE const Index& getMaxIndex() const
+        {
+            return _maxIdx;
+        }
+
     private:
-        Indexer _indexer;
-        Value*  _ptr;
+        Indexer  _indexer;
+        Storage* _ptr;
+        Index    _maxIdx;
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
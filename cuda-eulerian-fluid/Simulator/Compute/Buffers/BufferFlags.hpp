@@ -2,22 +2,113 @@
 #define HF_SIMULATOR_COMPUTE_BUFFER_FLAGS_HPP
 
 #include <Simulator/Simulator.hpp>
+#include <Simulator/Utility/Enumerations/BitmaskEnum.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Compute)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    enum struct BufferFlags
+    /**
+     * \brief Flags controlling the allocation of host buffers. The lower bits are the CUDA
+     *        host allocation flags, while the upper ones are host allocation policies honored
+     *        by the HostMemoryResource (and ignored by the CUDA runtime).
+     */
+    enum struct BufferFlags : uint
     {
-        Default       = cudaHostAllocDefault,
-        Portable      = cudaHostAllocPortable,
-        Mapped        = cudaHostAllocMapped,
-        WriteCombined = cudaHostAllocWriteCombined
+        Default           = HF_CUDA_CONSTANT(cudaHostAllocDefault, 0),
+        Portable          = HF_CUDA_CONSTANT(cudaHostAllocPortable, 1),
+        Mapped            = HF_CUDA_CONSTANT(cudaHostAllocMapped, 2),
+        WriteCombined     = HF_CUDA_CONSTANT(cudaHostAllocWriteCombined, 4),
+
+        /**
+         * \brief Pads every row of the buffer to a multiple of 64 bytes, so that each row starts
+         *        on a cache line. Only honored by linear indexers.
+         */
+        AlignRows         = 1u << 8,
+
+        /**
+         * \brief Asks the OS to back the buffer with transparent huge pages.
+         */
+        HugePages         = 1u << 9,
+
+        /**
+         * \brief Backs the buffer with explicit 2 MiB huge pages from the reserved pool, falling
+         *        back to transparent huge pages when none are available.
+         */
+        ExplicitHugePages = 1u << 10,
+
+        /**
+         * \brief Backs every page of the buffer on allocation, instead of on first access.
+         */
+        Prefault          = 1u << 11,
+
+        /**
+         * \brief Hints the OS that the buffer is accessed sequentially, so it reads ahead.
+         */
+        Sequential        = 1u << 12,
+
+        /**
+         * \brief Surrounds the buffer with a ghost layer (halo) of one, two or three elements
+         *        along every axis, addressed through indices outside of its dimensions. Only
+         *        honored by linear indexers (see getHaloWidth).
+         */
+        Halo1             = 1u << 13,
+        Halo2             = 2u << 13,
+        Halo3             = 3u << 13,
+        HaloMask          = 3u << 13,
+
+        /**
+         * \brief Mask of the flags understood by the CUDA runtime.
+         */
+        CudaMask          = 0xFFu
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
 }
 HF_END_NAMESPACE(HF, Compute)
 
+HF_BEGIN_NAMESPACE(HF)
+{
+    HF_BITMASK_ENUM(Compute::BufferFlags);
+}
+HF_END_NAMESPACE(HF)
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    // Make the bitmask operators reachable through argument-dependent lookup.
+
+    using HF::operator|;
+    using HF::operator&;
+    using HF::operator^;
+    using HF::operator~;
+    using HF::operator|=;
+    using HF::operator&=;
+    using HF::operator^=;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Returns whether every one of the given flags is set.
+     * \param flags Flags to test.
+     * \param mask Flags to look for.
+     */
+    HF_HINLINE bool hasFlags(BufferFlags flags, BufferFlags mask)
+    {
+        return (flags & mask) == mask;
+    }
+
+    /**
+     * \brief Returns the width of the halo requested by the given flags, in elements.
+     * \param flags Flags to test.
+     */
+    HF_HINLINE uint getHaloWidth(BufferFlags flags)
+    {
+        return static_cast<uint>(flags & BufferFlags::HaloMask) / static_cast<uint>(BufferFlags::Halo1);
+    }
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
 #endif /* HF_SIMULATOR_COMPUTE_BUFFER_FLAGS_HPP */
 
@@ -48,6 +48,9 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
         HF_HDINLINE Index applyAddressingMode(const Index& idx) const
         {
+            // Samples may land arbitrarily far from the buffer (e.g. backtraced advection), well
+            // beyond any halo, so every tap is clamped or wrapped regardless.
+
             return (_addressMode == BufferAddressMode::Wrap)
                  ? (((idx % _dims) + _dims) % _dims)
                  : clamp(idx, Index(0), _dims - 1);
@@ -91,20 +94,20 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         HF_HDINLINE Value getValue(const Coords& coords) const
         {
-            Coords gridCoords = applyCoordinatesMode(coords);
+            Coords gridCoords = this->applyCoordinatesMode(coords);
 
-            if (_filterMode == BufferFilterMode::PointFilter)
+            if (this->_filterMode == BufferFilterMode::PointFilter)
             {
-                const Index idx = applyAddressingMode(Index(round(gridCoords)));
-                return _accessor.getValue(idx);
+                const Index idx = this->applyAddressingMode(Index(round(gridCoords)));
+                return this->_accessor.getValue(idx);
             }
             else
             {
-                const Index minIdx = applyAddressingMode(Index(floor(gridCoords)));
-                const Index maxIdx = applyAddressingMode(Index(ceil(gridCoords)));
+                const Index minIdx = this->applyAddressingMode(Index(floor(gridCoords)));
+                const Index maxIdx = this->applyAddressingMode(Index(ceil(gridCoords)));
 
-                const Value value0 = _accessor.getValue(minIdx);
-                const Value value1 = _accessor.getValue(maxIdx);
+                const Value value0 = this->_accessor.getValue(minIdx);
+                const Value value1 = this->_accessor.getValue(maxIdx);
 
                 const Coords interp = glm::fract(gridCoords);
                 return mix(value0, value1, interp.x);
@@ -136,22 +139,22 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         HF_HDINLINE Value getValue(const Coords& coords) const
         {
-            Coords gridCoords = applyCoordinatesMode(coords);
+            Coords gridCoords = this->applyCoordinatesMode(coords);
 
-            if (_filterMode == BufferFilterMode::PointFilter)
+            if (this->_filterMode == BufferFilterMode::PointFilter)
             {
-                const Index idx = applyAddressingMode(Index(round(gridCoords)));
-                return _accessor.getValue(idx);
+                const Index idx = this->applyAddressingMode(Index(round(gridCoords)));
+                return this->_accessor.getValue(idx);
             }
             else
             {
-                const Index minIdx = applyAddressingMode(Index(floor(gridCoords)));
-                const Index maxIdx = applyAddressingMode(Index(ceil(gridCoords)));
+                const Index minIdx = this->applyAddressingMode(Index(floor(gridCoords)));
+                const Index maxIdx = this->applyAddressingMode(Index(ceil(gridCoords)));
 
-                const Value value00 = _accessor.getValue({ minIdx.x, minIdx.y });
-                const Value value10 = _accessor.getValue({ maxIdx.x, minIdx.y });
-                const Value value01 = _accessor.getValue({ minIdx.x, maxIdx.y });
-                const Value value11 = _accessor.getValue({ maxIdx.x, maxIdx.y });
+                const Value value00 = this->_accessor.getValue({ minIdx.x, minIdx.y });
+                const Value value10 = this->_accessor.getValue({ maxIdx.x, minIdx.y });
+                const Value value01 = this->_accessor.getValue({ minIdx.x, maxIdx.y });
+                const Value value11 = this->_accessor.getValue({ maxIdx.x, maxIdx.y });
 
                 const Coords interp = glm::fract(gridCoords);
                 const Value value0 = mix(value00, value10, interp.x);
@@ -187,26 +190,26 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         HF_HDINLINE Value getValue(const Coords& coords) const
         {
-            Coords gridCoords = applyCoordinatesMode(coords);
+            Coords gridCoords = this->applyCoordinatesMode(coords);
 
-            if (_filterMode == BufferFilterMode::PointFilter)
+            if (this->_filterMode == BufferFilterMode::PointFilter)
             {
-                const Index idx = applyAddressingMode(Index(round(gridCoords)));
-                return _accessor.getValue(idx);
+                const Index idx = this->applyAddressingMode(Index(round(gridCoords)));
+                return this->_accessor.getValue(idx);
             }
             else
             {
-                const Index minIdx = applyAddressingMode(Index(floor(gridCoords)));
-                const Index maxIdx = applyAddressingMode(Index(ceil(gridCoords)));
-
-                const Value& value000 = _accessor.getValue({ minIdx.x, minIdx.y, minIdx.z });
-                const Value& value100 = _accessor.getValue({ maxIdx.x, minIdx.y, minIdx.z });
-                const Value& value010 = _accessor.getValue({ minIdx.x, maxIdx.y, minIdx.z });
-                const Value& value110 = _accessor.getValue({ maxIdx.x, maxIdx.y, minIdx.z });
-                const Value& value001 = _accessor.getValue({ minIdx.x, minIdx.y, maxIdx.z });
-                const Value& value101 = _accessor.getValue({ maxIdx.x, minIdx.y, maxIdx.z });
-                const Value& value011 = _accessor.getValue({ minIdx.x, maxIdx.y, maxIdx.z });
-                const Value& value111 = _accessor.getValue({ maxIdx.x, maxIdx.y, maxIdx.z });
+                const Index minIdx = this->applyAddressingMode(Index(floor(gridCoords)));
+                const Index maxIdx = this->applyAddressingMode(Index(ceil(gridCoords)));
+
+                const Value& value000 = this->_accessor.getValue({ minIdx.x, minIdx.y, minIdx.z });
+                const Value& value100 = this->_accessor.getValue({ maxIdx.x, minIdx.y, minIdx.z });
+                const Value& value010 = this->_accessor.getValue({ minIdx.x, maxIdx.y, minIdx.z });
+                const Value& value110 = this->_accessor.getValue({ maxIdx.x, maxIdx.y, minIdx.z });
+                const Value& value001 = this->_accessor.getValue({ minIdx.x, minIdx.y, maxIdx.z });
+                const Value& value101 = this->_accessor.getValue({ maxIdx.x, minIdx.y, maxIdx.z });
+                const Value& value011 = this->_accessor.getValue({ minIdx.x, maxIdx.y, maxIdx.z });
+                const Value& value111 = this->_accessor.getValue({ maxIdx.x, maxIdx.y, maxIdx.z });
 
                 const Coords interp = fract(gridCoords);
                 const Value value00 = mix(value000, value100, interp.x);
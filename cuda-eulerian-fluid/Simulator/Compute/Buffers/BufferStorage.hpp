@@ -0,0 +1,325 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_BUFFER_STORAGE_HPP
+#define HF_SIMULATOR_COMPUTE_BUFFER_STORAGE_HPP
+
+#include <Simulator/Simulator.hpp>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    namespace Detail
+    {
+        HF_HDINLINE uint floatAsUint(float value)
+        {
+            #if defined(__CUDA_ARCH__)
+            return __float_as_uint(value);
+            #else
+            uint bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+            #endif
+        }
+
+        HF_HDINLINE float uintAsFloat(uint bits)
+        {
+            #if defined(__CUDA_ARCH__)
+            return __uint_as_float(bits);
+            #else
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+            #endif
+        }
+    }
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief IEEE 754 half-precision (binary16) storage scalar. Converted with F16C on hosts
+     *        supporting it, and rounded to nearest even otherwise.
+     */
+    struct Half
+    {
+    public:
+        ushort bits;
+
+    public:
+        Half() = default;
+
+        explicit HF_HDINLINE Half(float value)
+            : bits(fromFloat(value))
+        {
+        }
+
+        explicit HF_HDINLINE operator float() const
+        {
+            return toFloat(bits);
+        }
+
+    private:
+        static HF_HDINLINE ushort fromFloat(float value)
+        {
+            #if defined(__F16C__) && !defined(__CUDA_ARCH__)
+            return ushort(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+            #else
+            uint x = Detail::floatAsUint(value);
+            const uint sign = (x >> 16) & 0x8000u;
+            x &= 0x7FFFFFFFu;
+
+            // NaNs and infinities, and values rounding past the largest half (65504).
+
+            if (x >= 0x7F800000u)
+                return ushort(sign | (x > 0x7F800000u ? 0x7E00u : 0x7C00u));
+
+            if (x >= 0x477FF000u)
+                return ushort(sign | 0x7C00u);
+
+            // Values below the smallest normal half (2^-14) become subnormals, or zero.
+
+            if (x < 0x38800000u)
+            {
+                if (x < 0x33000000u)
+                    return ushort(sign);
+
+                const uint shift = 126u - (x >> 23);
+                const uint mantissa = (x & 0x7FFFFFu) | 0x800000u;
+                const uint halfway = 1u << (shift - 1);
+                const uint remainder = mantissa & ((1u << shift) - 1);
+
+                uint h = mantissa >> shift;
+                h += remainder > halfway || (remainder == halfway && (h & 1u));
+
+                return ushort(sign | h);
+            }
+
+            // Rebias the exponent and round the mantissa, carrying into the exponent if needed.
+
+            x -= 0x38000000u;
+
+            uint h = x >> 13;
+            const uint remainder = x & 0x1FFFu;
+            h += remainder > 0x1000u || (remainder == 0x1000u && (h & 1u));
+
+            return ushort(sign | h);
+            #endif
+        }
+
+        static HF_HDINLINE float toFloat(ushort h)
+        {
+            #if defined(__F16C__) && !defined(__CUDA_ARCH__)
+            return _cvtsh_ss(h);
+            #else
+            const uint sign = uint(h & 0x8000u) << 16;
+            const uint exponent = (h >> 10) & 0x1Fu;
+            const uint mantissa = h & 0x3FFu;
+
+            if (exponent == 0x1Fu)
+                return Detail::uintAsFloat(sign | 0x7F800000u | (mantissa << 13));
+
+            if (exponent == 0)
+            {
+                const float value = float(mantissa) * 5.9604644775390625e-8f;
+                return sign ? -value : value;
+            }
+
+            return Detail::uintAsFloat(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+            #endif
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Brain floating point (bfloat16) storage scalar, i.e. the upper half of a float,
+     *        rounded to nearest even. Keeps the range of floats at the cost of precision.
+     */
+    struct BFloat16
+    {
+    public:
+        ushort bits;
+
+    public:
+        BFloat16() = default;
+
+        explicit HF_HDINLINE BFloat16(float value)
+            : bits(fromFloat(value))
+        {
+        }
+
+        explicit HF_HDINLINE operator float() const
+        {
+            return Detail::uintAsFloat(uint(bits) << 16);
+        }
+
+    private:
+        static HF_HDINLINE ushort fromFloat(float value)
+        {
+            const uint x = Detail::floatAsUint(value);
+
+            // Keep NaNs quiet, as rounding could turn them into infinities.
+
+            if ((x & 0x7FFFFFFFu) > 0x7F800000u)
+                return ushort((x >> 16) | 0x40u);
+
+            return ushort((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Unsigned normalized 8-bit storage scalar, mapping [0, 1] to [0, 255]. Values
+     *        outside of that range are saturated.
+     */
+    struct Unorm8
+    {
+    public:
+        uchar bits;
+
+    public:
+        Unorm8() = default;
+
+        explicit HF_HDINLINE Unorm8(float value)
+            : bits(uchar(saturate(value) * 255.0f + 0.5f))
+        {
+        }
+
+        explicit HF_HDINLINE operator float() const
+        {
+            return float(bits) * (1.0f / 255.0f);
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Vector of storage scalars, converted component-wise to and from float vectors.
+     * \tparam _Scalar Type of the storage scalars.
+     * \tparam _Length No. of components.
+     */
+    template <typename _Scalar, uint _Length>
+    struct StorageVector
+    {
+    public:
+        using Scalar                 = _Scalar;
+        static constexpr uint Length = _Length;
+
+    public:
+        Scalar components[_Length];
+
+    public:
+        HF_HDINLINE Scalar& operator[](uint i)
+        {
+            return components[i];
+        }
+
+        HF_HDINLINE const Scalar& operator[](uint i) const
+        {
+            return components[i];
+        }
+    };
+
+    template <uint Length> using HalfN     = StorageVector<Half, Length>;
+    template <uint Length> using BFloat16N = StorageVector<BFloat16, Length>;
+    template <uint Length> using Unorm8N   = StorageVector<Unorm8, Length>;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Marks vector values as stored planar, i.e. one plane per component holding the
+     *        given scalar storage type, instead of one element per value (see PlanarBuffer).
+     * \tparam _Scalar Type the components are stored as.
+     */
+    template <typename _Scalar>
+    struct PlanarStorage
+    {
+        using Scalar = _Scalar;
+    };
+
+    /**
+     * \brief Determines whether the given storage type is planar, and the type its components
+     *        are stored as.
+     */
+    template <typename Storage>
+    struct PlanarStorageTraits
+    {
+        static constexpr bool IsPlanar = false;
+        using Scalar = Storage;
+    };
+
+    template <typename _Scalar>
+    struct PlanarStorageTraits<PlanarStorage<_Scalar>>
+    {
+        static constexpr bool IsPlanar = true;
+        using Scalar = _Scalar;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Describes how values are kept in the storage of buffers. Buffers storing values
+     *        as they are computed with (i.e. natively) can be accessed through raw pointers,
+     *        whereas any other storage type is converted on load and store, so kernels keep
+     *        computing with the value type while memory traffic and footprint drop.
+     * \tparam Value Type of the values, as computed with.
+     * \tparam Storage Type of the values, as stored.
+     */
+    template <typename Value, typename Storage>
+    struct BufferStorage
+    {
+        /**
+         * \brief Whether values are stored as they are.
+         */
+        static constexpr bool IsNative = std::is_same<Value, Storage>::value;
+
+        static HF_HDINLINE Value load(const Storage& storage)
+        {
+            return Value(storage);
+        }
+
+        static HF_HDINLINE Storage store(const Value& value)
+        {
+            return Storage(value);
+        }
+    };
+
+    template <typename _Value, typename Scalar, uint Length>
+    struct BufferStorage<_Value, StorageVector<Scalar, Length>>
+    {
+        using Value   = _Value;
+        using Storage = StorageVector<Scalar, Length>;
+
+        static_assert(DimsOf<Value>::Value == Length, "The value and storage types must have as many components.");
+
+        static constexpr bool IsNative = false;
+
+        static HF_HDINLINE Value load(const Storage& storage)
+        {
+            Value value;
+
+            for (uint i = 0; i < Length; ++i)
+                value[i] = float(storage[i]);
+
+            return value;
+        }
+
+        static HF_HDINLINE Storage store(const Value& value)
+        {
+            Storage storage;
+
+            for (uint i = 0; i < Length; ++i)
+                storage[i] = Scalar(value[i]);
+
+            return storage;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_BUFFER_STORAGE_HPP */
@@ -15,6 +15,11 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         using Index                 = IntN<_Order>;
         static constexpr uint Order = _Order;
 
+        /**
+         * \brief Whether consecutive indices along the X axis are stored contiguously in memory.
+         */
+        static constexpr bool IsRowContiguous = true;
+
     public:
         LinearIndexer() = default;
 
@@ -26,8 +31,44 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         HF_HINLINE uint setup(const Dims& size)
         {
-            _stride = exclusiveCumProd(size);
-            return compMul(size);
+            return setup(size, 1, 0);
+        }
+
+        /**
+         * \brief Sets the indexer up for the given size, padding rows so that each of them
+         *        starts at a multiple of the given no. of elements.
+         * \param size Size of the indexed data.
+         * \param rowAlignment Alignment of the rows, in elements.
+         * \return No. of elements of storage required.
+         */
+        HF_HINLINE uint setup(const Dims& size, uint rowAlignment)
+        {
+            return setup(size, rowAlignment, 0);
+        }
+
+        /**
+         * \brief Sets the indexer up for the given size surrounded by a ghost layer (halo) of the
+         *        given width, so that indices from -halo to size + halo - 1 along every axis are
+         *        valid. The layer before each row is widened to a multiple of the row alignment,
+         *        so that the first element of every row keeps being aligned.
+         * \param size Size of the indexed data, without the halo.
+         * \param rowAlignment Alignment of the rows, in elements.
+         * \param halo Width of the halo, in elements.
+         * \return No. of elements of storage required.
+         */
+        HF_HINLINE uint setup(const Dims& size, uint rowAlignment, int halo)
+        {
+            Dims leading(halo);
+            leading[0] = int((uint(halo) + rowAlignment - 1) / rowAlignment * rowAlignment);
+
+            Dims paddedSize = size + leading + halo;
+            paddedSize[0] = int((uint(paddedSize[0]) + rowAlignment - 1) / rowAlignment * rowAlignment);
+
+            _stride = exclusiveCumProd(paddedSize);
+            _origin = compAdd(leading * _stride);
+            _halo = halo;
+
+            return compMul(paddedSize);
         }
 
         /**
@@ -37,11 +78,40 @@ HF_BEGIN_NAMESPACE(HF, Compute)
          */
         HF_HDINLINE int computeOffset(const Index &idx) const
         {
-            return compAdd(idx * _stride);
+            return _origin + compAdd(idx * _stride);
+        }
+
+        /**
+         * \brief Returns the offset of the neighbour of an element along the given axis.
+         * \param offset Offset of the element.
+         * \param axis Axis to move along.
+         * \param direction Direction to move along the axis, either 1 or -1.
+         */
+        HF_HDINLINE int computeNeighborOffset(int offset, uint axis, int direction) const
+        {
+            return offset + direction * _stride[axis];
+        }
+
+        /**
+         * \brief Returns the distance (in elements) between neighbouring indices along each axis.
+         */
+        HF_HDINLINE const Index& getStride() const
+        {
+            return _stride;
+        }
+
+        /**
+         * \brief Returns the width of the halo surrounding the indexed data, in elements.
+         */
+        HF_HDINLINE int getHalo() const
+        {
+            return _halo;
         }
 
     private:
         Index _stride;
+        int   _origin;
+        int   _halo;
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
@@ -4,10 +4,26 @@
 #include <Simulator/Simulator.hpp>
 #include <Simulator/Utility/Bitwise/Morton.hpp>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 HF_BEGIN_NAMESPACE(HF, Compute)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
+    /**
+     * \brief Indexer storing elements along a Z-order curve. Each axis is padded up to the next
+     *        power of two, and bits of the axes are interleaved from the lowest one upwards for
+     *        as long as each axis has bits left, so elongated grids are not padded to a cube.
+     *        Codes are computed on 64 bits, so no axis is limited to a fixed no. of bits (e.g.
+     *        10 in 3D), but storage sizes and offsets are 32-bit like those of other indexers:
+     *        the padded axes may take at most 31 bits together, e.g. 1024 x 1024 x 2048.
+     *
+     *        The bits taken by each axis are described by a mask. Codes are encoded with PDEP
+     *        on hosts with BMI2, and otherwise by spreading the bits of each run of levels with
+     *        a fixed set of axes (see MortonLut). Neighbours are reached by a masked add.
+     */
     template <uint _Order>
     struct MortonIndexer
     {
@@ -16,34 +32,185 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         using Index                 = IntN<_Order>;
         static constexpr uint Order = _Order;
 
+        /**
+         * \brief Whether consecutive indices along the X axis are stored contiguously in memory.
+         */
+        static constexpr bool IsRowContiguous = false;
+
     public:
         MortonIndexer() = default;
 
     public:
         /**
-         * \brief 
-         * \param dims 
-         * \return 
+         * \brief Sets the indexer up for the given size.
+         * \param dims Size of the indexed data.
+         * \return No. of elements of storage required, i.e. the product of the size of each
+         *         axis rounded up to a power of two.
          */
         HF_HINLINE uint setup(const Dims& dims)
         {
-            return compMul(dims);
+            uint bits[Order];
+            uint maxBits = 0;
+
+            for (uint i = 0; i < Order; ++i)
+            {
+                bits[i] = 0;
+
+                while ((1ull << bits[i]) < ulonglong(dims[i]))
+                    ++bits[i];
+
+                maxBits = std::max(maxBits, bits[i]);
+                _masks[i] = 0;
+            }
+
+            // Hand out bits level by level, to the axes having bits left on each. Levels with
+            // the same set of axes form a run, spread as a whole when encoding without PDEP.
+
+            uint position = 0;
+            _runCount = 0;
+
+            for (uint level = 0; level < maxBits; ++level)
+            {
+                uint width = 0;
+
+                for (uint i = 0; i < Order; ++i)
+                    width += bits[i] > level;
+
+                if (_runCount == 0 || _runs[_runCount - 1].width != width)
+                {
+                    Run& run = _runs[_runCount++];
+
+                    run.level = level;
+                    run.width = width;
+                    run.mask = 0;
+
+                    for (uint i = 0, rank = 0; i < Order; ++i)
+                        run.shift[i] = bits[i] > level ? position + rank++ : 0;
+                }
+
+                for (uint i = 0; i < Order; ++i)
+                {
+                    if (bits[i] > level)
+                        _masks[i] |= 1ull << position++;
+                }
+
+                _runs[_runCount - 1].mask = (1ull << (level + 1 - _runs[_runCount - 1].level)) - 1;
+            }
+
+            HF_ASSERT(position < 32, "Unable to index that many elements along a Z-order curve.");
+
+            return uint(1ull << position);
         }
 
         /**
-         * \brief 
-         * \param idx 
-         * \return 
+         * \brief Returns the offset of the element at the given index.
+         * \param idx Index of the element.
          */
         HF_HDINLINE int computeOffset(const Index &idx) const
         {
-            int offset = 0;
+            ulonglong offset = 0;
 
+            #if defined(__BMI2__) && !defined(__CUDA_ARCH__)
             for (uint i = 0; i < Order; ++i)
-                offset |= Morton<int, Order>::Encode(idx[i]) << i;
+                offset |= _pdep_u64(ulonglong(uint(idx[i])), _masks[i]);
+            #else
+            for (uint r = 0; r < _runCount; ++r)
+            {
+                const Run& run = _runs[r];
 
-            return offset;
+                for (uint i = 0; i < Order; ++i)
+                    offset |= spread((ulonglong(uint(idx[i])) >> run.level) & run.mask, run.width) << run.shift[i];
+            }
+            #endif
+
+            return int(offset);
         }
+
+        /**
+         * \brief Returns the index of the element stored at the given offset.
+         * \param offset Offset of the element.
+         */
+        HF_HDINLINE Index computeIndex(int offset) const
+        {
+            Index idx(0);
+
+            for (uint i = 0; i < Order; ++i)
+            {
+                #if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+                idx[i] = int(_pext_u64(ulonglong(uint(offset)), _masks[i]));
+                #else
+                ulonglong value = 0;
+                ulonglong bit = 1;
+
+                for (ulonglong mask = _masks[i]; mask != 0; mask &= mask - 1, bit <<= 1)
+                {
+                    if (ulonglong(uint(offset)) & mask & (~mask + 1))
+                        value |= bit;
+                }
+
+                idx[i] = int(value);
+                #endif
+            }
+
+            return idx;
+        }
+
+        /**
+         * \brief Returns the offset of the neighbour of an element along the given axis, without
+         *        decoding the offset of the element. The neighbour must lie within the padded
+         *        size of the axis.
+         * \param offset Offset of the element.
+         * \param axis Axis to move along.
+         * \param direction Direction to move along the axis, either 1 or -1.
+         */
+        HF_HDINLINE int computeNeighborOffset(int offset, uint axis, int direction) const
+        {
+            const ulonglong code = ulonglong(uint(offset));
+            const ulonglong mask = _masks[axis];
+
+            // Filling the bits of the other axes with ones carries additions across them, and
+            // clearing them does the same for borrows.
+
+            const ulonglong moved = direction > 0 ? ((code | ~mask) + (mask & (~mask + 1))) & mask
+                                                  : ((code & mask) - (mask & (~mask + 1))) & mask;
+
+            return int(moved | (code & ~mask));
+        }
+
+        /**
+         * \brief Returns the bits of the offsets taken by each axis.
+         */
+        HF_HDINLINE const ulonglong* getMasks() const
+        {
+            return _masks;
+        }
+
+    private:
+        static HF_HDINLINE ulonglong spread(ulonglong x, uint width)
+        {
+            #if defined(__CUDA_ARCH__)
+            return width == 3 ? Morton<ulonglong, 3, 64>::Encode(x)
+                 : width == 2 ? Morton<ulonglong, 2, 64>::Encode(x)
+                              : x;
+            #else
+            return width == 3 ? MortonLut<3>::Encode(x)
+                 : width == 2 ? MortonLut<2>::Encode(x)
+                              : x;
+            #endif
+        }
+
+    private:
+        struct Run
+        {
+            ulonglong mask;
+            uint      level;
+            uint      width;
+            uint      shift[_Order];
+        };
+
+        ulonglong _masks[_Order];
+        Run       _runs[_Order];
+        uint      _runCount;
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
@@ -0,0 +1,239 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_NUMPY_FORMAT_HPP
+#define HF_SIMULATOR_COMPUTE_NUMPY_FORMAT_HPP
+
+#include <Simulator/Simulator.hpp>
+
+// The NumPy header parser is third-party code, kept as is.
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <Simulator/ThirdParty/npy.hpp>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Header of a NumPy (.npy) file.
+     */
+    struct NumpyHeader
+    {
+        std::string         descr;
+        bool                fortranOrder;
+        std::vector<ulong>  shape;
+        std::size_t         payloadOffset;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Describes how values of the given type are stored in NumPy files: scalars as such,
+     *        and vectors as an additional, innermost, axis of scalars.
+     * \tparam Value Type of the values.
+     */
+    template <typename Value, typename = void>
+    struct NumpyElement
+    {
+        using Scalar = Value;
+        static constexpr uint Components = 1;
+
+        static HF_HINLINE Scalar& getComponent(Value& value, uint /* component */)
+        {
+            return value;
+        }
+    };
+
+    template <typename Value>
+    struct NumpyElement<Value, typename std::enable_if<!std::is_arithmetic<Value>::value>::type>
+    {
+        using Scalar = typename std::remove_reference<decltype(std::declval<Value&>()[0])>::type;
+        static constexpr uint Components = DimsOf<Value>::Value;
+
+        static HF_HINLINE Scalar& getComponent(Value& value, uint component)
+        {
+            return value[component];
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Helpers for reading NumPy (.npy) files straight from memory, typically a mapping of
+     *        the file, so the payload can be used in place.
+     */
+    class NumpyFormat
+    {
+    public:
+        template <typename Dst>
+        using ScalarReader = Dst (*)(const char*);
+
+        /**
+         * \brief Alignment of the payload of the files written, in bytes, as NumPy does.
+         */
+        static constexpr std::size_t PayloadAlignment = 64;
+
+    public:
+        NumpyFormat() = delete;
+
+    public:
+        /**
+         * \brief Returns the type descriptor of the given scalar type (e.g. '<f4' for float).
+         * \tparam Scalar Scalar type.
+         */
+        template <typename Scalar>
+        static std::string getDescr()
+        {
+            const char kind = std::is_same<Scalar, bool>::value          ? 'b'
+                            : std::is_floating_point<Scalar>::value      ? 'f'
+                            : std::is_signed<Scalar>::value              ? 'i'
+                                                                         : 'u';
+
+            const char endian = sizeof(Scalar) == 1 ? npy::no_endian_char : npy::host_endian_char;
+
+            return format("%c%c%zu", endian, kind, sizeof(Scalar));
+        }
+
+        /**
+         * \brief Returns the size of the scalars with the given type descriptor, in bytes. Zero
+         *        if the descriptor is not supported.
+         * \param descr Type descriptor.
+         */
+        static std::size_t getScalarSize(const std::string& descr)
+        {
+            return getScalarReader<double>(descr) != nullptr ? std::size_t(descr[2] - '0') : 0;
+        }
+
+        /**
+         * \brief Returns a function reading a scalar with the given type descriptor and
+         *        converting it to the given type. Null if the descriptor is not supported.
+         * \tparam Dst Type to convert the scalars to.
+         * \param descr Type descriptor.
+         */
+        template <typename Dst>
+        static ScalarReader<Dst> getScalarReader(const std::string& descr)
+        {
+            // Only scalar types in native byte order are supported.
+
+            if (descr.size() != 3 || (descr[0] != npy::host_endian_char && descr[0] != npy::no_endian_char))
+                return nullptr;
+
+            switch ((descr[1] << 8) | descr[2])
+            {
+            case ('b' << 8) | '1': return &readScalar<bool, Dst>;
+            case ('f' << 8) | '4': return &readScalar<float, Dst>;
+            case ('f' << 8) | '8': return &readScalar<double, Dst>;
+            case ('i' << 8) | '1': return &readScalar<std::int8_t, Dst>;
+            case ('i' << 8) | '2': return &readScalar<std::int16_t, Dst>;
+            case ('i' << 8) | '4': return &readScalar<std::int32_t, Dst>;
+            case ('i' << 8) | '8': return &readScalar<std::int64_t, Dst>;
+            case ('u' << 8) | '1': return &readScalar<std::uint8_t, Dst>;
+            case ('u' << 8) | '2': return &readScalar<std::uint16_t, Dst>;
+            case ('u' << 8) | '4': return &readScalar<std::uint32_t, Dst>;
+            case ('u' << 8) | '8': return &readScalar<std::uint64_t, Dst>;
+            default:               return nullptr;
+            }
+        }
+
+        /**
+         * \brief Parses the header of a NumPy file.
+         * \param data Contents of the file.
+         * \param size Size of the contents, in bytes.
+         * \param header Parsed header.
+         * \return Whether the contents start with a valid header.
+         */
+        static bool readHeader(const char* data, std::size_t size, NumpyHeader& header)
+        {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+            const std::size_t prefixSize = npy::magic_string_length + 2;
+
+            if (size < prefixSize + 2 || std::memcmp(data, npy::magic_string, npy::magic_string_length) != 0)
+                return false;
+
+            // Version 1 headers store their length in 16 bits, later ones in 32 bits.
+
+            const uint majorVersion = bytes[npy::magic_string_length];
+            const std::size_t lengthSize = majorVersion == 1 ? 2 : 4;
+
+            if (majorVersion == 0 || majorVersion > 3 || size < prefixSize + lengthSize)
+                return false;
+
+            std::size_t headerLength = 0;
+
+            for (std::size_t i = 0; i < lengthSize; ++i)
+                headerLength |= std::size_t(bytes[prefixSize + i]) << (8 * i);
+
+            header.payloadOffset = prefixSize + lengthSize + headerLength;
+
+            if (headerLength == 0 || header.payloadOffset > size)
+                return false;
+
+            try
+            {
+                std::vector<npy::ndarray_len_t> shape;
+                npy::parse_header(std::string(data + prefixSize + lengthSize, headerLength), header.descr, header.fortranOrder, shape);
+
+                header.shape.assign(shape.begin(), shape.end());
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * \brief Writes the header of a NumPy file, padded so that the payload following it is
+         *        aligned to PayloadAlignment bytes.
+         * \param stream Stream to write to.
+         * \param header Header to write. The payload offset is ignored.
+         */
+        static void writeHeader(std::ostream& stream, const NumpyHeader& header)
+        {
+            std::vector<npy::ndarray_len_t> shape(header.shape.begin(), header.shape.end());
+            std::string dict = npy::write_header_dict(header.descr, header.fortranOrder, shape);
+
+            // Version 1 headers store their length in 16 bits, version 2 ones in 32 bits. The
+            // dictionary is terminated by a newline, and padded with spaces before it.
+
+            const std::size_t prefixSize = npy::magic_string_length + 2;
+            const std::size_t lengthSize = prefixSize + 2 + dict.size() + 1 + PayloadAlignment <= 0xFFFF ? 2 : 4;
+            const std::size_t unpaddedSize = prefixSize + lengthSize + dict.size() + 1;
+            const std::size_t paddedSize = (unpaddedSize + PayloadAlignment - 1) / PayloadAlignment * PayloadAlignment;
+
+            dict.append(paddedSize - unpaddedSize, ' ');
+            dict.push_back('\n');
+
+            char prefix[prefixSize + 4];
+            std::memcpy(prefix, npy::magic_string, npy::magic_string_length);
+            prefix[npy::magic_string_length] = char(lengthSize == 2 ? 1 : 2);
+            prefix[npy::magic_string_length + 1] = 0;
+
+            for (std::size_t i = 0; i < lengthSize; ++i)
+                prefix[prefixSize + i] = char((dict.size() >> (8 * i)) & 0xFF);
+
+            stream.write(prefix, std::streamsize(prefixSize + lengthSize));
+            stream.write(dict.data(), std::streamsize(dict.size()));
+        }
+
+    private:
+        template <typename Src, typename Dst>
+        static Dst readScalar(const char* ptr)
+        {
+            Src value;
+            std::memcpy(&value, ptr, sizeof(Src));
+
+            return static_cast<Dst>(value);
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_NUMPY_FORMAT_HPP */
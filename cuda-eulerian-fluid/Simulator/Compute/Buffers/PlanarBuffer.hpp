@@ -0,0 +1,231 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_PLANAR_BUFFER_HPP
+#define HF_SIMULATOR_COMPUTE_PLANAR_BUFFER_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Location.hpp>
+#include <Simulator/Compute/Buffers/Buffer.hpp>
+#include <Simulator/Compute/Buffers/BufferAddressMode.hpp>
+#include <Simulator/Compute/Buffers/BufferCoordMode.hpp>
+#include <Simulator/Compute/Buffers/BufferFilterMode.hpp>
+#include <Simulator/Compute/Buffers/BufferFlags.hpp>
+#include <Simulator/Compute/Buffers/BufferSampler.hpp>
+#include <Simulator/Compute/Buffers/BufferStorage.hpp>
+#include <Simulator/Compute/Buffers/LinearIndexer.hpp>
+#include <Simulator/Compute/Buffers/PlanarBufferAccessor.hpp>
+#include <Simulator/Compute/Memory/HostMemoryResource.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Host buffer of vector values kept as one plane per component (i.e. structure of
+     *        arrays), each laid out as a linear buffer of scalars. Rows of a plane hold a single
+     *        component of consecutive cells, so kernels can walk them a component at a time,
+     *        and readers of some of the components leave the other planes alone. Accessed and
+     *        sampled like Buffer.
+     * \tparam _Order Order (dimensions) of the buffer.
+     * \tparam _Value Type of the values, a vector type.
+     * \tparam _Storage Type the components are stored as (see BufferStorage).
+     */
+    template <uint _Order, typename _Value, typename _Storage = typename Traits<_Value>::ScalarType>
+    class PlanarBuffer
+    {
+    public:
+        static constexpr uint Order      = _Order;
+        static constexpr uint Components = Traits<_Value>::Dims;
+
+        using LocationTag = Location::HostTag;
+        static constexpr LocationTag Location = {};
+
+        using Ref                = HF::Ref<PlanarBuffer>;
+        using Value              = _Value;
+        using Scalar             = typename Traits<_Value>::ScalarType;
+        using Storage            = _Storage;
+        using Conversion         = BufferStorage<Scalar, _Storage>;
+        using Dims               = IntN<_Order>;
+        using Index              = IntN<_Order>;
+        using Coords             = FloatN<_Order>;
+        using Indexer            = LinearIndexer<_Order>;
+        using Accessor           = PlanarBufferAccessor<PlanarBuffer>;
+        using ConstAccessor      = PlanarBufferConstAccessor<PlanarBuffer>;
+        using Sampler            = BufferSampler<PlanarBuffer>;
+        using Plane              = Buffer<Location::HostTag, _Order, Scalar, Indexer, _Storage>;
+        using PlaneAccessor      = typename Plane::Accessor;
+        using PlaneConstAccessor = typename Plane::ConstAccessor;
+
+        /**
+         * \brief Alignment of the host allocation and of each of the planes, in bytes.
+         */
+        static constexpr std::size_t Alignment = Plane::Alignment;
+
+    protected:
+        PlanarBuffer(const Dims& dims, BufferFlags flags, const MemoryResource::Ref& resource, bool zeroed)
+            : _dims(dims)
+            , _flags(flags)
+            , _resource(resource)
+        {
+            // Lay every plane out as a linear buffer would be, and start each of them on an
+            // aligned address.
+
+            _planeStride = int(setupIndexer(_indexer, dims, flags));
+            _storage = uint(_planeStride) * Components;
+
+            _ptr = static_cast<Storage*>(_resource->allocate(sizeof(Storage) * _storage, Alignment, zeroed));
+        }
+
+    public:
+        PlanarBuffer() = delete;
+
+        ~PlanarBuffer()
+        {
+            _resource->deallocate(_ptr, sizeof(Storage) * _storage, Alignment);
+            _ptr = nullptr;
+        }
+
+        HF_COPY_IMPLEMENTATION(PlanarBuffer, delete)
+
+        HF_MOVE_IMPLEMENTATION(PlanarBuffer, delete)
+
+    public:
+        const Dims& getDims() const
+        {
+            return _dims;
+        }
+
+        BufferFlags getFlags() const
+        {
+            return _flags;
+        }
+
+        /**
+         * \brief Returns the no. of storage elements of the buffer, across all of its planes.
+         */
+        uint getStorage() const
+        {
+            return _storage;
+        }
+
+        const Storage* getPtr() const
+        {
+            return _ptr;
+        }
+
+        Storage* getPtr()
+        {
+            return _ptr;
+        }
+
+        ConstAccessor getConstAccessor() const
+        {
+            return ConstAccessor(_indexer, _ptr, _planeStride, _dims);
+        }
+
+        Accessor getAccessor()
+        {
+            return Accessor(_indexer, _ptr, _planeStride, _dims);
+        }
+
+        /**
+         * \brief Returns an accessor reading the plane of the given component alone.
+         */
+        PlaneConstAccessor getPlaneConstAccessor(uint component) const
+        {
+            return getConstAccessor().getPlane(component);
+        }
+
+        /**
+         * \brief Returns an accessor reading and writing the plane of the given component alone.
+         */
+        PlaneAccessor getPlaneAccessor(uint component)
+        {
+            return getAccessor().getPlane(component);
+        }
+
+        Sampler getSampler(BufferAddressMode addressMode, BufferFilterMode filterMode, BufferCoordMode coordMode, bool halfTexelOffset) const
+        {
+            // Same as Buffer::getSampler.
+
+            const auto scale  = (coordMode == BufferCoordMode::BufferSpace) ? Coords(1.0f) : Coords(_dims);
+            const auto offset = halfTexelOffset ? Coords(0.0f) : 0.5f / Coords(_dims);
+
+            return Sampler(getConstAccessor(),
+                           _dims,
+                           scale,
+                           offset,
+                           addressMode,
+                           filterMode);
+        }
+
+        /**
+         * \brief Returns the memory resource the buffer storage was acquired from.
+         */
+        const MemoryResource::Ref& getMemoryResource() const
+        {
+            return _resource;
+        }
+
+    private:
+        static uint setupIndexer(Indexer& indexer, const Dims& dims, BufferFlags flags)
+        {
+            const uint rowAlignment = hasFlags(flags, BufferFlags::AlignRows) ? Plane::RowAlignment : 1;
+            const uint planeAlignment = uint(Alignment / std::min(Alignment, sizeof(Storage) & (~sizeof(Storage) + 1)));
+            const uint planeSize = indexer.setup(dims, rowAlignment, int(getHaloWidth(flags)));
+
+            return (planeSize + planeAlignment - 1) / planeAlignment * planeAlignment;
+        }
+
+    protected:
+        Dims                _dims;
+        BufferFlags         _flags;
+        MemoryResource::Ref _resource;
+        Indexer             _indexer;
+        int                 _planeStride;
+        uint                _storage;
+        Storage*            _ptr;
+
+    public:
+        static Ref Create(const Dims& dims, BufferFlags flags = BufferFlags::Default)
+        {
+            return Ref(new PlanarBuffer(dims, flags, HostMemoryResource::Get(flags), false));
+        }
+
+        /**
+         * \brief Creates a new planar buffer whose storage is acquired from the given memory
+         *        resource.
+         * \param dims Dimensions of the buffer.
+         * \param resource Memory resource to acquire the storage from.
+         * \param zeroed Whether the buffer must start zero-filled.
+         * \param flags Flags of the buffer. Only the layout ones (i.e. AlignRows and the halo)
+         *              are honored, allocation policies being up to the resource.
+         */
+        static Ref Create(const Dims& dims, const MemoryResource::Ref& resource, bool zeroed = false, BufferFlags flags = BufferFlags::Default)
+        {
+            return Ref(new PlanarBuffer(dims, flags, resource, zeroed));
+        }
+
+        /**
+         * \brief Returns the size of the storage a buffer of the given dimensions would acquire
+         *        from its memory resource, in bytes.
+         * \param dims Dimensions of the buffer.
+         * \param flags Flags of the buffer.
+         */
+        static std::size_t getStorageSize(const Dims& dims, BufferFlags flags = BufferFlags::Default)
+        {
+            Indexer indexer;
+            return sizeof(Storage) * setupIndexer(indexer, dims, flags) * Components;
+        }
+    };
+
+    template <uint _Order, typename _Value, typename _Storage>
+    constexpr typename PlanarBuffer<_Order, _Value, _Storage>::LocationTag PlanarBuffer<_Order, _Value, _Storage>::Location;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    template <uint O, typename T, typename S = typename Traits<T>::ScalarType> using PlanarBufferRef = typename PlanarBuffer<O, T, S>::Ref;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_PLANAR_BUFFER_HPP */
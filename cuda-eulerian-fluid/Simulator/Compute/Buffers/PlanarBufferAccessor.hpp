@@ -0,0 +1,203 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_PLANAR_BUFFER_ACCESSOR_HPP
+#define HF_SIMULATOR_COMPUTE_PLANAR_BUFFER_ACCESSOR_HPP
+
+#include <Simulator/Simulator.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Reads the values of a planar buffer (see PlanarBuffer), gathering their components
+     *        from each of its planes. Planes can also be read on their own, as scalar buffers.
+     * \tparam _Buffer Type of the planar buffer.
+     */
+    template <typename _Buffer>
+    struct PlanarBufferConstAccessor
+    {
+    public:
+        static constexpr uint Order      = _Buffer::Order;
+        static constexpr uint Components = _Buffer::Components;
+
+        using Buffer             = _Buffer;
+        using Value              = typename _Buffer::Value;
+        using Scalar             = typename _Buffer::Scalar;
+        using Storage            = typename _Buffer::Storage;
+        using Conversion         = typename _Buffer::Conversion;
+        using Index              = typename _Buffer::Index;
+        using Indexer            = typename _Buffer::Indexer;
+        using PlaneConstAccessor = typename _Buffer::PlaneConstAccessor;
+
+        /**
+         * \brief Rows of each plane can be walked with plain pointer arithmetic, through
+         *        getPlanePtr instead of getPtr. Values not stored natively must go through
+         *        getValue and setValue instead.
+         */
+        static constexpr bool IsRowContiguous = Indexer::IsRowContiguous && Conversion::IsNative;
+
+        /**
+         * \brief Marks the accessor as planar, for kernels walking rows plane by plane.
+         */
+        static constexpr bool IsPlanar = true;
+
+    public:
+        PlanarBufferConstAccessor() = default;
+
+        PlanarBufferConstAccessor(const Indexer& indexer, Storage* ptr, int planeStride, const Index& dims)
+            : _indexer(indexer)
+            , _ptr(ptr)
+            , _planeStride(planeStride)
+            , _maxIdx(dims - 1)
+        {
+        }
+
+        HF_COPY_IMPLEMENTATION(PlanarBufferConstAccessor, default)
+
+        HF_MOVE_IMPLEMENTATION(PlanarBufferConstAccessor, default)
+
+    public:
+        /**
+         * \brief Reads the value at the given index. Indices outside of the buffer are clamped to
+         *        its edges.
+         */
+        HF_HDINLINE Value getValue(const Index& idx) const
+        {
+            const int offset = _indexer.computeOffset(clamp(idx, Index(0), _maxIdx));
+            Value value;
+
+            for (uint c = 0; c < Components; ++c)
+                value[c] = Conversion::load(_ptr[c * _planeStride + offset]);
+
+            return value;
+        }
+
+        /**
+         * \brief Reads a single component of the value at the given index, only touching its
+         *        plane. Indices outside of the buffer are clamped to its edges.
+         */
+        HF_HDINLINE Scalar getComponent(const Index& idx, uint component) const
+        {
+            return Conversion::load(_ptr[component * _planeStride + _indexer.computeOffset(clamp(idx, Index(0), _maxIdx))]);
+        }
+
+        /**
+         * \brief Returns the address of the given component of the value at the given index.
+         */
+        HF_HDINLINE Storage* getPlanePtr(uint component, const Index& idx) const
+        {
+            return &_ptr[component * _planeStride + _indexer.computeOffset(idx)];
+        }
+
+        /**
+         * \brief Returns an accessor reading the plane of the given component alone.
+         */
+        HF_HDINLINE PlaneConstAccessor getPlane(uint component) const
+        {
+            return PlaneConstAccessor(_indexer, _ptr + component * _planeStride, _maxIdx + 1);
+        }
+
+        /**
+         * \brief Returns the distance (in elements) between neighbouring indices along each axis,
+         *        within each plane.
+         */
+        HF_HDINLINE const Index& getStride() const
+        {
+            return _indexer.getStride();
+        }
+
+        /**
+         * \brief Returns the indexer mapping indices to offsets into each plane.
+         */
+        HF_HDINLINE const Indexer& getIndexer() const
+        {
+            return _indexer;
+        }
+
+        /**
+         * \brief Returns the largest valid index, i.e. the dimensions of the buffer minus one.
+         */
+        HF_HDINLINE const Index& getMaxIndex() const
+        {
+            return _maxIdx;
+        }
+
+    protected:
+        Indexer  _indexer;
+        Storage* _ptr;
+        int      _planeStride;
+        Index    _maxIdx;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Reads and writes the values of a planar buffer (see PlanarBuffer), scattering their
+     *        components into each of its planes.
+     * \tparam _Buffer Type of the planar buffer.
+     */
+    template <typename _Buffer>
+    struct PlanarBufferAccessor : public PlanarBufferConstAccessor<_Buffer>
+    {
+    public:
+        static constexpr uint Components = _Buffer::Components;
+
+        using Value         = typename _Buffer::Value;
+        using Scalar        = typename _Buffer::Scalar;
+        using Storage       = typename _Buffer::Storage;
+        using Conversion    = typename _Buffer::Conversion;
+        using Index         = typename _Buffer::Index;
+        using PlaneAccessor = typename _Buffer::PlaneAccessor;
+
+    public:
+        using PlanarBufferConstAccessor<_Buffer>::PlanarBufferConstAccessor;
+
+    public:
+        /**
+         * \brief Writes the value at the given index.
+         */
+        HF_HDINLINE void setValue(const Index& idx, const Value& value)
+        {
+            const int offset = this->_indexer.computeOffset(idx);
+
+            for (uint c = 0; c < Components; ++c)
+                this->_ptr[c * this->_planeStride + offset] = Conversion::store(value[c]);
+        }
+
+        /**
+         * \brief Writes a single component of the value at the given index.
+         */
+        HF_HDINLINE void setComponent(const Index& idx, uint component, const Scalar& value)
+        {
+            this->_ptr[component * this->_planeStride + this->_indexer.computeOffset(idx)] = Conversion::store(value);
+        }
+
+        /**
+         * \brief Returns an accessor reading and writing the plane of the given component alone.
+         */
+        HF_HDINLINE PlaneAccessor getPlane(uint component) const
+        {
+            return PlaneAccessor(this->_indexer, this->_ptr + component * this->_planeStride, this->_maxIdx + 1);
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Determines whether the given accessor is planar, i.e. it exposes IsPlanar.
+     */
+    template <typename Accessor, typename = void>
+    struct IsPlanarAccessor : std::false_type
+    {
+    };
+
+    template <typename Accessor>
+    struct IsPlanarAccessor<Accessor, typename std::conditional<true, void, decltype(Accessor::IsPlanar)>::type>
+        : std::integral_constant<bool, Accessor::IsPlanar>
+    {
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_PLANAR_BUFFER_ACCESSOR_HPP */
@@ -0,0 +1,612 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_SPARSE_BUFFER_HPP
+#define HF_SIMULATOR_COMPUTE_SPARSE_BUFFER_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/HostExecutor.hpp>
+#include <Simulator/Compute/Buffers/BufferAddressMode.hpp>
+#include <Simulator/Compute/Buffers/BufferCoordMode.hpp>
+#include <Simulator/Compute/Buffers/BufferFilterMode.hpp>
+#include <Simulator/Compute/Buffers/BufferFlags.hpp>
+#include <Simulator/Compute/Buffers/BufferSampler.hpp>
+#include <Simulator/Compute/Buffers/NumpyFormat.hpp>
+#include <Simulator/Compute/Buffers/SparseBufferAccessor.hpp>
+#include <Simulator/Compute/Memory/HostMemoryResource.hpp>
+#include <Simulator/Compute/Memory/PooledMemoryResource.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Host buffer split into cubic tiles of TileSize cells along each axis, of which only
+     *        the active ones are allocated. A dense table maps every tile to its storage (or to
+     *        none), and values of inactive tiles read as a background value. Memory is then
+     *        proportional to the active volume, plus a pointer per tile.
+     *
+     *        Tiles are activated and released between kernels, never from within them: kernels
+     *        only write into active tiles, and are launched over those alone with
+     *        Kernel::executeOnTiles. Released tiles are kept for reuse until the buffer is
+     *        destroyed.
+     * \tparam _Order Order (dimensions) of the buffer.
+     * \tparam _Value Type of the values.
+     * \tparam _TileSize Extent of the tiles along each axis. Must be a power of two.
+     */
+    template <uint _Order, typename _Value, uint _TileSize = 8>
+    class SparseBuffer
+    {
+    public:
+        static constexpr uint Order    = _Order;
+        static constexpr uint TileSize = _TileSize;
+
+        static_assert(_Order >= 1 && _Order <= 3, "Sparse buffers only support orders up to 3.");
+        static_assert(_TileSize > 1 && (_TileSize & (_TileSize - 1)) == 0, "The tile size must be a power of two.");
+
+        using Ref           = HF::Ref<SparseBuffer>;
+        using Value         = _Value;
+        using Dims          = IntN<_Order>;
+        using Index         = IntN<_Order>;
+        using Coords        = FloatN<_Order>;
+        using Accessor      = SparseBufferAccessor<SparseBuffer>;
+        using ConstAccessor = SparseBufferConstAccessor<SparseBuffer>;
+        using Sampler       = BufferSampler<SparseBuffer>;
+
+        /**
+         * \brief Shift turning indices into tile indices.
+         */
+        static constexpr int TileShift = _TileSize >= 256 ? 8 : _TileSize >= 128 ? 7 : _TileSize >= 64 ? 6
+                                       : _TileSize >= 32 ? 5 : _TileSize >= 16 ? 4 : _TileSize >= 8 ? 3
+                                       : _TileSize >= 4 ? 2 : 1;
+
+        static_assert((1u << TileShift) == _TileSize, "Tiles larger than 256 cells are not supported.");
+
+        /**
+         * \brief No. of values per tile.
+         */
+        static constexpr uint TileVolume = 1u << (TileShift * _Order);
+
+        /**
+         * \brief Alignment of the host allocations, in bytes.
+         */
+        static constexpr std::size_t Alignment = 64;
+
+        /**
+         * \brief No. of tiles allocated at once when no released one is left.
+         */
+        static constexpr uint ChunkTiles = 64;
+
+    protected:
+        SparseBuffer(const Dims& dims, BufferFlags flags, const MemoryResource::Ref& resource, bool zeroed)
+            : _dims(dims)
+            , _tileDims(getTileDims(dims))
+            , _tileStride(exclusiveCumProd(_tileDims))
+            , _tileCount(uint(compMul(_tileDims)))
+            , _background(0)
+            , _resource(resource)
+            , _tileResource(PooledMemoryResource::GetHostPool(flags))
+            , _activeTilesDirty(false)
+        {
+            // Acquire the tile table, every tile starting inactive.
+
+            _tiles = static_cast<Value**>(_resource->allocate(sizeof(Value*) * _tileCount, Alignment, zeroed));
+
+            if (!zeroed)
+                std::fill(_tiles, _tiles + _tileCount, nullptr);
+        }
+
+    public:
+        SparseBuffer() = delete;
+
+        ~SparseBuffer()
+        {
+            for (Value* chunk : _chunks)
+                _tileResource->deallocate(chunk, sizeof(Value) * TileVolume * ChunkTiles, Alignment);
+
+            _resource->deallocate(_tiles, sizeof(Value*) * _tileCount, Alignment);
+            _tiles = nullptr;
+        }
+
+        HF_COPY_IMPLEMENTATION(SparseBuffer, delete)
+
+        HF_MOVE_IMPLEMENTATION(SparseBuffer, delete)
+
+    public:
+        const Dims& getDims() const
+        {
+            return _dims;
+        }
+
+        /**
+         * \brief Returns the no. of tiles along each axis.
+         */
+        const Dims& getTileDims() const
+        {
+            return _tileDims;
+        }
+
+        /**
+         * \brief Returns the value read from inactive tiles.
+         */
+        const Value& getBackground() const
+        {
+            return _background;
+        }
+
+        ConstAccessor getConstAccessor() const
+        {
+            return ConstAccessor(_tiles, _tileStride, _dims, _background);
+        }
+
+        Accessor getAccessor()
+        {
+            return Accessor(_tiles, _tileStride, _dims, _background);
+        }
+
+        /**
+         * \brief Returns a sampler over the buffer (see Buffer::getSampler).
+         */
+        Sampler getSampler(BufferAddressMode addressMode, BufferFilterMode filterMode, BufferCoordMode coordMode, bool halfTexelOffset) const
+        {
+            const auto scale  = (coordMode == BufferCoordMode::BufferSpace) ? Coords(1.0f) : Coords(_dims);
+            const auto offset = halfTexelOffset ? Coords(0.0f) : 0.5f / Coords(_dims);
+
+            return Sampler(getConstAccessor(),
+                           _dims,
+                           scale,
+                           offset,
+                           addressMode,
+                           filterMode);
+        }
+
+        /**
+         * \brief Returns the indices of the active tiles, in storage order.
+         */
+        const std::vector<Index>& getActiveTiles() const
+        {
+            if (_activeTilesDirty)
+            {
+                _activeTiles.clear();
+
+                for (uint tile = 0; tile < _tileCount; ++tile)
+                {
+                    if (_tiles[tile] != nullptr)
+                        _activeTiles.push_back(getTileIndex(tile));
+                }
+
+                _activeTilesDirty = false;
+            }
+
+            return _activeTiles;
+        }
+
+        bool isTileActive(const Index& tileIdx) const
+        {
+            return _tiles[computeTileOffset(tileIdx)] != nullptr;
+        }
+
+        /**
+         * \brief Activates the given tile, if it was not already. Its values start as the
+         *        background value.
+         * \param tileIdx Index of the tile.
+         */
+        void activateTile(const Index& tileIdx)
+        {
+            activateTileAt(uint(computeTileOffset(tileIdx)));
+        }
+
+        /**
+         * \brief Releases the given tile, so that its values read as the background value.
+         * \param tileIdx Index of the tile.
+         */
+        void deactivateTile(const Index& tileIdx)
+        {
+            deactivateTileAt(uint(computeTileOffset(tileIdx)));
+        }
+
+        /**
+         * \brief Activates every tile overlapping the given region of cells. Cells outside of the
+         *        buffer are ignored.
+         * \param offset Index of the first cell of the region.
+         * \param size Size of the region, in cells.
+         */
+        void activateRegion(const Index& offset, const Dims& size)
+        {
+            if (any(lessThan(size, Dims(1))) || any(lessThan(offset + size, Index(1))) || any(greaterThanEqual(offset, _dims)))
+                return;
+
+            const Index first = clamp(offset, Index(0), _dims - 1);
+            const Index last = clamp(offset + size - 1, Index(0), _dims - 1);
+
+            forEachTile(first >> TileShift, last >> TileShift, [this](uint tile)
+            {
+                activateTileAt(tile);
+            });
+        }
+
+        /**
+         * \brief Makes the active tiles those active in another buffer of the same dimensions, or
+         *        within the given no. of tiles from them, releasing the rest. Lets kernels writing
+         *        into this buffer from the values of the other one (e.g. an advection) cover every
+         *        tile they may reach.
+         * \param other Buffer whose tiles to match.
+         * \param dilation No. of tiles to grow the active region by, along each axis.
+         */
+        template <typename OtherBuffer>
+        void matchTiles(const OtherBuffer& other, int dilation)
+        {
+            HF_ASSERT(all(equal(other.getTileDims(), _tileDims)), "Only buffers of the same tile dimensions can be matched.");
+
+            std::vector<uchar> required(_tileCount, 0);
+
+            for (const Index& tileIdx : other.getActiveTiles())
+            {
+                const Index first = clamp(tileIdx - dilation, Index(0), _tileDims - 1);
+                const Index last = clamp(tileIdx + dilation, Index(0), _tileDims - 1);
+
+                forEachTile(first, last, [&required](uint tile)
+                {
+                    required[tile] = 1;
+                });
+            }
+
+            for (uint tile = 0; tile < _tileCount; ++tile)
+            {
+                if (required[tile])
+                    activateTileAt(tile);
+                else
+                    deactivateTileAt(tile);
+            }
+        }
+
+        /**
+         * \brief Makes the given tiles the active ones, releasing the rest. Tiles beyond the
+         *        buffer are skipped, so that buffers whose dimensions differ by less than a tile
+         *        (e.g. the faces of a staggered grid and its cells) can share a list.
+         * \param tiles Indices of the tiles to keep active.
+         */
+        void setActiveTiles(const std::vector<Index>& tiles)
+        {
+            std::vector<uchar> required(_tileCount, 0);
+
+            for (const Index& tileIdx : tiles)
+            {
+                if (all(lessThan(tileIdx, _tileDims)))
+                    required[computeTileOffset(tileIdx)] = 1;
+            }
+
+            for (uint tile = 0; tile < _tileCount; ++tile)
+            {
+                if (required[tile])
+                    activateTileAt(tile);
+                else
+                    deactivateTileAt(tile);
+            }
+        }
+
+        /**
+         * \brief Releases the active tiles whose values are all within the given distance of the
+         *        background value, e.g. once their contents have decayed or moved away.
+         * \param threshold Largest distance to the background value of released tiles.
+         * \return No. of released tiles.
+         */
+        uint pruneTiles(float threshold)
+        {
+            const std::vector<Index>& activeTiles = getActiveTiles();
+            std::vector<uchar> released(activeTiles.size(), 0);
+
+            HostExecutor::parallelFor(uint(activeTiles.size()), TileVolume, [&](uint begin, uint end)
+            {
+                for (uint i = begin; i < end; ++i)
+                {
+                    const Value* values = _tiles[computeTileOffset(activeTiles[i])];
+                    bool isBackground = true;
+
+                    for (uint j = 0; j < TileVolume && isBackground; ++j)
+                        isBackground = length(values[j] - _background) <= threshold;
+
+                    released[i] = isBackground;
+                }
+            });
+
+            uint releasedCount = 0;
+
+            for (std::size_t i = 0; i < released.size(); ++i)
+            {
+                if (released[i])
+                {
+                    deactivateTileAt(uint(computeTileOffset(activeTiles[i])));
+                    ++releasedCount;
+                }
+            }
+
+            return releasedCount;
+        }
+
+        /**
+         * \brief Releases every tile, and sets the background value.
+         */
+        void clear(const Value& background)
+        {
+            for (uint tile = 0; tile < _tileCount; ++tile)
+                deactivateTileAt(tile);
+
+            _background = background;
+        }
+
+        /**
+         * \brief Sets the value read from inactive tiles, leaving the active ones as they are.
+         */
+        void setBackground(const Value& background)
+        {
+            _background = background;
+        }
+
+        /**
+         * \brief Sets every value of the active tiles, leaving the background value as it is.
+         */
+        void fill(const Value& value)
+        {
+            forEachActiveTile([&value](Value* values)
+            {
+                std::fill(values, values + TileVolume, value);
+            });
+        }
+
+        /**
+         * \brief Multiplies every value of the active tiles, and the background value, by the
+         *        given factor.
+         */
+        template <typename Factor>
+        void scale(const Factor& factor)
+        {
+            forEachActiveTile([&factor](Value* values)
+            {
+                for (uint i = 0; i < TileVolume; ++i)
+                    values[i] *= factor;
+            });
+
+            _background *= factor;
+        }
+
+        /**
+         * \brief Returns the largest magnitude of the values of a buffer of scalars, the
+         *        background value included.
+         */
+        Value getMaxAbs() const
+        {
+            const std::vector<Index>& activeTiles = getActiveTiles();
+            std::vector<Value> tileMaxAbs(activeTiles.size(), Value(0));
+
+            HostExecutor::parallelFor(uint(activeTiles.size()), TileVolume, [&](uint begin, uint end)
+            {
+                for (uint i = begin; i < end; ++i)
+                {
+                    const Value* values = _tiles[computeTileOffset(activeTiles[i])];
+                    Value maxAbs = Value(0);
+
+                    for (uint j = 0; j < TileVolume; ++j)
+                        maxAbs = std::max(maxAbs, std::abs(values[j]));
+
+                    tileMaxAbs[i] = maxAbs;
+                }
+            });
+
+            Value maxAbs = std::abs(_background);
+
+            for (const Value& value : tileMaxAbs)
+                maxAbs = std::max(maxAbs, value);
+
+            return maxAbs;
+        }
+
+        /**
+         * \brief Saves the buffer into a NumPy file, laid out as Buffer::saveToFile does. Values
+         *        of inactive tiles are written as the background value.
+         * \param filename Path to the file.
+         * \return Whether the buffer could be saved.
+         */
+        bool saveToFile(const std::string& filename) const
+        {
+            using Element = NumpyElement<Value>;
+            using Scalar = typename Element::Scalar;
+
+            std::ofstream stream(filename, std::ofstream::binary);
+
+            if (!stream.good())
+                return false;
+
+            NumpyHeader header;
+            header.descr = NumpyFormat::getDescr<Scalar>();
+            header.fortranOrder = false;
+
+            for (uint i = _Order; i > 0; --i)
+                header.shape.push_back(ulong(_dims[i - 1]));
+
+            if (Element::Components > 1)
+                header.shape.push_back(Element::Components);
+
+            NumpyFormat::writeHeader(stream, header);
+
+            // Write the payload a row at a time.
+
+            const uint rowLength = uint(_dims[0]);
+            const uint rowCount = uint(compMul(_dims) / _dims[0]);
+            const ConstAccessor accessor = getConstAccessor();
+
+            std::vector<Scalar> row(std::size_t(rowLength) * Element::Components);
+
+            for (uint i = 0; i < rowCount && stream.good(); ++i)
+            {
+                Index index;
+                uint remainder = i;
+
+                for (uint axis = 1; axis < _Order; ++axis)
+                {
+                    index[axis] = int(remainder % uint(_dims[axis]));
+                    remainder /= uint(_dims[axis]);
+                }
+
+                Scalar* dst = row.data();
+
+                for (uint x = 0; x < rowLength; ++x)
+                {
+                    index[0] = int(x);
+                    Value value = accessor.getValue(index);
+
+                    for (uint c = 0; c < Element::Components; ++c)
+                        *dst++ = Element::getComponent(value, c);
+                }
+
+                stream.write(reinterpret_cast<const char*>(row.data()), std::streamsize(sizeof(Scalar) * row.size()));
+            }
+
+            return stream.good();
+        }
+
+    protected:
+        int computeTileOffset(const Index& tileIdx) const
+        {
+            return compAdd(tileIdx * _tileStride);
+        }
+
+        Index getTileIndex(uint tile) const
+        {
+            Index tileIdx;
+
+            for (uint axis = 0; axis < Order; ++axis)
+            {
+                tileIdx[axis] = int(tile % uint(_tileDims[axis]));
+                tile /= uint(_tileDims[axis]);
+            }
+
+            return tileIdx;
+        }
+
+        template <typename Function>
+        void forEachTile(const Index& first, const Index& last, Function&& func) const
+        {
+            const Index count = last - first + 1;
+            const uint tileCount = uint(compMul(count));
+
+            for (uint i = 0; i < tileCount; ++i)
+            {
+                Index tileIdx = first;
+                uint remainder = i;
+
+                for (uint axis = 0; axis < Order; ++axis)
+                {
+                    tileIdx[axis] += int(remainder % uint(count[axis]));
+                    remainder /= uint(count[axis]);
+                }
+
+                func(uint(computeTileOffset(tileIdx)));
+            }
+        }
+
+        template <typename Function>
+        void forEachActiveTile(Function&& func)
+        {
+            const std::vector<Index>& activeTiles = getActiveTiles();
+
+            HostExecutor::parallelFor(uint(activeTiles.size()), TileVolume, [&](uint begin, uint end)
+            {
+                for (uint i = begin; i < end; ++i)
+                    func(_tiles[computeTileOffset(activeTiles[i])]);
+            });
+        }
+
+        void activateTileAt(uint tile)
+        {
+            if (_tiles[tile] != nullptr)
+                return;
+
+            // Take a released tile, allocating a new chunk of them if none is left.
+
+            if (_freeTiles.empty())
+            {
+                Value* chunk = static_cast<Value*>(_tileResource->allocate(sizeof(Value) * TileVolume * ChunkTiles, Alignment, false));
+                _chunks.push_back(chunk);
+
+                for (uint i = ChunkTiles; i > 0; --i)
+                    _freeTiles.push_back(chunk + (i - 1) * TileVolume);
+            }
+
+            Value* values = _freeTiles.back();
+            _freeTiles.pop_back();
+
+            std::fill(values, values + TileVolume, _background);
+
+            _tiles[tile] = values;
+            _activeTilesDirty = true;
+        }
+
+        void deactivateTileAt(uint tile)
+        {
+            if (_tiles[tile] == nullptr)
+                return;
+
+            _freeTiles.push_back(_tiles[tile]);
+
+            _tiles[tile] = nullptr;
+            _activeTilesDirty = true;
+        }
+
+    protected:
+        Dims                       _dims;
+        Dims                       _tileDims;
+        Index                      _tileStride;
+        uint                       _tileCount;
+        Value                      _background;
+        Value**                    _tiles;
+        MemoryResource::Ref        _resource;
+        MemoryResource::Ref        _tileResource;
+        std::vector<Value*>        _chunks;
+        std::vector<Value*>        _freeTiles;
+        mutable std::vector<Index> _activeTiles;
+        mutable bool               _activeTilesDirty;
+
+    public:
+        static Ref Create(const Dims& dims, BufferFlags flags = BufferFlags::Default)
+        {
+            return Ref(new SparseBuffer(dims, flags, HostMemoryResource::Get(flags), false));
+        }
+
+        /**
+         * \brief Creates a new sparse buffer whose tile table is acquired from the given memory
+         *        resource. Tiles are always acquired from the shared host pool.
+         * \param dims Dimensions of the buffer.
+         * \param resource Memory resource to acquire the tile table from.
+         * \param zeroed Whether the resource hands out zero-filled storage.
+         * \param flags Flags of the host allocations.
+         */
+        static Ref Create(const Dims& dims, const MemoryResource::Ref& resource, bool zeroed = false, BufferFlags flags = BufferFlags::Default)
+        {
+            return Ref(new SparseBuffer(dims, flags, resource, zeroed));
+        }
+
+        /**
+         * \brief Returns the no. of tiles along each axis of a buffer with the given dimensions.
+         */
+        static Dims getTileDims(const Dims& dims)
+        {
+            return (dims + int(TileSize) - 1) >> TileShift;
+        }
+
+        /**
+         * \brief Returns the size of the tile table of a buffer with the given dimensions, in
+         *        bytes. Tiles are not accounted for, as they are allocated on activation.
+         */
+        static std::size_t getStorageSize(const Dims& dims)
+        {
+            return sizeof(Value*) * std::size_t(compMul(getTileDims(dims)));
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    template <uint O, typename T, uint S = 8> using SparseBufferRef = typename SparseBuffer<O, T, S>::Ref;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_SPARSE_BUFFER_HPP */
@@ -0,0 +1,139 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_SPARSE_BUFFER_ACCESSOR_HPP
+#define HF_SIMULATOR_COMPUTE_SPARSE_BUFFER_ACCESSOR_HPP
+
+#include <Simulator/Simulator.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Reads the values of a sparse buffer (see SparseBuffer) through its tile table. Values
+     *        of inactive tiles read as the background value of the buffer.
+     * \tparam _Buffer Type of the sparse buffer.
+     */
+    template <typename _Buffer>
+    struct SparseBufferConstAccessor
+    {
+    public:
+        static constexpr uint Order = _Buffer::Order;
+
+        using Buffer = _Buffer;
+        using Value  = typename _Buffer::Value;
+        using Index  = typename _Buffer::Index;
+
+        static constexpr int TileShift = _Buffer::TileShift;
+        static constexpr int TileMask  = _Buffer::TileSize - 1;
+
+        /**
+         * \brief Rows cross tiles, which need not be adjacent in memory (nor allocated).
+         */
+        static constexpr bool IsRowContiguous = false;
+
+    public:
+        SparseBufferConstAccessor() = default;
+
+        SparseBufferConstAccessor(Value* const* tiles, const Index& tileStride, const Index& dims, const Value& background)
+            : _tiles(tiles)
+            , _tileStride(tileStride)
+            , _maxIdx(dims - 1)
+            , _background(background)
+        {
+        }
+
+        HF_COPY_IMPLEMENTATION(SparseBufferConstAccessor, default)
+
+        HF_MOVE_IMPLEMENTATION(SparseBufferConstAccessor, default)
+
+    public:
+        /**
+         * \brief Reads the value at the given index, or the background value if its tile is not
+         *        active. Indices outside of the buffer are clamped to its edges.
+         */
+        HF_HDINLINE Value getValue(const Index& idx) const
+        {
+            const Index cellIdx = clamp(idx, Index(0), _maxIdx);
+            const Value* tile = _tiles[computeTileOffset(cellIdx)];
+
+            return tile != nullptr ? tile[computeLocalOffset(cellIdx)] : _background;
+        }
+
+        /**
+         * \brief Returns whether the tile holding the given index is active.
+         */
+        HF_HDINLINE bool isActive(const Index& idx) const
+        {
+            return _tiles[computeTileOffset(clamp(idx, Index(0), _maxIdx))] != nullptr;
+        }
+
+        /**
+         * \brief Returns the largest valid index, i.e. the dimensions of the buffer minus one.
+         */
+        HF_HDINLINE const Index& getMaxIndex() const
+        {
+            return _maxIdx;
+        }
+
+    protected:
+        HF_HDINLINE int computeTileOffset(const Index& idx) const
+        {
+            int offset = 0;
+
+            for (uint i = 0; i < Order; ++i)
+                offset += (idx[i] >> TileShift) * _tileStride[i];
+
+            return offset;
+        }
+
+        static HF_HDINLINE int computeLocalOffset(const Index& idx)
+        {
+            int offset = 0;
+
+            for (uint i = 0; i < Order; ++i)
+                offset += (idx[i] & TileMask) << (TileShift * i);
+
+            return offset;
+        }
+
+    protected:
+        Value* const* _tiles;
+        Index         _tileStride;
+        Index         _maxIdx;
+        Value         _background;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Reads and writes the values of a sparse buffer (see SparseBuffer). Writes into
+     *        inactive tiles are discarded, so tiles must be activated before being written.
+     * \tparam _Buffer Type of the sparse buffer.
+     */
+    template <typename _Buffer>
+    struct SparseBufferAccessor : public SparseBufferConstAccessor<_Buffer>
+    {
+    public:
+        using Value = typename _Buffer::Value;
+        using Index = typename _Buffer::Index;
+
+    public:
+        using SparseBufferConstAccessor<_Buffer>::SparseBufferConstAccessor;
+
+    public:
+        /**
+         * \brief Writes the value at the given index, if its tile is active.
+         */
+        HF_HDINLINE void setValue(const Index& idx, const Value& value)
+        {
+            Value* tile = this->_tiles[this->computeTileOffset(idx)];
+
+            if (tile != nullptr)
+                tile[this->computeLocalOffset(idx)] = value;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_SPARSE_BUFFER_ACCESSOR_HPP */
@@ -0,0 +1,203 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_STENCIL_ACCESSOR_HPP
+#define HF_SIMULATOR_COMPUTE_STENCIL_ACCESSOR_HPP
+
+#include <Simulator/Simulator.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    namespace Detail
+    {
+        /**
+         * \brief Whether the given accessor exposes its indexer and storage, so neighbours can
+         *        be reached from the offset of a cell instead of their own index. Planar
+         *        accessors expose an indexer but keep each component in a plane of its own, so
+         *        they have no single storage pointer and use the generic version.
+         */
+        template <typename Accessor, typename = void>
+        struct IsStencilAccessible : std::false_type
+        {
+        };
+
+        template <typename Accessor>
+        struct IsStencilAccessible<Accessor, typename std::conditional<true, void, decltype(std::declval<const Accessor&>().getIndexer(),
+                                                                                            std::declval<const Accessor&>().getPtr())>::type>
+            : std::true_type
+        {
+        };
+    }
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Reads the neighbourhood (up to one cell away along each axis) of a cell through an
+     *        accessor, positioned once per cell. Reads outside of the accessed data are clamped
+     *        to its edges, as with getValue.
+     *
+     *        This generic version simply reads through the accessor (e.g. for surfaces). Buffer
+     *        accessors get a specialization reading neighbours from the offset of the cell.
+     * \tparam _Accessor Type of the accessor.
+     */
+    template <typename _Accessor, bool = Detail::IsStencilAccessible<_Accessor>::value>
+    struct StencilAccessor
+    {
+    public:
+        using Accessor              = _Accessor;
+        using Value                 = typename Accessor::Value;
+        using Index                 = typename Accessor::Index;
+        static constexpr uint Order = DimsOf<Index>::Value;
+
+    public:
+        HF_HDINLINE StencilAccessor(const Accessor& accessor, const Index& index)
+            : _accessor(accessor)
+            , _index(index)
+        {
+        }
+
+    public:
+        /**
+         * \brief Reads the value of the cell at the given compile-time offset.
+         */
+        template <int DX = 0, int DY = 0, int DZ = 0>
+        HF_HDINLINE Value at() const
+        {
+            return _accessor.getValue(_index + makeOffset(DX, DY, DZ));
+        }
+
+        /**
+         * \brief Reads the value of the neighbour along the given axis.
+         * \param axis Axis to move along.
+         * \param direction Direction to move along the axis, either 1 or -1.
+         */
+        HF_HDINLINE Value at(uint axis, int direction) const
+        {
+            Index index = _index;
+            index[axis] += direction;
+
+            return _accessor.getValue(index);
+        }
+
+        /**
+         * \brief Returns the index of the cell the accessor is positioned at.
+         */
+        HF_HDINLINE const Index& getIndex() const
+        {
+            return _index;
+        }
+
+    protected:
+        static HF_HDINLINE Index makeOffset(int dx, int dy, int dz)
+        {
+            Index offset(0);
+
+            offset[0] = dx;
+
+            if (Order > 1)
+                offset[1] = dy;
+
+            if (Order > 2)
+                offset[2] = dz;
+
+            return offset;
+        }
+
+    protected:
+        const Accessor& _accessor;
+        Index           _index;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Stencil accessor over buffers. Positioning computes the offset of the cell once,
+     *        and neighbours are reached from it with the indexer (i.e. by stride for linear
+     *        storage, and by masked or tile-local adds for Morton and tiled storage). Cells on
+     *        the edges of the buffer fall back to clamped reads.
+     * \tparam _Accessor Type of the accessor.
+     */
+    template <typename _Accessor>
+    struct StencilAccessor<_Accessor, true> : public StencilAccessor<_Accessor, false>
+    {
+    public:
+        using Base                  = StencilAccessor<_Accessor, false>;
+        using Accessor              = typename Base::Accessor;
+        using Value                 = typename Base::Value;
+        using Index                 = typename Base::Index;
+        static constexpr uint Order = Base::Order;
+
+    public:
+        HF_HDINLINE StencilAccessor(const Accessor& accessor, const Index& index)
+            : Base(accessor, index)
+            , _ptr(accessor.getPtr())
+            , _offset(0)
+            , _interior(all(greaterThan(index, Index(0))) && all(lessThan(index, accessor.getMaxIndex())))
+        {
+            if (_interior)
+                _offset = accessor.getIndexer().computeOffset(index);
+        }
+
+    public:
+        /**
+         * \brief Reads the value of the cell at the given compile-time offset.
+         */
+        template <int DX = 0, int DY = 0, int DZ = 0>
+        HF_HDINLINE Value at() const
+        {
+            static_assert(DX >= -1 && DX <= 1 && DY >= -1 && DY <= 1 && DZ >= -1 && DZ <= 1,
+                "Stencil offsets are limited to one cell along each axis.");
+
+            if (!_interior)
+                return Base::template at<DX, DY, DZ>();
+
+            int offset = _offset;
+
+            if (DX != 0)
+                offset = this->_accessor.getIndexer().computeNeighborOffset(offset, 0, DX);
+
+            if (Order > 1 && DY != 0)
+                offset = this->_accessor.getIndexer().computeNeighborOffset(offset, 1, DY);
+
+            if (Order > 2 && DZ != 0)
+                offset = this->_accessor.getIndexer().computeNeighborOffset(offset, 2, DZ);
+
+            return Accessor::Conversion::load(_ptr[offset]);
+        }
+
+        /**
+         * \brief Reads the value of the neighbour along the given axis.
+         * \param axis Axis to move along.
+         * \param direction Direction to move along the axis, either 1 or -1.
+         */
+        HF_HDINLINE Value at(uint axis, int direction) const
+        {
+            if (!_interior)
+                return Base::at(axis, direction);
+
+            return Accessor::Conversion::load(_ptr[this->_accessor.getIndexer().computeNeighborOffset(_offset, axis, direction)]);
+        }
+
+    private:
+        const typename Accessor::Storage* _ptr;
+        int                               _offset;
+        bool                              _interior;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Creates a stencil accessor positioned at the given cell.
+     * \param accessor Accessor to read through. Must outlive the stencil accessor.
+     * \param index Index of the cell.
+     */
+    template <typename Accessor>
+    HF_HDINLINE StencilAccessor<Accessor> makeStencil(const Accessor& accessor, const typename Accessor::Index& index)
+    {
+        return StencilAccessor<Accessor>(accessor, index);
+    }
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_STENCIL_ACCESSOR_HPP */
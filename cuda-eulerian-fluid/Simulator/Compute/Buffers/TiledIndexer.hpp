@@ -7,49 +7,130 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint _Order, int _TileDims>
+    /**
+     * \brief Indexer storing elements in tiles of a compile-time shape, laid out linearly both
+     *        within each tile and across tiles. Tiles extend along each axis by a power of two,
+     *        so addressing only takes shifts and masks, and may be elongated (e.g. 32x4x4, so
+     *        each tile holds whole cache lines of X rows).
+     * \tparam _Order Order (dimensions) of the indexed data.
+     * \tparam _TileX Extent of the tiles along the X axis.
+     * \tparam _TileY Extent of the tiles along the Y axis. Defaults to the X one.
+     * \tparam _TileZ Extent of the tiles along the Z axis. Defaults to the Y one.
+     */
+    template <uint _Order, int _TileX, int _TileY = _TileX, int _TileZ = _TileY>
     struct TiledIndexer
     {
     public:
         using Dims                    = IntN<_Order>;
         using Index                   = IntN<_Order>;
         static constexpr uint Order   = _Order;
-        static constexpr int TileDims = _TileDims;
+        static constexpr int TileX    = _TileX;
+        static constexpr int TileY    = _TileY;
+        static constexpr int TileZ    = _TileZ;
+
+        static_assert(_Order >= 1 && _Order <= 3, "Tiled indexers only support orders up to 3.");
+
+        static_assert(_TileX > 0 && (_TileX & (_TileX - 1)) == 0 &&
+                      _TileY > 0 && (_TileY & (_TileY - 1)) == 0 &&
+                      _TileZ > 0 && (_TileZ & (_TileZ - 1)) == 0,
+                      "The tile extents must be powers of two.");
+
+        /**
+         * \brief Whether consecutive indices along the X axis are stored contiguously in memory.
+         */
+        static constexpr bool IsRowContiguous = false;
 
     public:
         TiledIndexer() = default;
 
     public:
         /**
-         * \brief 
-         * \param size 
-         * \return 
+         * \brief Sets the indexer up for the given size.
+         * \param size Size of the indexed data.
+         * \return No. of elements of storage required, i.e. that of the tiles covering it.
          */
         HF_HINLINE uint setup(const Dims& size)
         {
-            const Dims tileCount = (size + Dims(TileDims - 1)) / TileDims;
-            const Dims totalSize = TileDims * tileCount;
+            const Dims tileDims = getTileDims();
+            const Dims tileCount = (size + tileDims - Dims(1)) / tileDims;
 
-            _elemStride = exclusiveCumProd(Dims(TileDims));
-            _tileStride = exclusiveCumProd(tileCount) * compMul(Dims(TileDims));
+            _tileStride = exclusiveCumProd(tileCount) * compMul(tileDims);
 
-            return compMul(totalSize);
+            return compMul(tileDims * tileCount);
         }
 
         /**
-         * \brief 
-         * \param idx 
-         * \return 
+         * \brief Returns the offset of the element at the given index.
+         * \param idx Index of the element.
          */
         HF_HDINLINE int computeOffset(const Index &idx) const
         {
-            const Index tileIdx = idx / int(TileDims);
-            const Index elemIdx = idx % int(TileDims);
-            return compAdd(tileIdx * _tileStride) + compAdd(elemIdx * _elemStride);
+            int offset = 0;
+
+            for (uint i = 0; i < Order; ++i)
+                offset += (idx[i] >> getTileShift(i)) * _tileStride[i] + ((idx[i] & getTileMask(i)) << getElemShift(i));
+
+            return offset;
+        }
+
+        /**
+         * \brief Returns the offset of the neighbour of an element along the given axis, without
+         *        decoding the offset of the element. Neighbours within the same tile only take an
+         *        add, and the rest also move by a whole tile.
+         * \param offset Offset of the element.
+         * \param axis Axis to move along.
+         * \param direction Direction to move along the axis, either 1 or -1.
+         */
+        HF_HDINLINE int computeNeighborOffset(int offset, uint axis, int direction) const
+        {
+            // Tiles start at multiples of their size, so the lowest bits of the offset locate
+            // the element within its tile.
+
+            const int elemShift = getElemShift(axis);
+            const int tileMask = getTileMask(axis);
+            const int local = (offset >> elemShift) & tileMask;
+
+            if (direction > 0)
+                return local < tileMask ? offset + (1 << elemShift) : offset + _tileStride[axis] - (tileMask << elemShift);
+            else
+                return local > 0 ? offset - (1 << elemShift) : offset - _tileStride[axis] + (tileMask << elemShift);
+        }
+
+        /**
+         * \brief Returns the extent of the tiles along each axis.
+         */
+        static HF_HDINLINE Dims getTileDims()
+        {
+            Dims tileDims;
+
+            for (uint i = 0; i < Order; ++i)
+                tileDims[i] = getTileMask(i) + 1;
+
+            return tileDims;
+        }
+
+    private:
+        static HF_HDINLINE constexpr int getTileMask(uint axis)
+        {
+            return (axis == 0 ? TileX : axis == 1 ? TileY : TileZ) - 1;
+        }
+
+        static HF_HDINLINE constexpr int getTileShift(uint axis)
+        {
+            return log2(uint(getTileMask(axis)) + 1);
+        }
+
+        static HF_HDINLINE constexpr int getElemShift(uint axis)
+        {
+            return axis == 0 ? 0 : getTileShift(axis - 1) + getElemShift(axis - 1);
+        }
+
+        static HF_HDINLINE constexpr int log2(uint value)
+        {
+            return value > 1 ? 1 + log2(value >> 1) : 0;
         }
 
     private:
-        Dims _elemStride;
         Dims _tileStride;
     };
 
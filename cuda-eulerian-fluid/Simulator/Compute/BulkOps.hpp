@@ -0,0 +1,633 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_BULK_OPS_HPP
+#define HF_SIMULATOR_COMPUTE_BULK_OPS_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/HostExecutor.hpp>
+#include <Simulator/Compute/Kernel.hpp>
+#include <Simulator/Compute/KernelConfig.hpp>
+#include <Simulator/Compute/KernelRow.hpp>
+#include <Simulator/Compute/KernelThread.hpp>
+#include <Simulator/Compute/CopyValueRegion.hpp>
+#include <Simulator/Compute/Buffers/Buffer.hpp>
+#include <Simulator/Compute/Buffers/PlanarBufferAccessor.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Element-wise operations over whole buffers, or over the same region of each of them:
+     *        fill, copy, scale, axpy, lerp and clamp, plus the largest magnitude of the values of
+     *        host buffers (maxAbs). On the host, buffers whose rows can be walked with plain
+     *        pointers (see BufferAccessor::IsRowContiguous) are processed a row at a time, so that
+     *        the inner loops vectorize, and whole buffers are filled and copied with memset /
+     *        memcpy over their storage, split across the host workers.
+     */
+    namespace BulkOps
+    {
+        namespace Detail
+        {
+            //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
+
+            /**
+             * \brief Rows of the given accessor as seen by the row kernels: a single run of values,
+             *        or one run of scalars per component for planar accessors.
+             */
+            template <typename Accessor, bool IsPlanar = IsPlanarAccessor<Accessor>::value>
+            struct RowView
+            {
+                static constexpr uint Count = 1;
+
+                static HF_HINLINE auto getPtr(Accessor& accessor, uint, const typename Accessor::Index& idx) -> decltype(accessor.getPtr(idx))
+                {
+                    return accessor.getPtr(idx);
+                }
+
+                template <typename T>
+                static HF_HINLINE const T& getPart(const T& value, uint)
+                {
+                    return value;
+                }
+            };
+
+            template <typename Accessor>
+            struct RowView<Accessor, true>
+            {
+                static constexpr uint Count = Accessor::Components;
+
+                static HF_HINLINE auto getPtr(Accessor& accessor, uint component, const typename Accessor::Index& idx) -> decltype(accessor.getPlanePtr(component, idx))
+                {
+                    return accessor.getPlanePtr(component, idx);
+                }
+
+                template <typename T>
+                static HF_HINLINE typename Accessor::Scalar getPart(const T& value, uint component)
+                {
+                    return typename Accessor::Value(value)[component];
+                }
+            };
+
+            /**
+             * \brief Enables the row entry point of kernels reading one accessor into another only
+             *        if both are planar or neither is, so that their rows line up.
+             */
+            template <typename SrcAccessor, typename DstAccessor>
+            using EnableIfRowsMatch = typename std::enable_if<IsPlanarAccessor<SrcAccessor>::value == IsPlanarAccessor<DstAccessor>::value>::type;
+
+            //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
+
+            template <uint Order, typename Location>
+            struct FillKernel
+            {
+                using Config = KernelConfig<KernelBlockDims::Inferred>;
+
+                using Thread = KernelThread<Order>;
+                using Row    = KernelRow<Order>;
+                using Region = CopyValueRegion<Order>;
+
+                template <typename DstAccessor, typename Value>
+                static HF_HDINLINE void kernel(Thread thread, Region region, DstAccessor dst, Value value)
+                {
+                    if (any(greaterThanEqual(thread.index, region.size))) return;
+
+                    dst.setValue(region.offset + thread.index, value);
+                }
+
+                template <typename DstAccessor, typename Value>
+                static HF_HINLINE void kernelRow(Row row, Region region, DstAccessor dst, Value value)
+                {
+                    using View = RowView<DstAccessor>;
+
+                    for (uint c = 0; c < View::Count; ++c)
+                    {
+                        auto* values = View::getPtr(dst, c, region.offset + row.index);
+                        const auto part = View::getPart(value, c);
+
+                        for (int x = 0; x < row.length; ++x)
+                            values[x] = part;
+                    }
+                }
+            };
+
+            template <uint Order, typename Location>
+            struct CopyKernel
+            {
+                using Config = KernelConfig<KernelBlockDims::Inferred>;
+
+                using Thread = KernelThread<Order>;
+                using Row    = KernelRow<Order>;
+                using Region = CopyValueRegion<Order>;
+
+                template <typename SrcAccessor, typename DstAccessor>
+                static HF_HDINLINE void kernel(Thread thread, Region region, SrcAccessor src, DstAccessor dst)
+                {
+                    if (any(greaterThanEqual(thread.index, region.size))) return;
+
+                    const auto idx = region.offset + thread.index;
+                    dst.setValue(idx, src.getValue(idx));
+                }
+
+                template <typename SrcAccessor, typename DstAccessor, typename = EnableIfRowsMatch<SrcAccessor, DstAccessor>>
+                static HF_HINLINE void kernelRow(Row row, Region region, SrcAccessor src, DstAccessor dst)
+                {
+                    for (uint c = 0; c < RowView<DstAccessor>::Count; ++c)
+                    {
+                        const auto* srcValues = RowView<SrcAccessor>::getPtr(src, c, region.offset + row.index);
+                        auto* dstValues = RowView<DstAccessor>::getPtr(dst, c, region.offset + row.index);
+
+                        for (int x = 0; x < row.length; ++x)
+                            dstValues[x] = srcValues[x];
+                    }
+                }
+            };
+
+            template <uint Order, typename Location>
+            struct ScaleKernel
+            {
+                using Config = KernelConfig<KernelBlockDims::Inferred>;
+
+                using Thread = KernelThread<Order>;
+                using Row    = KernelRow<Order>;
+                using Region = CopyValueRegion<Order>;
+
+                template <typename DstAccessor, typename Alpha>
+                static HF_HDINLINE void kernel(Thread thread, Region region, DstAccessor dst, Alpha alpha)
+                {
+                    if (any(greaterThanEqual(thread.index, region.size))) return;
+
+                    const auto idx = region.offset + thread.index;
+                    dst.setValue(idx, dst.getValue(idx) * alpha);
+                }
+
+                template <typename DstAccessor, typename Alpha>
+                static HF_HINLINE void kernelRow(Row row, Region region, DstAccessor dst, Alpha alpha)
+                {
+                    using View = RowView<DstAccessor>;
+
+                    for (uint c = 0; c < View::Count; ++c)
+                    {
+                        auto* values = View::getPtr(dst, c, region.offset + row.index);
+                        const auto part = View::getPart(alpha, c);
+
+                        for (int x = 0; x < row.length; ++x)
+                            values[x] *= part;
+                    }
+                }
+            };
+
+            template <uint Order, typename Location>
+            struct AxpyKernel
+            {
+                using Config = KernelConfig<KernelBlockDims::Inferred>;
+
+                using Thread = KernelThread<Order>;
+                using Row    = KernelRow<Order>;
+                using Region = CopyValueRegion<Order>;
+
+                template <typename SrcAccessor, typename DstAccessor, typename Alpha>
+                static HF_HDINLINE void kernel(Thread thread, Region region, SrcAccessor x, DstAccessor y, Alpha alpha)
+                {
+                    if (any(greaterThanEqual(thread.index, region.size))) return;
+
+                    const auto idx = region.offset + thread.index;
+                    y.setValue(idx, y.getValue(idx) + x.getValue(idx) * alpha);
+                }
+
+                template <typename SrcAccessor, typename DstAccessor, typename Alpha, typename = EnableIfRowsMatch<SrcAccessor, DstAccessor>>
+                static HF_HINLINE void kernelRow(Row row, Region region, SrcAccessor x, DstAccessor y, Alpha alpha)
+                {
+                    for (uint c = 0; c < RowView<DstAccessor>::Count; ++c)
+                    {
+                        const auto* xValues = RowView<SrcAccessor>::getPtr(x, c, region.offset + row.index);
+                        auto* yValues = RowView<DstAccessor>::getPtr(y, c, region.offset + row.index);
+                        const auto part = RowView<DstAccessor>::getPart(alpha, c);
+
+                        for (int i = 0; i < row.length; ++i)
+                            yValues[i] += xValues[i] * part;
+                    }
+                }
+            };
+
+            template <uint Order, typename Location>
+            struct LerpKernel
+            {
+                using Config = KernelConfig<KernelBlockDims::Inferred>;
+
+                using Thread = KernelThread<Order>;
+                using Row    = KernelRow<Order>;
+                using Region = CopyValueRegion<Order>;
+
+                template <typename SrcAccessor, typename DstAccessor, typename Weight>
+                static HF_HDINLINE void kernel(Thread thread, Region region, SrcAccessor src, DstAccessor dst, Weight t)
+                {
+                    if (any(greaterThanEqual(thread.index, region.size))) return;
+
+                    const auto idx = region.offset + thread.index;
+                    const auto value = dst.getValue(idx);
+                    dst.setValue(idx, value + (src.getValue(idx) - value) * t);
+                }
+
+                template <typename SrcAccessor, typename DstAccessor, typename Weight, typename = EnableIfRowsMatch<SrcAccessor, DstAccessor>>
+                static HF_HINLINE void kernelRow(Row row, Region region, SrcAccessor src, DstAccessor dst, Weight t)
+                {
+                    for (uint c = 0; c < RowView<DstAccessor>::Count; ++c)
+                    {
+                        const auto* srcValues = RowView<SrcAccessor>::getPtr(src, c, region.offset + row.index);
+                        auto* dstValues = RowView<DstAccessor>::getPtr(dst, c, region.offset + row.index);
+                        const auto part = RowView<DstAccessor>::getPart(t, c);
+
+                        for (int x = 0; x < row.length; ++x)
+                            dstValues[x] += (srcValues[x] - dstValues[x]) * part;
+                    }
+                }
+            };
+
+            template <uint Order, typename Location>
+            struct ClampKernel
+            {
+                using Config = KernelConfig<KernelBlockDims::Inferred>;
+
+                using Thread = KernelThread<Order>;
+                using Row    = KernelRow<Order>;
+                using Region = CopyValueRegion<Order>;
+
+                template <typename DstAccessor, typename Value>
+                static HF_HDINLINE void kernel(Thread thread, Region region, DstAccessor dst, Value minValue, Value maxValue)
+                {
+                    if (any(greaterThanEqual(thread.index, region.size))) return;
+
+                    const auto idx = region.offset + thread.index;
+                    dst.setValue(idx, clamp(dst.getValue(idx), minValue, maxValue));
+                }
+
+                template <typename DstAccessor, typename Value>
+                static HF_HINLINE void kernelRow(Row row, Region region, DstAccessor dst, Value minValue, Value maxValue)
+                {
+                    using View = RowView<DstAccessor>;
+
+                    for (uint c = 0; c < View::Count; ++c)
+                    {
+                        auto* values = View::getPtr(dst, c, region.offset + row.index);
+                        const auto minPart = View::getPart(minValue, c);
+                        const auto maxPart = View::getPart(maxValue, c);
+
+                        for (int x = 0; x < row.length; ++x)
+                            values[x] = clamp(values[x], minPart, maxPart);
+                    }
+                }
+            };
+
+            //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
+
+            /**
+             * \brief No. of storage elements filled or copied at once by each host worker.
+             */
+            static constexpr uint StorageChunkSize = 16384;
+
+            /**
+             * \brief Fills the given run of host storage with the given element, through memset
+             *        if its bytes are all zero.
+             */
+            template <typename Storage>
+            void fillStorage(Storage* ptr, uint count, const Storage& element)
+            {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&element);
+                const bool isZero = std::all_of(bytes, bytes + sizeof(Storage), [](unsigned char byte) { return byte == 0; });
+
+                const uint chunkCount = (count + StorageChunkSize - 1) / StorageChunkSize;
+
+                HostExecutor::parallelFor(chunkCount, StorageChunkSize, [=](uint begin, uint end)
+                {
+                    Storage* first = ptr + std::size_t(begin) * StorageChunkSize;
+                    Storage* last = ptr + std::min(std::size_t(end) * StorageChunkSize, std::size_t(count));
+
+                    if (isZero)
+                        std::memset(static_cast<void*>(first), 0, sizeof(Storage) * (last - first));
+                    else
+                        std::fill(first, last, element);
+                });
+            }
+
+            /**
+             * \brief Copies the given run of host storage.
+             */
+            template <typename Storage>
+            void copyStorage(const Storage* src, Storage* dst, uint count)
+            {
+                const uint chunkCount = (count + StorageChunkSize - 1) / StorageChunkSize;
+
+                HostExecutor::parallelFor(chunkCount, StorageChunkSize, [=](uint begin, uint end)
+                {
+                    const std::size_t first = std::size_t(begin) * StorageChunkSize;
+                    const std::size_t last = std::min(std::size_t(end) * StorageChunkSize, std::size_t(count));
+
+                    std::memcpy(dst + first, src + first, sizeof(Storage) * (last - first));
+                });
+            }
+
+            /**
+             * \brief Fills the whole storage of a host buffer, padding included, with the given
+             *        value. Planar buffers get each plane filled with its own component.
+             */
+            template <typename Buffer>
+            void fillBuffer(const Location::HostTag&, std::false_type, Buffer& buffer, const typename Buffer::Value& value)
+            {
+                fillStorage(buffer.getPtr(), buffer.getStorage(), Buffer::Conversion::store(value));
+            }
+
+            template <typename Buffer>
+            void fillBuffer(const Location::HostTag&, std::true_type, Buffer& buffer, const typename Buffer::Value& value)
+            {
+                const uint planeSize = buffer.getStorage() / Buffer::Components;
+
+                for (uint c = 0; c < Buffer::Components; ++c)
+                    fillStorage(buffer.getPtr() + c * planeSize, planeSize, Buffer::Conversion::store(value[c]));
+            }
+
+            #if HF_CPU_ONLY == false
+            template <typename IsPlanar, typename Buffer>
+            void fillBuffer(const Location::DeviceTag& location, IsPlanar, Buffer& buffer, const typename Buffer::Value& value)
+            {
+                Kernel::execute<Buffer::Order, FillKernel>(location, buffer.getDims(), CopyValueRegion<Buffer::Order>(buffer.getDims()), buffer.getAccessor(), value);
+            }
+            #endif
+
+            /**
+             * \brief Copies the whole storage of a host buffer into another one laid out the same
+             *        way, or falls back to the copy kernel otherwise.
+             */
+            template <typename Buffer>
+            void copyBuffer(const Location::HostTag&, std::true_type, const Buffer& src, Buffer& dst)
+            {
+                if (hasSameLayout(src, dst))
+                    copyStorage(src.getPtr(), dst.getPtr(), dst.getStorage());
+                else
+                    Kernel::execute<Buffer::Order, CopyKernel>(Location::Host, dst.getDims(), CopyValueRegion<Buffer::Order>(dst.getDims()), src.getConstAccessor(), dst.getAccessor());
+            }
+
+            template <typename LocationTag, typename IsSameLayout, typename SrcBuffer, typename DstBuffer>
+            void copyBuffer(const LocationTag& location, IsSameLayout, const SrcBuffer& src, DstBuffer& dst)
+            {
+                Kernel::execute<DstBuffer::Order, CopyKernel>(location, dst.getDims(), CopyValueRegion<DstBuffer::Order>(dst.getDims()), src.getConstAccessor(), dst.getAccessor());
+            }
+
+            //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
+
+            /**
+             * \brief Checks that the given region lies within the buffer.
+             */
+            template <typename Buffer>
+            void assertRegion(const Buffer& buffer, const CopyValueRegion<Buffer::Order>& region)
+            {
+                HF_ASSERT(all(greaterThanEqual(region.offset, IntN<Buffer::Order>(0))) && all(greaterThanEqual(buffer.getDims(), region.offset + region.size)),
+                    "The given region is outside of the bounds of the buffer.");
+            }
+
+            /**
+             * \brief Checks that both buffers can be operated on together.
+             */
+            template <typename SrcBuffer, typename DstBuffer>
+            void assertCompatible(const SrcBuffer& src, const DstBuffer& dst)
+            {
+                static_assert(std::is_same<typename SrcBuffer::Value, typename DstBuffer::Value>::value,
+                    "The data type of the given buffers mismatch.");
+
+                static_assert(std::is_same<typename SrcBuffer::LocationTag, typename DstBuffer::LocationTag>::value,
+                    "The given buffers are not stored at the same location.");
+
+                HF_ASSERT(src.getDims() == dst.getDims(),
+                    "Source and destination dimensions mismatch.");
+            }
+        }
+
+        //─────────────────────────────────────────────────────────────────────────────────────────
+
+        /**
+         * \brief Sets every value of the given region of the buffer to the given one.
+         * \param dst Destination buffer.
+         * \param value Value to set.
+         * \param region Region of the buffer to fill.
+         */
+        template <typename DstBufferRef>
+        void fill(DstBufferRef& dst, const typename DstBufferRef::element_type::Value& value, const CopyValueRegion<DstBufferRef::element_type::Order>& region)
+        {
+            using DstBuffer = typename DstBufferRef::element_type;
+
+            Detail::assertRegion(*dst, region);
+            Kernel::execute<DstBuffer::Order, Detail::FillKernel>(DstBuffer::Location, region.size, region, dst->getAccessor(), value);
+        }
+
+        /**
+         * \brief Sets every value of the buffer to the given one. Host buffers are filled through
+         *        their storage, which is memset when the value is stored as zeros.
+         * \param dst Destination buffer.
+         * \param value Value to set.
+         */
+        template <typename DstBufferRef>
+        void fill(DstBufferRef& dst, const typename DstBufferRef::element_type::Value& value)
+        {
+            using DstBuffer = typename DstBufferRef::element_type;
+            using IsPlanar = IsPlanarAccessor<typename DstBuffer::Accessor>;
+
+            Detail::fillBuffer(DstBuffer::Location, IsPlanar(), *dst, value);
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Copies the given region of a buffer into the same region of another one. Unlike
+         *        Copy::bufferToBuffer, both buffers must be stored at the same location.
+         * \param src Source buffer.
+         * \param dst Destination buffer.
+         * \param region Region to copy.
+         */
+        template <typename SrcBufferRef, typename DstBufferRef>
+        void copy(const SrcBufferRef& src, DstBufferRef& dst, const CopyValueRegion<DstBufferRef::element_type::Order>& region)
+        {
+            using DstBuffer = typename DstBufferRef::element_type;
+
+            Detail::assertCompatible(*src, *dst);
+            Detail::assertRegion(*dst, region);
+            Kernel::execute<DstBuffer::Order, Detail::CopyKernel>(DstBuffer::Location, region.size, region, src->getConstAccessor(), dst->getAccessor());
+        }
+
+        /**
+         * \brief Copies a buffer into another one. Host buffers laid out the same way are copied
+         *        through their storage.
+         * \param src Source buffer.
+         * \param dst Destination buffer.
+         */
+        template <typename SrcBufferRef, typename DstBufferRef>
+        void copy(const SrcBufferRef& src, DstBufferRef& dst)
+        {
+            using SrcBuffer = typename SrcBufferRef::element_type;
+            using DstBuffer = typename DstBufferRef::element_type;
+            using IsSameLayout = std::is_same<SrcBuffer, DstBuffer>;
+
+            Detail::assertCompatible(*src, *dst);
+            Detail::copyBuffer(DstBuffer::Location, IsSameLayout(), *src, *dst);
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Multiplies the values of the given region of the buffer, i.e. dst *= alpha.
+         * \param dst Destination buffer.
+         * \param alpha Factor, either a scalar or a value.
+         * \param region Region of the buffer to scale.
+         */
+        template <typename DstBufferRef, typename Alpha>
+        void scale(DstBufferRef& dst, const Alpha& alpha, const CopyValueRegion<DstBufferRef::element_type::Order>& region)
+        {
+            using DstBuffer = typename DstBufferRef::element_type;
+
+            Detail::assertRegion(*dst, region);
+            Kernel::execute<DstBuffer::Order, Detail::ScaleKernel>(DstBuffer::Location, region.size, region, dst->getAccessor(), alpha);
+        }
+
+        template <typename DstBufferRef, typename Alpha>
+        void scale(DstBufferRef& dst, const Alpha& alpha)
+        {
+            scale(dst, alpha, CopyValueRegion<DstBufferRef::element_type::Order>(dst->getDims()));
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Adds the values of a buffer, multiplied by a factor, to those of another one
+         *        within the given region, i.e. y += alpha * x.
+         * \param alpha Factor, either a scalar or a value.
+         * \param x Source buffer.
+         * \param y Destination buffer.
+         * \param region Region of the buffers to operate on.
+         */
+        template <typename Alpha, typename SrcBufferRef, typename DstBufferRef>
+        void axpy(const Alpha& alpha, const SrcBufferRef& x, DstBufferRef& y, const CopyValueRegion<DstBufferRef::element_type::Order>& region)
+        {
+            using DstBuffer = typename DstBufferRef::element_type;
+
+            Detail::assertCompatible(*x, *y);
+            Detail::assertRegion(*y, region);
+            Kernel::execute<DstBuffer::Order, Detail::AxpyKernel>(DstBuffer::Location, region.size, region, x->getConstAccessor(), y->getAccessor(), alpha);
+        }
+
+        template <typename Alpha, typename SrcBufferRef, typename DstBufferRef>
+        void axpy(const Alpha& alpha, const SrcBufferRef& x, DstBufferRef& y)
+        {
+            axpy(alpha, x, y, CopyValueRegion<DstBufferRef::element_type::Order>(y->getDims()));
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Moves the values of a buffer towards those of another one within the given
+         *        region, i.e. dst += (src - dst) * t.
+         * \param src Buffer to move towards.
+         * \param dst Destination buffer.
+         * \param t Weight of the source values, either a scalar or a value.
+         * \param region Region of the buffers to operate on.
+         */
+        template <typename SrcBufferRef, typename DstBufferRef, typename Weight>
+        void lerp(const SrcBufferRef& src, DstBufferRef& dst, const Weight& t, const CopyValueRegion<DstBufferRef::element_type::Order>& region)
+        {
+            using DstBuffer = typename DstBufferRef::element_type;
+
+            Detail::assertCompatible(*src, *dst);
+            Detail::assertRegion(*dst, region);
+            Kernel::execute<DstBuffer::Order, Detail::LerpKernel>(DstBuffer::Location, region.size, region, src->getConstAccessor(), dst->getAccessor(), t);
+        }
+
+        template <typename SrcBufferRef, typename DstBufferRef, typename Weight>
+        void lerp(const SrcBufferRef& src, DstBufferRef& dst, const Weight& t)
+        {
+            lerp(src, dst, t, CopyValueRegion<DstBufferRef::element_type::Order>(dst->getDims()));
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Clamps the values of the given region of the buffer to the given range.
+         * \param dst Destination buffer.
+         * \param minValue Lower bound of the range.
+         * \param maxValue Upper bound of the range.
+         * \param region Region of the buffer to clamp.
+         */
+        template <typename DstBufferRef>
+        void clamp(DstBufferRef& dst,
+                   const typename DstBufferRef::element_type::Value& minValue,
+                   const typename DstBufferRef::element_type::Value& maxValue,
+                   const CopyValueRegion<DstBufferRef::element_type::Order>& region)
+        {
+            using DstBuffer = typename DstBufferRef::element_type;
+
+            Detail::assertRegion(*dst, region);
+            Kernel::execute<DstBuffer::Order, Detail::ClampKernel>(DstBuffer::Location, region.size, region, dst->getAccessor(), minValue, maxValue);
+        }
+
+        template <typename DstBufferRef>
+        void clamp(DstBufferRef& dst, const typename DstBufferRef::element_type::Value& minValue, const typename DstBufferRef::element_type::Value& maxValue)
+        {
+            clamp(dst, minValue, maxValue, CopyValueRegion<DstBufferRef::element_type::Order>(dst->getDims()));
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Returns the largest magnitude of the values of a host buffer of scalars. Rows are
+         *        reduced separately on the host workers, and their results on the calling thread.
+         * \param src Source buffer.
+         * \return Largest magnitude, or zero for empty buffers.
+         */
+        template <typename SrcBufferRef>
+        typename SrcBufferRef::element_type::Value maxAbs(const SrcBufferRef& src)
+        {
+            using SrcBuffer = typename SrcBufferRef::element_type;
+            using Value = typename SrcBuffer::Value;
+            using Index = IntN<SrcBuffer::Order>;
+
+            static_assert(std::is_same<typename SrcBuffer::LocationTag, Location::HostTag>::value,
+                "Only host buffers can be reduced.");
+
+            static_assert(std::is_arithmetic<Value>::value,
+                "Only buffers of scalars can be reduced.");
+
+            const Index dims = src->getDims();
+
+            if (compMul(dims) == 0)
+                return Value(0);
+
+            const uint rowCount = uint(compMul(dims) / dims[0]);
+            const auto accessor = src->getConstAccessor();
+
+            std::vector<Value> rowMax(rowCount, Value(0));
+
+            HostExecutor::parallelFor(rowCount, uint(dims[0]), [&](uint begin, uint end)
+            {
+                for (uint row = begin; row < end; ++row)
+                {
+                    Index idx(0);
+                    uint rest = row;
+
+                    for (uint axis = 1; axis < SrcBuffer::Order; ++axis)
+                    {
+                        idx[axis] = int(rest % uint(dims[axis]));
+                        rest /= uint(dims[axis]);
+                    }
+
+                    Value result(0);
+
+                    for (idx[0] = 0; idx[0] < dims[0]; ++idx[0])
+                        result = std::max(result, Value(std::abs(accessor.getValue(idx))));
+
+                    rowMax[row] = result;
+                }
+            });
+
+            return *std::max_element(rowMax.begin(), rowMax.end());
+        }
+
+    }
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_BULK_OPS_HPP */
@@ -6,12 +6,15 @@
 #include <Simulator/Compute/KernelConfig.hpp>
 #include <Simulator/Compute/KernelParams.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
-#include <Simulator/Compute/Arrays/Array.hpp>
 #include <Simulator/Compute/Buffers/Buffer.hpp>
-#include <Simulator/Compute/Surfaces/Surface.hpp>
 #include <Simulator/Compute/CopyRegion.hpp>
 #include <Simulator/Compute/CopyValueRegion.hpp>
 
+#if HF_CPU_ONLY == false
+#include <Simulator/Compute/Arrays/Array.hpp>
+#include <Simulator/Compute/Surfaces/Surface.hpp>
+#endif
+
 HF_BEGIN_NAMESPACE(HF, Compute)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
@@ -32,9 +35,10 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             template <typename T>
             void copyMemory(const Location::HostTag&, const Location::HostTag&, const T* src, T* dst, uint count)
             {
-                HF_CUDA(Memcpy(dst, src, sizeof(T) * count, cudaMemcpyHostToHost));
+                std::memcpy(dst, src, sizeof(T) * count);
             }
 
+#if HF_CPU_ONLY == false
             /**
              * \brief Copies the given amount of elements from the source pointer to the destination.
              * \tparam T Data type of the source and destination pointer.
@@ -73,6 +77,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             {
                 HF_CUDA(Memcpy(dst, src, sizeof(T) * count, cudaMemcpyDeviceToDevice));
             }
+#endif
 
             /**
              * \brief Copies the given amount of elements from the source pointer to the destination.
@@ -101,8 +106,8 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             {
                 using Config = KernelConfig<KernelBlockDims::Inferred>;
 
-                using KernelThread    = KernelThread<Order>;
-                using CopyValueRegion = CopyValueRegion<Order>;
+                using KernelThread    = Compute::KernelThread<Order>;
+                using CopyValueRegion = Compute::CopyValueRegion<Order>;
                 
                 template <typename SrcValue, typename DstAccessor>
                 static HF_HDINLINE void kernel(KernelThread thread, CopyValueRegion region, SrcValue src, DstAccessor dst)
@@ -143,8 +148,8 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             {
                 using Config = KernelConfig<KernelBlockDims::Inferred>;
 
-                using KernelThread = KernelThread<Order>;
-                using CopyRegion   = CopyRegion<Order>;
+                using KernelThread = Compute::KernelThread<Order>;
+                using CopyRegion   = Compute::CopyRegion<Order>;
 
                 /**
                  * \brief The kernel itself. Transfers the given region from source to destination.
@@ -187,6 +192,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
             //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
 
+#if HF_CPU_ONLY == false
             /**
              * \brief Copies the contents of the given array subregion.
              * \tparam Order Order of the array.
@@ -207,6 +213,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                 
                 HF_CUDA(Memcpy3D(&params));
             }
+#endif
         }
 
         //─────────────────────────────────────────────────────────────────────────────────────────
@@ -231,7 +238,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             using DstBuffer = typename DstBufferRef::element_type;
             using SrcValue = typename SrcBuffer::Value;
             using DstValue = typename DstBuffer::Value;
-            using SrcIndexer = typename SrcBuffer::Indexer;
+            using DstStorage = typename DstBuffer::Storage;
             using DstIndexer = typename DstBuffer::Indexer;
             using SrcLocationTag = typename SrcBuffer::LocationTag;
             using DstLocationTag = typename DstBuffer::LocationTag;
@@ -262,12 +269,13 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             }
 
             // Otherwise, allocate intermediate buffers for transferring between the differring
-            // locations and copy.
+            // locations and copy. These are kept in the destination storage type, so values are
+            // converted before the transfer.
 
             else
             {
-                auto srcTemp = Buffer<SrcLocationTag, Order, SrcValue, DstIndexer>::Create(region.size);
-                auto dstTemp = Buffer<DstLocationTag, Order, DstValue, DstIndexer>::Create(region.size);
+                auto srcTemp = Buffer<SrcLocationTag, Order, SrcValue, DstIndexer, DstStorage>::Create(region.size);
+                auto dstTemp = Buffer<DstLocationTag, Order, DstValue, DstIndexer, DstStorage>::Create(region.size);
                 
                 const CopyRegion<Order> srcRegion(region.srcOffset, UintN<Order>(0), region.size);
                 const CopyRegion<Order> dstRegion(UintN<Order>(0), region.dstOffset, region.size);
@@ -276,10 +284,12 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                 Detail::copyMemory(srcLocation, dstLocation, srcTemp->getPtr(), dstTemp->getPtr(), srcTemp->getStorage());
                 Detail::copyRegion(dstLocation, dstRegion, dstTemp->getConstAccessor(), dst->getAccessor());
 
+#if HF_CPU_ONLY == false
                 if (HF_SYNCHRONIZE_AT_MEM_TRANSFER)
                 {
                     HF_CUDA(DeviceSynchronize());
                 }
+#endif
             }
         }
 
@@ -301,8 +311,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             using DstBuffer = typename DstBufferRef::element_type;
             using SrcValue = typename SrcBuffer::Value;
             using DstValue = typename DstBuffer::Value;
-            using SrcIndexer = typename SrcBuffer::Indexer;
-            using DstIndexer = typename DstBuffer::Indexer;
+            using DstStorage = typename DstBuffer::Storage;
             using SrcLocationTag = typename SrcBuffer::LocationTag;
             using DstLocationTag = typename DstBuffer::LocationTag;
             constexpr SrcLocationTag srcLocation = SrcBuffer::Location;
@@ -321,12 +330,16 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             HF_ASSERT(src->getDims() == dst->getDims(),
                 "Source and destination dimensions mismatch.");
 
-            // If both indexers are of the same type, directly copy whole buffer using cudaMemcpy.
+            // If both indexers and storage types are the same, and the storage is laid out the same
+            // way (e.g. rows are equally padded), directly copy whole buffer using cudaMemcpy.
 
-            if (std::is_same<SrcIndexer, DstIndexer>::value)
+            if (hasSameLayout(*src, *dst))
             {
+                // Storage types match here, the cast only lets other instantiations compile.
+
                 const auto count = src->getStorage();
-                Detail::copyMemory(srcLocation, dstLocation, src->getPtr(), dst->getPtr(), count);
+                const auto srcPtr = reinterpret_cast<const DstStorage*>(src->getPtr());
+                Detail::copyMemory(srcLocation, dstLocation, srcPtr, dst->getPtr(), count);
             }
 
             // Otherwise, fallback to the region-based method, which's able to handle this very case.
@@ -340,6 +353,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
         //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
 
+#if HF_CPU_ONLY == false
         /**
          * \brief Copies a subregion of the given buffer into the array. If the buffer is not located
          *        on the device, a temporary buffer will be generated to transfer the data to device,
@@ -634,6 +648,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             const CopyRegion<srcOrder> region(src->getDims());
             Detail::copyArrayRegion(src->getArray(), dst->getArray(), region);
         }
+#endif
 
         //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
 
@@ -703,6 +718,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
         //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
 
+#if HF_CPU_ONLY == false
         /**
          * \brief Copies (sets) the given value to the array.
          * \tparam SrcValue Type of the source value.
@@ -775,6 +791,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                 HF_CUDA(DeviceSynchronize());
             }
         }
+#endif
 
         //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
     }
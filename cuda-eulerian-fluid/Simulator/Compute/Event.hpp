@@ -0,0 +1,94 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_EVENT_HPP
+#define HF_SIMULATOR_COMPUTE_EVENT_HPP
+
+#include <Simulator/Simulator.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    class Stream;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Marker completed once every piece of work enqueued on a stream before it has
+     *        finished, mirroring CUDA events. Events can be waited on from any thread, or chained
+     *        into other streams through Stream::waitFor.
+     */
+    class Event
+    {
+    public:
+        using Ref = HF::Ref<Event>;
+
+    protected:
+        Event(bool complete)
+            : _complete(complete)
+        {
+        }
+
+    public:
+        /**
+         * \brief Returns whether the work preceding the event has finished.
+         */
+        bool isComplete() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _complete;
+        }
+
+        /**
+         * \brief Blocks the calling thread until the work preceding the event has finished. If
+         *        that work threw an exception, it is rethrown here.
+         */
+        void wait() const
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _completed.wait(lock, [this] { return _complete; });
+
+            if (_exception)
+                std::rethrow_exception(_exception);
+        }
+
+    private:
+        friend class Stream;
+
+        void complete(std::exception_ptr exception)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                _complete = true;
+                _exception = exception;
+            }
+
+            _completed.notify_all();
+        }
+
+    private:
+        mutable std::mutex              _mutex;
+        mutable std::condition_variable _completed;
+        bool                            _complete;
+        std::exception_ptr              _exception;
+
+    public:
+        /**
+         * \brief Creates a new event, already complete. Useful as the initial value of chains.
+         */
+        static Ref Create()
+        {
+            return Ref(new Event(true));
+        }
+
+    private:
+        static Ref CreatePending()
+        {
+            return Ref(new Event(false));
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_EVENT_HPP */
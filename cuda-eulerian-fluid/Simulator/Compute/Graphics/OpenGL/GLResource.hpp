@@ -20,7 +20,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
     {
     public:
         static constexpr GraphicsAPI API = GraphicsAPI::OpenGL;
-        using Ref = Ref<GraphicsResource>;
+        using Ref = HF::Ref<GraphicsResource>;
 
     public:
         GLuint getGLHandle() const
@@ -0,0 +1,220 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_HOST_EXECUTOR_HPP
+#define HF_SIMULATOR_COMPUTE_HOST_EXECUTOR_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Utility/Threading/ThreadPool.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Entry point to the worker pool backing every host kernel execution. The pool is
+     *        created on first use, with as many workers as hardware threads are available unless
+     *        the HF_HOST_WORKER_COUNT environment variable says otherwise.
+     *
+     *        On NUMA hosts, setting HF_HOST_NUMA to 1 (or calling setNumaPlacement) pins the
+     *        workers evenly across the nodes, in node order. Every launch hands the same share of
+     *        its blocks to the same worker, and host buffers are first-touched with that same
+     *        split, so each worker mostly processes memory local to its node.
+     */
+    class HostExecutor
+    {
+    public:
+        HostExecutor() = delete;
+
+    public:
+        /**
+         * \brief Returns the no. of threads taking part in each host kernel execution.
+         */
+        static uint getWorkerCount()
+        {
+            return getThreadPool().getWorkerCount();
+        }
+
+        /**
+         * \brief Changes the no. of threads taking part in each host kernel execution. Must not
+         *        be called while a kernel is being executed on the host.
+         * \param workerCount No. of worker threads, including the thread launching the kernels.
+         *                    A value of zero selects the no. of hardware threads.
+         */
+        static void setWorkerCount(uint workerCount)
+        {
+            ThreadPool& threadPool = getThreadPool();
+            workerCount = workerCount > 0 ? workerCount : getHardwareWorkerCount();
+
+            if (isNumaPlacementEnabled())
+                threadPool.setAffinity(getNumaAffinity(workerCount));
+
+            threadPool.setWorkerCount(workerCount);
+        }
+
+        /**
+         * \brief Returns whether workers are pinned to NUMA nodes, and host buffers placed
+         *        accordingly.
+         */
+        static bool isNumaPlacementEnabled()
+        {
+            return !getThreadPool().getAffinity().empty();
+        }
+
+        /**
+         * \brief Enables or disables the NUMA placement of host workers and buffers. Must not be
+         *        called while a kernel is being executed on the host. Buffers allocated while the
+         *        placement was disabled keep their pages where they are.
+         * \param enabled Whether to pin workers to NUMA nodes.
+         */
+        static void setNumaPlacement(bool enabled)
+        {
+            ThreadPool& threadPool = getThreadPool();
+            threadPool.setAffinity(enabled ? getNumaAffinity(threadPool.getWorkerCount()) : std::vector<uint>());
+        }
+
+        /**
+         * \brief Touches every page of the given block of host memory with the same split of
+         *        work across workers used by kernel launches, so that under NUMA placement the
+         *        pages of each slab of the block land on the node of the worker processing it.
+         *        The block is zero-filled. Does nothing when NUMA placement is disabled.
+         * \param ptr Pointer to the block.
+         * \param size Size of the block, in bytes.
+         */
+        static void firstTouch(void* ptr, std::size_t size)
+        {
+            ThreadPool& threadPool = getThreadPool();
+
+            if (threadPool.getAffinity().empty() || size == 0)
+                return;
+
+            const uint workerCount = threadPool.getWorkerCount();
+            char* bytes = static_cast<char*>(ptr);
+
+            threadPool.parallelFor(workerCount, 1u, [bytes, size, workerCount](uint begin, uint end)
+            {
+                const std::size_t first = size * begin / workerCount;
+                const std::size_t last = size * end / workerCount;
+
+                std::memset(bytes + first, 0, last - first);
+            });
+        }
+
+        /**
+         * \brief Executes the given function for every task index in [0, taskCount) on the
+         *        host worker pool, handing tasks to the workers one at a time.
+         * \tparam Function Type of the function to execute. Must be callable as func(uint).
+         * \param taskCount No. of tasks to execute.
+         * \param func Function to execute.
+         */
+        template <typename Function>
+        static void parallelFor(uint taskCount, Function&& func)
+        {
+            getThreadPool().parallelFor(taskCount, std::forward<Function>(func));
+        }
+
+        /**
+         * \brief Executes the given function over every task index in [0, taskCount) on the
+         *        host worker pool. Chunk sizes are picked from the total amount of work, and
+         *        launches too small to amortize waking up the workers run on the calling thread.
+         * \tparam Function Type of the function to execute. Must be callable as func(begin, end).
+         * \param taskCount No. of tasks to execute.
+         * \param taskSize No. of kernel threads executed per task.
+         * \param func Function to execute.
+         */
+        template <typename Function>
+        static void parallelFor(uint taskCount, uint taskSize, Function&& func)
+        {
+            const ulonglong threadCount = ulonglong(taskCount) * taskSize;
+
+            if (threadCount <= InlineThreadCount)
+            {
+                func(0u, taskCount);
+                return;
+            }
+
+            ThreadPool& threadPool = getThreadPool();
+            const uint grainSize = getGrainSize(taskCount, taskSize, threadPool.getWorkerCount());
+
+            threadPool.parallelFor(taskCount, grainSize, std::forward<Function>(func));
+        }
+
+    private:
+        /**
+         * \brief Max. no. of kernel threads in a launch that is executed inline.
+         */
+        static constexpr ulonglong InlineThreadCount = 16384;
+
+        /**
+         * \brief Min. no. of kernel threads handed to a worker at once.
+         */
+        static constexpr ulonglong MinChunkThreadCount = 4096;
+
+        /**
+         * \brief No. of chunks each worker should get on an evenly balanced launch. Leaves room
+         *        for stealing when some of the workers are slower than the rest.
+         */
+        static constexpr uint ChunksPerWorker = 8;
+
+        static uint getGrainSize(uint taskCount, uint taskSize, uint workerCount)
+        {
+            const ulonglong minGrainSize = (MinChunkThreadCount + taskSize - 1) / std::max(1u, taskSize);
+            const ulonglong balancedGrainSize = taskCount / (ulonglong(workerCount) * ChunksPerWorker);
+
+            return uint(std::max(1ull, std::max(minGrainSize, balancedGrainSize)));
+        }
+
+        static ThreadPool& getThreadPool()
+        {
+            static ThreadPool threadPool(getDefaultWorkerCount(), getDefaultAffinity());
+            return threadPool;
+        }
+
+        static std::vector<uint> getDefaultAffinity()
+        {
+            const char* numa = std::getenv("HF_HOST_NUMA");
+
+            if (numa == nullptr || std::atoi(numa) <= 0)
+                return std::vector<uint>();
+
+            return getNumaAffinity(getDefaultWorkerCount());
+        }
+
+        static std::vector<uint> getNumaAffinity(uint workerCount)
+        {
+            // Spread the workers evenly across the nodes, consecutive workers sharing a node, so
+            // that consecutive slabs of every launch are processed by the same node.
+
+            const uint nodeCount = NumaTopology::getNodeCount();
+            std::vector<uint> affinity(workerCount);
+
+            for (uint worker = 0; worker < workerCount; ++worker)
+            {
+                const uint node = uint(ulonglong(worker) * nodeCount / workerCount);
+                const uint firstWorker = uint((ulonglong(node) * workerCount + nodeCount - 1) / nodeCount);
+                const std::vector<uint>& cpus = NumaTopology::getNodeCpus(node);
+
+                affinity[worker] = cpus[(worker - firstWorker) % cpus.size()];
+            }
+
+            return affinity;
+        }
+
+        static uint getHardwareWorkerCount()
+        {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        static uint getDefaultWorkerCount()
+        {
+            const char* workerCount = std::getenv("HF_HOST_WORKER_COUNT");
+
+            if (workerCount != nullptr && std::atoi(workerCount) > 0)
+                return uint(std::atoi(workerCount));
+
+            return getHardwareWorkerCount();
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_HOST_EXECUTOR_HPP */
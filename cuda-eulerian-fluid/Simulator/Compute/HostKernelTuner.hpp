@@ -0,0 +1,389 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_HOST_KERNEL_TUNER_HPP
+#define HF_SIMULATOR_COMPUTE_HOST_KERNEL_TUNER_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/HostExecutor.hpp>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Measures the block dimensions of host kernel launches with inferred block dims.
+     *        While tuning is enabled, the first launches of every (kernel, order, grid dims)
+     *        combination cycle through a set of candidate block shapes and time them. Once every
+     *        candidate has been measured, the fastest one is used for the rest of the run and
+     *        stored in an on-disk cache, keyed by CPU model and worker count, so later runs
+     *        start tuned.
+     *
+     *        Tuning is enabled by setting the HF_HOST_TUNING environment variable to 1, or by
+     *        calling setEnabled. The cache path can be changed through HF_HOST_TUNING_CACHE.
+     */
+    class HostKernelTuner
+    {
+    public:
+        HostKernelTuner() = delete;
+
+    public:
+        /**
+         * \brief Returns whether host launches are being tuned.
+         */
+        static bool isEnabled()
+        {
+            return getState().enabled;
+        }
+
+        /**
+         * \brief Enables or disables tuning of host launches.
+         * \param enabled Whether to tune host launches.
+         */
+        static void setEnabled(bool enabled)
+        {
+            getState().enabled = enabled;
+        }
+
+        /**
+         * \brief Returns the path to the tuning cache.
+         */
+        static std::string getCachePath()
+        {
+            State& state = getState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            return state.cachePath;
+        }
+
+        /**
+         * \brief Changes the path to the tuning cache. Results measured so far are dropped, and
+         *        the new cache is loaded the next time it is needed.
+         * \param cachePath Path to the tuning cache.
+         */
+        static void setCachePath(const std::string& cachePath)
+        {
+            State& state = getState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            state.cachePath = cachePath;
+            state.cacheLoaded = false;
+            state.entries.clear();
+        }
+
+        /**
+         * \brief Returns the no. of timed launches started so far. Callers running launches
+         *        concurrently may compare it before and after a batch of launches to tell whether
+         *        any of them was timed, as those must run alone to be measured fairly.
+         */
+        static size_t getTrialCount()
+        {
+            State& state = getState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            return state.trialCount;
+        }
+
+        /**
+         * \brief Selects the block dimensions of the next host launch of the given kernel.
+         * \tparam Kernel Kernel to execute.
+         * \tparam Order Order (dimensions) of the kernel to execute.
+         * \param threadCount No. of threads to launch.
+         * \param defaultBlockDims Block dimensions used when no measurement is available.
+         * \param blockDims Selected block dimensions.
+         * \return Index of the candidate to measure, or -1 if the launch does not need to be timed.
+         */
+        template <typename Kernel, uint Order>
+        static int selectBlockDims(const IntN<Order>& threadCount, const IntN<Order>& defaultBlockDims, IntN<Order>& blockDims)
+        {
+            State& state = getState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            Entry& entry = getEntry<Kernel, Order>(state, threadCount, defaultBlockDims);
+
+            if (entry.tuned || entry.trialCount >= entry.candidates.size() * TrialsPerCandidate)
+            {
+                blockDims = fromInt3<Order>(entry.blockDims);
+                return -1;
+            }
+
+            const uint candidate = entry.trialCount++ % uint(entry.candidates.size());
+            state.trialCount++;
+
+            blockDims = fromInt3<Order>(entry.candidates[candidate]);
+
+            return int(candidate);
+        }
+
+        /**
+         * \brief Records the time taken by a host launch using the given candidate block dims.
+         * \tparam Kernel Executed kernel.
+         * \tparam Order Order (dimensions) of the executed kernel.
+         * \param threadCount No. of threads launched.
+         * \param candidate Index of the measured candidate, as returned by selectBlockDims.
+         * \param time Time taken by the launch, in milliseconds.
+         */
+        template <typename Kernel, uint Order>
+        static void recordTrial(const IntN<Order>& threadCount, int candidate, double time)
+        {
+            State& state = getState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            Entry& entry = state.entries[getKey<Kernel, Order>(state, threadCount)];
+
+            // The entry may have been reset by a change of cache path while the launch ran.
+
+            if (entry.tuned || size_t(candidate) >= entry.times.size())
+                return;
+
+            entry.times[candidate] = std::min(entry.times[candidate], time);
+
+            if (++entry.recordedCount < entry.candidates.size() * TrialsPerCandidate)
+                return;
+
+            // Every candidate has been measured, keep the fastest one.
+
+            const auto fastest = std::min_element(entry.times.begin(), entry.times.end());
+
+            entry.blockDims = entry.candidates[fastest - entry.times.begin()];
+            entry.tuned = true;
+
+            saveCache(state);
+        }
+
+    private:
+        /**
+         * \brief No. of times each candidate is measured. The fastest measurement is kept,
+         *        which filters out launches disturbed by page faults, other processes, etc.
+         */
+        static constexpr uint TrialsPerCandidate = 2;
+
+        struct Entry
+        {
+            std::vector<Int3>   candidates;
+            std::vector<double> times;
+            Int3                blockDims = Int3(1);
+            size_t              trialCount = 0;
+            size_t              recordedCount = 0;
+            bool                tuned = false;
+        };
+
+        struct State
+        {
+            State()
+                : cpuModel(getCpuModel())
+                , trialCount(0)
+                , cacheLoaded(false)
+            {
+                const char* enabledVar = std::getenv("HF_HOST_TUNING");
+                const char* cachePathVar = std::getenv("HF_HOST_TUNING_CACHE");
+
+                enabled = enabledVar != nullptr && std::atoi(enabledVar) > 0;
+                cachePath = cachePathVar != nullptr ? cachePathVar : "HostKernelTuning.cache";
+            }
+
+            std::mutex                   mutex;
+            std::map<std::string, Entry> entries;
+            std::string                  cachePath;
+            std::string                  cpuModel;
+            size_t                       trialCount;
+            bool                         cacheLoaded;
+            std::atomic<bool>            enabled;
+        };
+
+    private:
+        template <typename Kernel, uint Order>
+        static Entry& getEntry(State& state, const IntN<Order>& threadCount, const IntN<Order>& defaultBlockDims)
+        {
+            if (!state.cacheLoaded)
+                loadCache(state);
+
+            Entry& entry = state.entries[getKey<Kernel, Order>(state, threadCount)];
+
+            if (!entry.tuned && entry.candidates.empty())
+            {
+                entry.candidates = getCandidates<Order>(threadCount, defaultBlockDims);
+                entry.times.assign(entry.candidates.size(), std::numeric_limits<double>::infinity());
+                entry.blockDims = toInt3<Order>(defaultBlockDims);
+            }
+
+            return entry;
+        }
+
+        template <typename Kernel, uint Order>
+        static std::string getKey(const State& state, const IntN<Order>& threadCount)
+        {
+            std::ostringstream key;
+            key << state.cpuModel << '|' << HostExecutor::getWorkerCount() << '|' << typeid(Kernel).name() << '|' << Order << '|';
+
+            for (uint axis = 0; axis < Order; ++axis)
+                key << (axis > 0 ? "x" : "") << threadCount[axis];
+
+            return key.str();
+        }
+
+        template <uint Order>
+        static std::vector<Int3> getCandidates(const IntN<Order>& threadCount, const IntN<Order>& defaultBlockDims)
+        {
+            // Shapes favour long runs along X, which is the contiguous axis of host buffers.
+
+            const std::vector<Int3> shapes = Order == 1
+                ? std::vector<Int3> { Int3(256, 1, 1), Int3(512, 1, 1), Int3(2048, 1, 1), Int3(4096, 1, 1) }
+                : Order == 2
+                ? std::vector<Int3> { Int3(32, 8, 1), Int3(32, 16, 1), Int3(64, 16, 1), Int3(128, 8, 1), Int3(256, 4, 1) }
+                : std::vector<Int3> { Int3(32, 8, 4), Int3(32, 16, 2), Int3(64, 8, 2), Int3(64, 4, 4), Int3(8, 8, 8), Int3(128, 4, 2) };
+
+            // Always measure the static default, and fit the rest of the shapes to the grid.
+
+            std::vector<Int3> candidates { toInt3<Order>(defaultBlockDims) };
+
+            for (Int3 candidate : shapes)
+            {
+
+                for (uint axis = 0; axis < Order; ++axis)
+                    candidate[axis] = std::max(1, std::min(candidate[axis], threadCount[axis]));
+
+                if (std::find(candidates.begin(), candidates.end(), candidate) == candidates.end())
+                    candidates.push_back(candidate);
+            }
+
+            return candidates;
+        }
+
+        static void loadCache(State& state)
+        {
+            state.cacheLoaded = true;
+
+            std::ifstream file(state.cachePath);
+            std::string line;
+
+            while (std::getline(file, line))
+            {
+                const size_t separator = line.rfind('\t');
+
+                if (separator == std::string::npos)
+                    continue;
+
+                Entry entry;
+                std::istringstream dims(line.substr(separator + 1));
+
+                if (!(dims >> entry.blockDims.x >> entry.blockDims.y >> entry.blockDims.z))
+                    continue;
+
+                entry.tuned = true;
+                state.entries[line.substr(0, separator)] = entry;
+            }
+        }
+
+        static void saveCache(const State& state)
+        {
+            // Failing to write the cache only means the next run has to tune again, so errors
+            // are deliberately ignored.
+
+            std::ofstream file(state.cachePath, std::ios::trunc);
+
+            for (const auto& entry : state.entries)
+            {
+                if (!entry.second.tuned)
+                    continue;
+
+                const Int3& blockDims = entry.second.blockDims;
+                file << entry.first << '\t' << blockDims.x << ' ' << blockDims.y << ' ' << blockDims.z << '\n';
+            }
+        }
+
+        template <uint Order>
+        static Int3 toInt3(const IntN<Order>& dims)
+        {
+            Int3 result(1);
+
+            for (uint axis = 0; axis < Order; ++axis)
+                result[axis] = dims[axis];
+
+            return result;
+        }
+
+        template <uint Order>
+        static IntN<Order> fromInt3(const Int3& dims)
+        {
+            IntN<Order> result;
+
+            for (uint axis = 0; axis < Order; ++axis)
+                result[axis] = dims[axis];
+
+            return result;
+        }
+
+        static std::string getCpuModel()
+        {
+            std::string model;
+
+            #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int registers[4] = {};
+            __cpuid(registers, 0x80000000);
+
+            if (uint(registers[0]) >= 0x80000004u)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    __cpuid(registers, 0x80000002 + i);
+                    model.append(reinterpret_cast<const char*>(registers), 16);
+                }
+            }
+            #elif defined(__x86_64__) || defined(__i386__)
+            uint registers[4] = {};
+
+            if (__get_cpuid_max(0x80000000u, nullptr) >= 0x80000004u)
+            {
+                for (uint i = 0; i < 3; ++i)
+                {
+                    __get_cpuid(0x80000002u + i, &registers[0], &registers[1], &registers[2], &registers[3]);
+                    model.append(reinterpret_cast<const char*>(registers), 16);
+                }
+            }
+            #endif
+
+            // Fall back to the OS description of the processor (e.g. on ARM Linux).
+
+            if (model.find_first_not_of(std::string(" \0", 2)) == std::string::npos)
+            {
+                std::ifstream cpuInfo("/proc/cpuinfo");
+                std::string line;
+
+                while (std::getline(cpuInfo, line))
+                {
+                    if (line.compare(0, 10, "model name") == 0 || line.compare(0, 9, "Processor") == 0)
+                    {
+                        model = line.substr(line.find(':') + 1);
+                        break;
+                    }
+                }
+            }
+
+            // Normalize the name so it can be safely stored in the cache.
+
+            model.erase(std::remove(model.begin(), model.end(), '\0'), model.end());
+            std::replace(model.begin(), model.end(), '\t', ' ');
+            std::replace(model.begin(), model.end(), '|', ' ');
+
+            const size_t begin = model.find_first_not_of(' ');
+            const size_t end = model.find_last_not_of(' ');
+
+            return begin == std::string::npos ? "Unknown CPU" : model.substr(begin, end - begin + 1);
+        }
+
+        static State& getState()
+        {
+            static State state;
+            return state;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_HOST_KERNEL_TUNER_HPP */
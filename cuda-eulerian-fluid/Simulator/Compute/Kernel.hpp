@@ -3,9 +3,17 @@
 
 #include <Simulator/Simulator.hpp>
 #include <Simulator/Compute/Location.hpp>
+#include <Simulator/Compute/HostExecutor.hpp>
+#include <Simulator/Compute/HostKernelTuner.hpp>
+#include <Simulator/Compute/KernelArgs.hpp>
 #include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/KernelConfig.hpp>
 #include <Simulator/Compute/KernelParams.hpp>
+#include <Simulator/Compute/KernelProfiler.hpp>
+#include <Simulator/Compute/KernelRow.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
+#include <Simulator/Utility/Containers/FixedArray.hpp>
+#include <Simulator/Utility/Profiling/Stopwatch.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Compute)
 {
@@ -21,6 +29,8 @@ HF_BEGIN_NAMESPACE(HF, Compute)
 
             /**
              * \brief Executes the given 1D kernel on the host, emulating the CUDA kernel execution model.
+             *        Blocks are distributed across the host worker pool in chunks sized after the
+             *        launch, and small launches run inline on the calling thread.
              * \tparam Kernel Kernel to execute.
              * \tparam Args Type of the arguments to the kernel.
              * \param params Kernel execution parameters. Indicated no. of threads, blocks, and so on.
@@ -29,20 +39,31 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             template <typename Kernel, typename... Args>
             void hostKernel1(const KernelParams1& params, Args... args)
             {
-                // TODO: Use OMP for host-side parallelism.
-                for (int blockX = 0; blockX < params.blockCount[0]; blockX++)
-                for (int x = 0; x < params.blockDims[0]; ++x)
+                const uint blockCount = uint(params.blockCount[0]);
+                const uint blockSize = uint(params.blockDims[0]);
+
+                HostExecutor::parallelFor(blockCount, blockSize, [&](uint begin, uint end)
                 {
-                    Int1 localIndex(x);
-                    Int1 blockIndex(blockX);
+                    for (uint block = begin; block < end; ++block)
+                    {
+                        const int blockX = int(block);
 
-                    const KernelThread1 thread(localIndex, blockIndex, params.blockDims);
-                    Kernel::kernel(thread, args...);
-                }
+                        for (int x = 0; x < params.blockDims[0]; ++x)
+                        {
+                            Int1 localIndex(x);
+                            Int1 blockIndex(blockX);
+
+                            const KernelThread1 thread(localIndex, blockIndex, params.blockDims);
+                            Kernel::kernel(thread, args...);
+                        }
+                    }
+                });
             }
 
             /**
              * \brief Executes the given 2D kernel on the host, emulating the CUDA kernel execution model.
+             *        Blocks are distributed across the host worker pool in chunks sized after the
+             *        launch, and small launches run inline on the calling thread.
              * \tparam Kernel Kernel to execute.
              * \tparam Args Type of the arguments to the kernel.
              * \param params Kernel execution parameters. Indicated no. of threads, blocks, and so on.
@@ -51,22 +72,33 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             template <typename Kernel, typename... Args>
             void hostKernel2(const KernelParams2& params, Args... args)
             {
-                // TODO: Use OMP for host-side parallelism.
-                for (int blockY = 0; blockY < params.blockCount[1]; blockY++)
-                for (int blockX = 0; blockX < params.blockCount[0]; blockX++)
-                for (int y = 0; y < params.blockDims[1]; ++y)
-                for (int x = 0; x < params.blockDims[0]; ++x)
+                const uint blockCount = uint(compMul(params.blockCount));
+                const uint blockSize = uint(compMul(params.blockDims));
+
+                HostExecutor::parallelFor(blockCount, blockSize, [&](uint begin, uint end)
                 {
-                    Int2 localIndex(x, y);
-                    Int2 blockIndex(blockX, blockY);
-                    
-                    const KernelThread2 thread(localIndex, blockIndex, params.blockDims);
-                    Kernel::kernel(thread, args...);
-                }
+                    for (uint block = begin; block < end; ++block)
+                    {
+                        const int blockX = int(block) % params.blockCount[0];
+                        const int blockY = int(block) / params.blockCount[0];
+
+                        for (int y = 0; y < params.blockDims[1]; ++y)
+                        for (int x = 0; x < params.blockDims[0]; ++x)
+                        {
+                            Int2 localIndex(x, y);
+                            Int2 blockIndex(blockX, blockY);
+
+                            const KernelThread2 thread(localIndex, blockIndex, params.blockDims);
+                            Kernel::kernel(thread, args...);
+                        }
+                    }
+                });
             }
 
             /**
              * \brief Executes the given 3D kernel on the host, emulating the CUDA kernel execution model.
+             *        Blocks are distributed across the host worker pool in chunks sized after the
+             *        launch, and small launches run inline on the calling thread.
              * \tparam Kernel Kernel to execute.
              * \tparam Args Type of the arguments to the kernel.
              * \param params Kernel execution parameters. Indicated no. of threads, blocks, and so on.
@@ -75,24 +107,126 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             template <typename Kernel, typename... Args>
             void hostKernel3(const KernelParams3& params, Args... args)
             {
-                // TODO: Use OMP for host-side parallelism.
-                for (int blockZ = 0; blockZ < params.blockCount[2]; blockZ++)
-                for (int blockY = 0; blockY < params.blockCount[1]; blockY++)
-                for (int blockX = 0; blockX < params.blockCount[0]; blockX++)
-                for (int z = 0; z < params.blockDims[2]; ++z)
-                for (int y = 0; y < params.blockDims[1]; ++y)
-                for (int x = 0; x < params.blockDims[0]; ++x)
+                const uint blockCount = uint(compMul(params.blockCount));
+                const uint blockSize = uint(compMul(params.blockDims));
+
+                HostExecutor::parallelFor(blockCount, blockSize, [&](uint begin, uint end)
                 {
-                    Int3 localIndex(x, y, z);
-                    Int3 blockIndex(blockX, blockY, blockZ);
+                    for (uint block = begin; block < end; ++block)
+                    {
+                        const int blockX = int(block) % params.blockCount[0];
+                        const int blockY = int(block) / params.blockCount[0] % params.blockCount[1];
+                        const int blockZ = int(block) / params.blockCount[0] / params.blockCount[1];
+
+                        for (int z = 0; z < params.blockDims[2]; ++z)
+                        for (int y = 0; y < params.blockDims[1]; ++y)
+                        for (int x = 0; x < params.blockDims[0]; ++x)
+                        {
+                            Int3 localIndex(x, y, z);
+                            Int3 blockIndex(blockX, blockY, blockZ);
+
+                            const KernelThread3 thread(localIndex, blockIndex, params.blockDims);
+                            Kernel::kernel(thread, args...);
+                        }
+                    }
+                });
+            }
 
-                    const KernelThread3 thread(localIndex, blockIndex, params.blockDims);
-                    Kernel::kernel(thread, args...);
-                }
+            /**
+             * \brief Executes the given 2D or 3D kernel on the host through its kernelRow entry
+             *        point, once per row of threads along the X axis. Rows are distributed across
+             *        the host worker pool like blocks are on the per-thread path.
+             * \tparam Kernel Kernel to execute.
+             * \tparam Order Order (dimensions) of the kernel to execute.
+             * \tparam Args Type of the arguments to the kernel.
+             * \param params Kernel execution parameters. Indicated no. of threads, blocks, and so on.
+             * \param args Arguments to the kernel.
+             */
+            template <typename Kernel, uint Order, typename... Args>
+            void hostKernelRows(const KernelParams<Order>& params, Args... args)
+            {
+                const int rowLength = params.threadCount[0];
+
+                if (rowLength <= 0)
+                    return;
+
+                const uint rowCount = uint(compMul(params.threadCount) / rowLength);
+
+                HostExecutor::parallelFor(rowCount, uint(rowLength), [&](uint begin, uint end)
+                {
+                    for (uint row = begin; row < end; ++row)
+                    {
+                        IntN<Order> rowIndex(0);
+                        uint rowRemainder = row;
+
+                        for (uint axis = 1; axis < Order; ++axis)
+                        {
+                            rowIndex[axis] = int(rowRemainder % uint(params.threadCount[axis]));
+                            rowRemainder /= uint(params.threadCount[axis]);
+                        }
+
+                        Kernel::kernelRow(KernelRow<Order>(rowIndex, rowLength), args...);
+                    }
+                });
             }
 
             //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
 
+            /**
+             * \brief Determines whether a kernel argument can be walked row by row with plain
+             *        pointer arithmetic. Accessors expose it through IsRowContiguous, and any other
+             *        argument (domains, scalars, etc.) is considered row accessible.
+             */
+            template <typename Arg, typename = void>
+            struct IsRowAccessible : std::true_type
+            {
+            };
+
+            template <typename Arg>
+            struct IsRowAccessible<Arg, typename std::conditional<true, void, decltype(Arg::IsRowContiguous)>::type>
+                : std::integral_constant<bool, Arg::IsRowContiguous>
+            {
+            };
+
+            template <uint Length, typename Value>
+            struct IsRowAccessible<FixedArray<Length, Value>> : IsRowAccessible<Value>
+            {
+            };
+
+            template <typename... Args>
+            struct AreRowAccessible : std::true_type
+            {
+            };
+
+            template <typename Arg, typename... Args>
+            struct AreRowAccessible<Arg, Args...>
+                : std::integral_constant<bool, IsRowAccessible<Arg>::value && AreRowAccessible<Args...>::value>
+            {
+            };
+
+            /**
+             * \brief Determines whether the given kernel should be executed row by row on the host,
+             *        i.e. it implements a kernelRow entry point taking the supplied arguments and
+             *        every argument supports row access.
+             */
+            template <uint Order, typename Kernel, typename... Args>
+            struct UsesKernelRows
+            {
+            private:
+                template <typename K>
+                static auto test(int) -> decltype(K::kernelRow(std::declval<KernelRow<Order>>(), std::declval<Args>()...), std::true_type());
+
+                template <typename K>
+                static std::false_type test(...);
+
+            public:
+                static constexpr bool value = Order > 1 && decltype(test<Kernel>(0))::value && AreRowAccessible<Args...>::value;
+            };
+
+            //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
+
+            #if HF_CPU_ONLY == false
+
             /**
              * \brief Executes the given 1D kernel on the device.
              * \tparam Kernel Kernel to execute.
@@ -144,6 +278,8 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                 Kernel::kernel(thread, args...);
             }
 
+            #endif
+
             //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
 
             template <uint Order, typename Kernel, typename... Args>
@@ -154,13 +290,22 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             {
                 static void execute(const Location::HostTag&, const KernelParams1& params, Args... args)
                 {
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, false, false);
+                    #endif
+
                     hostKernel1<Kernel>(params, args...);
                 }
 
+                #if HF_CPU_ONLY == false
                 static void execute(const Location::DeviceTag&, const KernelParams1& params, Args... args)
                 {
                     using KernelCfg = typename Kernel::Config;
 
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, false, true);
+                    #endif
+
                     auto func = &deviceKernel1<Kernel, Args...>;
                     cudaFuncSetCacheConfig(func, static_cast<cudaFuncCache>(KernelCfg::CachePreference));
                     cudaFuncSetSharedMemConfig(func, static_cast<cudaSharedMemConfig>(KernelCfg::SharedBankSize));
@@ -175,6 +320,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                         HF_CUDA(GetLastError());
                     }
                 }
+                #endif
             };
 
             template <typename Kernel, typename ...Args>
@@ -182,13 +328,37 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             {
                 static void execute(const Location::HostTag&, const KernelParams2& params, Args... args)
                 {
+                    using UsesRows = std::integral_constant<bool, UsesKernelRows<2, Kernel, Args...>::value>;
+                    executeOnHost(UsesRows(), params, args...);
+                }
+
+                static void executeOnHost(std::false_type, const KernelParams2& params, Args... args)
+                {
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, false, false);
+                    #endif
+
                     hostKernel2<Kernel>(params, args...);
                 }
 
+                static void executeOnHost(std::true_type, const KernelParams2& params, Args... args)
+                {
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, true, false);
+                    #endif
+
+                    hostKernelRows<Kernel>(params, args...);
+                }
+
+                #if HF_CPU_ONLY == false
                 static void execute(const Location::DeviceTag&, const KernelParams2& params, Args... args)
                 {
                     using KernelCfg = typename Kernel::Config;
 
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, false, true);
+                    #endif
+
                     auto func = &deviceKernel2<Kernel, Args...>;
                     cudaFuncSetCacheConfig(func, static_cast<cudaFuncCache>(KernelCfg::CachePreference));
                     cudaFuncSetSharedMemConfig(func, static_cast<cudaSharedMemConfig>(KernelCfg::SharedBankSize));
@@ -203,6 +373,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                         HF_CUDA(GetLastError());
                     }
                 }
+                #endif
             };
 
             template <typename Kernel, typename ...Args>
@@ -210,13 +381,37 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             {
                 static void execute(const Location::HostTag&, const KernelParams3& params, Args... args)
                 {
+                    using UsesRows = std::integral_constant<bool, UsesKernelRows<3, Kernel, Args...>::value>;
+                    executeOnHost(UsesRows(), params, args...);
+                }
+
+                static void executeOnHost(std::false_type, const KernelParams3& params, Args... args)
+                {
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, false, false);
+                    #endif
+
                     hostKernel3<Kernel>(params, args...);
                 }
 
+                static void executeOnHost(std::true_type, const KernelParams3& params, Args... args)
+                {
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, true, false);
+                    #endif
+
+                    hostKernelRows<Kernel>(params, args...);
+                }
+
+                #if HF_CPU_ONLY == false
                 static void execute(const Location::DeviceTag&, const KernelParams3& params, Args... args)
                 {
                     using KernelCfg = typename Kernel::Config;
 
+                    #if HF_PROFILE_KERNELS == true
+                    const KernelProfiler::ScopedLaunch<Kernel> launch(params, false, true);
+                    #endif
+
                     auto func = &deviceKernel3<Kernel, Args...>;
                     cudaFuncSetCacheConfig(func, static_cast<cudaFuncCache>(KernelCfg::CachePreference));
                     cudaFuncSetSharedMemConfig(func, static_cast<cudaSharedMemConfig>(KernelCfg::SharedBankSize));
@@ -231,6 +426,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                         HF_CUDA(GetLastError());
                     }
                 }
+                #endif
             };
 
             //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
@@ -243,10 +439,10 @@ HF_BEGIN_NAMESPACE(HF, Compute)
              * \return Optimal block size.
              */
             template <typename Kernel>
-            Int1 inferBlockDimsOnHost(const Int1& threadCount)
+            Int1 inferBlockDimsOnHost(const Int1& /* threadCount */)
             {
-                // TODO: When implementing OMP, select block size depending on system capabilities
-                //       such as no. of threads, etc.
+                // Static default. Measured block sizes are picked by executeTunedOnHost instead
+                // when the HostKernelTuner is enabled.
                 return Int1(1024);
             }
 
@@ -258,10 +454,10 @@ HF_BEGIN_NAMESPACE(HF, Compute)
              * \return Optimal block size.
              */
             template <typename Kernel>
-            Int2 inferBlockDimsOnHost(const Int2& threadCount)
+            Int2 inferBlockDimsOnHost(const Int2& /* threadCount */)
             {
-                // TODO: When implementing OMP, select block size depending on system capabilities
-                //       such as no. of threads, etc.
+                // Static default. Measured block sizes are picked by executeTunedOnHost instead
+                // when the HostKernelTuner is enabled.
                 return Int2(32, 32);
             }
 
@@ -273,13 +469,15 @@ HF_BEGIN_NAMESPACE(HF, Compute)
              * \return Optimal block size.
              */
             template <typename Kernel>
-            Int3 inferBlockDimsOnHost(const Int3& threadCount)
+            Int3 inferBlockDimsOnHost(const Int3& /* threadCount */)
             {
-                // TODO: When implementing OMP, select block size depending on system capabilities
-                //       such as no. of threads, etc.
+                // Static default. Measured block sizes are picked by executeTunedOnHost instead
+                // when the HostKernelTuner is enabled.
                 return Int3(16, 16, 4);
             }
 
+            #if HF_CPU_ONLY == false
+
             /**
              * \brief Determines the optimal block size for the given 1D kernel according to the
              *        device capabilities and the kernel itself.
@@ -355,6 +553,8 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                 return Int3(blockSizeXY, blockSizeXY, blockSizeZ);
             }
 
+            #endif
+
             //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
 
             template <KernelBlockDims BlockDims, uint Order, typename Kernel, typename... Args>
@@ -369,11 +569,13 @@ HF_BEGIN_NAMESPACE(HF, Compute)
                     return KernelParams<Order>(threadCount, blockDims);
                 }
 
+                #if HF_CPU_ONLY == false
                 static KernelParams<Order> get(const Location::DeviceTag&, const IntN<Order>& threadCount)
                 {
                     const auto blockDims = inferBlockDimsOnDevice<Kernel, Args...>(threadCount);
                     return KernelParams<Order>(threadCount, blockDims);
                 }
+                #endif
             };
 
             template <uint Order, typename Kernel, typename... Args>
@@ -388,10 +590,46 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             };
 
             //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
+
+            /**
+             * \brief Executes the given kernel on the host with block dimensions measured by the
+             *        HostKernelTuner. Launches still being tuned are timed and reported back.
+             * \tparam Order Order (dimensions) of the kernel to execute.
+             * \tparam Kernel Kernel to execute.
+             * \tparam Args Type of the arguments to the kernel.
+             * \param threadCount No. of threads to launch.
+             * \param args Arguments to the kernel.
+             */
+            template <uint Order, typename Kernel, typename... Args>
+            void executeTunedOnHost(const IntN<Order>& threadCount, Args... args)
+            {
+                using Selector = KernelSelector<Order, Kernel, Args...>;
+
+                IntN<Order> blockDims;
+                const int candidate = HostKernelTuner::selectBlockDims<Kernel, Order>(threadCount, inferBlockDimsOnHost<Kernel>(threadCount), blockDims);
+                const KernelParams<Order> params(threadCount, blockDims);
+
+                if (candidate < 0)
+                {
+                    Selector::execute(Location::Host, params, args...);
+                    return;
+                }
+
+                Stopwatch stopwatch;
+                stopwatch.start();
+
+                Selector::execute(Location::Host, params, args...);
+
+                HostKernelTuner::recordTrial<Kernel, Order>(threadCount, candidate, stopwatch.end());
+            }
+
+            //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ─
         }
 
         //─────────────────────────────────────────────────────────────────────────────────────────
 
+        #if HF_CPU_ONLY == false
+
         /**
          * \brief Executes the given kernel at the desired location and with the supplied parameters.
          * \tparam Order Order (dimensions) of the kernel to execute.
@@ -434,6 +672,8 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             KernelSelector::execute(Location::Device, params, args...);
         }
 
+        #endif
+
         /**
          * \brief Executes the given kernel at the desired location and with the supplied parameters.
          * \tparam Order Order (dimensions) of the kernel to execute.
@@ -472,11 +712,214 @@ HF_BEGIN_NAMESPACE(HF, Compute)
             using KernelSelector = Detail::KernelSelector<Order, KernelType, Args...>;
             using KernelBlockDims = Detail::KernelBlockDimsSelector<KernelCfg::BlockDims, Order, KernelType, Args...>;
 
+            // Kernels executed row by row do not depend on the block dimensions, so only the
+            // per-thread ones are worth tuning.
+
+            const bool isTunable = KernelCfg::BlockDims == Compute::KernelBlockDims::Inferred
+                                && !Detail::UsesKernelRows<Order, KernelType, Args...>::value;
+
+            if (isTunable && HostKernelTuner::isEnabled())
+            {
+                Detail::executeTunedOnHost<Order, KernelType>(threadCount, args...);
+                return;
+            }
+
             const KernelParams params = KernelBlockDims::get(Location::Host, threadCount);
             KernelSelector::execute(Location::Host, params, args...);
         }
 
         //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Packs the arguments of one of the stages of a fused kernel.
+         * \tparam Args Type of the arguments.
+         * \param args Arguments to the stage.
+         * \return Packed arguments.
+         */
+        template <typename... Args>
+        KernelArgs<Args...> args(const Args&... args)
+        {
+            return KernelArgs<Args...>(args...);
+        }
+
+        /**
+         * \brief Composes a sequence of kernels into a single kernel, which runs every stage on
+         *        each thread (or row, on the host) before moving on to the next one. Intermediate
+         *        values written by a stage are then still in cache when the next one reads them.
+         *
+         *        Fusing is only valid when every stage reads the values written by the previous
+         *        stages at its own index: stencils over the output of a previous stage would see
+         *        a mix of old and new values.
+         * \tparam Stages Kernels to execute, in order. Each of them receives its own arguments
+         *                packed in a KernelArgs.
+         */
+        template <template <uint, typename> class... Stages>
+        struct Fused
+        {
+            template <uint Order, typename LocationTag>
+            struct Type
+            {
+                using Config = KernelConfig<KernelBlockDims::Inferred>;
+
+                using Thread = KernelThread<Order>;
+                using Row    = KernelRow<Order>;
+
+                template <typename... StageArgs>
+                static HF_HDINLINE void kernel(Thread thread, StageArgs... stageArgs)
+                {
+                    static_assert(sizeof...(Stages) == sizeof...(stageArgs), "Each of the stages must receive its own arguments.");
+
+                    const int expansion[] = { (stageArgs.apply(ThreadInvoker<Stages<Order, LocationTag>>(thread)), 0)... };
+                    (void)expansion;
+                }
+
+                template <typename... StageArgs>
+                static HF_HINLINE void kernelRow(Row row, StageArgs... stageArgs)
+                {
+                    static_assert(sizeof...(Stages) == sizeof...(stageArgs), "Each of the stages must receive its own arguments.");
+
+                    const int expansion[] = { (stageArgs.apply(RowInvoker<Stages<Order, LocationTag>>(row)), 0)... };
+                    (void)expansion;
+                }
+
+            private:
+                template <typename Stage>
+                struct ThreadInvoker
+                {
+                    HF_HDINLINE explicit ThreadInvoker(const Thread& thread)
+                        : thread(thread)
+                    {
+                    }
+
+                    template <typename... Args>
+                    HF_HDINLINE void operator()(const Args&... args) const
+                    {
+                        Stage::kernel(thread, args...);
+                    }
+
+                    const Thread thread;
+                };
+
+                template <typename Stage>
+                struct RowInvoker
+                {
+                    HF_HINLINE explicit RowInvoker(const Row& row)
+                        : row(row)
+                    {
+                    }
+
+                    template <typename... Args>
+                    HF_HINLINE void operator()(const Args&... args) const
+                    {
+                        using UsesRows = std::integral_constant<bool, Detail::UsesKernelRows<Order, Stage, Args...>::value>;
+                        invoke(UsesRows(), args...);
+                    }
+
+                    template <typename... Args>
+                    HF_HINLINE void invoke(std::true_type, const Args&... args) const
+                    {
+                        Stage::kernelRow(row, args...);
+                    }
+
+                    template <typename... Args>
+                    HF_HINLINE void invoke(std::false_type, const Args&... args) const
+                    {
+                        for (int x = 0; x < row.length; ++x)
+                            Stage::kernel(row.getThread(x), args...);
+                    }
+
+                    const Row row;
+                };
+            };
+        };
+
+        /**
+         * \brief Executes the given sequence of kernels as a single fused kernel (see Fused).
+         * \tparam Order Order (dimensions) of the kernels to execute.
+         * \tparam Stages Kernels to execute, in order.
+         * \tparam LocationTag Location where the kernels will be executed.
+         * \tparam StageArgs Type of the packed arguments of each stage.
+         * \param location Location where the kernels will be executed.
+         * \param threadCount No. of threads to launch. Shared by every stage.
+         * \param stageArgs Arguments of each of the stages, packed with args().
+         */
+        template <uint Order, template <uint, typename> class... Stages, typename LocationTag, typename... StageArgs>
+        void executeFused(const LocationTag& location, const IntN<Order>& threadCount, StageArgs... stageArgs)
+        {
+            execute<Order, Fused<Stages...>::template Type>(location, threadCount, stageArgs...);
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
+
+        /**
+         * \brief Executes the given kernel on the host over the given tiles alone, each of them
+         *        as a block of tileDims threads. Kernels over sparse buffers (see SparseBuffer)
+         *        are launched over their active tiles, skipping the rest of the domain. Tiles
+         *        crossing the end of the domain launch their threads past it too, so kernels
+         *        must keep checking their bounds.
+         * \tparam Order Order (dimensions) of the kernel to execute.
+         * \tparam Kernel Type of the kernel to execute.
+         * \tparam Args Type of the arguments supplied to the kernel.
+         * \param tiles Indices of the tiles to execute the kernel over.
+         * \param tileDims Dimensions of the tiles, in threads.
+         * \param args Arguments supplied to the kernel.
+         */
+        template <uint Order, template <uint, typename> class Kernel, typename... Args>
+        void executeOnTiles(const Location::HostTag&, const std::vector<IntN<Order>>& tiles, const IntN<Order>& tileDims, Args... args)
+        {
+            static_assert(Order >= 1 && Order <= 3, "Only 1D, 2D and 3D kernels may be executed.");
+
+            using KernelType = Kernel<Order, Location::HostTag>;
+
+            #if HF_PROFILE_KERNELS == true
+            IntN<Order> tileCount(1);
+            tileCount[0] = int(tiles.size());
+
+            const KernelProfiler::ScopedLaunch<KernelType> launch(KernelParams<Order>(tileDims * tileCount, tileDims), false, false);
+            #endif
+
+            const uint tileSize = uint(compMul(tileDims));
+
+            HostExecutor::parallelFor(uint(tiles.size()), tileSize, [&](uint begin, uint end)
+            {
+                for (uint tile = begin; tile < end; ++tile)
+                {
+                    for (uint i = 0; i < tileSize; ++i)
+                    {
+                        IntN<Order> localIndex;
+                        uint remainder = i;
+
+                        for (uint axis = 0; axis < Order; ++axis)
+                        {
+                            localIndex[axis] = int(remainder % uint(tileDims[axis]));
+                            remainder /= uint(tileDims[axis]);
+                        }
+
+                        const KernelThread<Order> thread(localIndex, tiles[tile], tileDims);
+                        KernelType::kernel(thread, args...);
+                    }
+                }
+            });
+        }
+
+        /**
+         * \brief Executes the given sequence of kernels as a single fused kernel (see Fused) over
+         *        the given tiles alone (see executeOnTiles).
+         * \tparam Order Order (dimensions) of the kernels to execute.
+         * \tparam Stages Kernels to execute, in order.
+         * \tparam StageArgs Type of the packed arguments of each stage.
+         * \param location Location where the kernels will be executed.
+         * \param tiles Indices of the tiles to execute the kernels over.
+         * \param tileDims Dimensions of the tiles, in threads.
+         * \param stageArgs Arguments of each of the stages, packed with args().
+         */
+        template <uint Order, template <uint, typename> class... Stages, typename... StageArgs>
+        void executeFusedOnTiles(const Location::HostTag& location, const std::vector<IntN<Order>>& tiles, const IntN<Order>& tileDims, StageArgs... stageArgs)
+        {
+            executeOnTiles<Order, Fused<Stages...>::template Type>(location, tiles, tileDims, stageArgs...);
+        }
+
+        //───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───   ───
     }
 }
 HF_END_NAMESPACE(HF, Compute)
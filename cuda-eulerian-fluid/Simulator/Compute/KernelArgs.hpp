@@ -0,0 +1,73 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_KERNEL_ARGS_HPP
+#define HF_SIMULATOR_COMPUTE_KERNEL_ARGS_HPP
+
+#include <Simulator/Simulator.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Minimal tuple holding the arguments of one of the stages of a fused kernel. Unlike
+     *        std::tuple, it can be passed to and unpacked within device code.
+     * \tparam Args Type of the arguments.
+     */
+    template <typename... Args>
+    struct KernelArgs;
+
+    template <>
+    struct KernelArgs<>
+    {
+    public:
+        /**
+         * \brief Calls the given function with the supplied leading arguments followed by the
+         *        stored ones.
+         * \tparam Function Type of the function to call.
+         * \tparam Leading Type of the leading arguments.
+         * \param func Function to call.
+         * \param leading Leading arguments.
+         */
+        template <typename Function, typename... Leading>
+        HF_HDINLINE void apply(const Function& func, const Leading&... leading) const
+        {
+            func(leading...);
+        }
+    };
+
+    template <typename Arg, typename... Args>
+    struct KernelArgs<Arg, Args...>
+    {
+    public:
+        KernelArgs() = default;
+
+        HF_HDINLINE KernelArgs(const Arg& head, const Args&... tail)
+            : head(head)
+            , tail(tail...)
+        {
+        }
+
+    public:
+        /**
+         * \brief Calls the given function with the supplied leading arguments followed by the
+         *        stored ones.
+         * \tparam Function Type of the function to call.
+         * \tparam Leading Type of the leading arguments.
+         * \param func Function to call.
+         * \param leading Leading arguments.
+         */
+        template <typename Function, typename... Leading>
+        HF_HDINLINE void apply(const Function& func, const Leading&... leading) const
+        {
+            tail.apply(func, leading..., head);
+        }
+
+    public:
+        Arg                 head;
+        KernelArgs<Args...> tail;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_KERNEL_ARGS_HPP */
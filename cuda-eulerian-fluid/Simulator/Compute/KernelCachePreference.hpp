@@ -12,22 +12,22 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         /**
          * \brief Default function cache configuration, no preference.
          */
-        None = cudaFuncCachePreferNone,
+        None = HF_CUDA_CONSTANT(cudaFuncCachePreferNone, 0),
 
         /**
          * \brief Prefer larger shared memory and smaller L1 cache.
          */
-        Shared = cudaFuncCachePreferShared,
+        Shared = HF_CUDA_CONSTANT(cudaFuncCachePreferShared, 1),
         
         /**
          * \brief Prefer larger L1 cache and smaller shared memory.
          */
-        L1 = cudaFuncCachePreferL1,
+        L1 = HF_CUDA_CONSTANT(cudaFuncCachePreferL1, 2),
 
         /**
          * \brief Prefer equal size L1 cache and shared memory.
          */
-        Equal = cudaFuncCachePreferEqual
+        Equal = HF_CUDA_CONSTANT(cudaFuncCachePreferEqual, 3)
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
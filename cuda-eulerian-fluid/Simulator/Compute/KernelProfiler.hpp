@@ -0,0 +1,325 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_KERNEL_PROFILER_HPP
+#define HF_SIMULATOR_COMPUTE_KERNEL_PROFILER_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/KernelParams.hpp>
+#include <Simulator/Utility/Profiling/Stopwatch.hpp>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Execution statistics of a kernel, launched from a given launch site.
+     */
+    struct KernelStats
+    {
+        /**
+         * \brief Name of the kernel type.
+         */
+        std::string kernel;
+
+        /**
+         * \brief Name of the launch site (see KernelProfiler::LaunchSite). Empty for launches
+         *        issued outside of any launch site.
+         */
+        std::string site;
+
+        /**
+         * \brief Order (dimensions) of the kernel.
+         */
+        uint order = 0;
+
+        /**
+         * \brief No. of launches.
+         */
+        ulonglong callCount = 0;
+
+        /**
+         * \brief Total, min. and max. wall time of the launches, in milliseconds.
+         */
+        double totalTime = 0.0;
+        double minTime = std::numeric_limits<double>::infinity();
+        double maxTime = 0.0;
+
+        /**
+         * \brief 99th percentile of the wall time of the most recent launches, in milliseconds.
+         */
+        double p99Time = 0.0;
+
+        /**
+         * \brief Total no. of threads launched, including those padding the last blocks.
+         */
+        ulonglong threadCount = 0;
+
+        /**
+         * \brief Total no. of threads requested, i.e. cells actually processed.
+         */
+        ulonglong cellCount = 0;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Registry of per-kernel execution statistics, filled by Kernel::execute when
+     *        HF_PROFILE_KERNELS is defined as true. Launches are grouped by kernel type and by
+     *        launch site, which is the innermost LaunchSite alive on the launching thread.
+     *
+     *        Device launches are synchronized while profiling, so that their wall time can
+     *        be measured.
+     */
+    class KernelProfiler
+    {
+    public:
+        KernelProfiler() = delete;
+
+    public:
+        /**
+         * \brief Labels every kernel launched by the current thread while alive.
+         */
+        class LaunchSite
+        {
+        public:
+            explicit LaunchSite(const char* name)
+                : _previous(getCurrentSite())
+            {
+                getCurrentSite() = name;
+            }
+
+            ~LaunchSite()
+            {
+                getCurrentSite() = _previous;
+            }
+
+            HF_COPY_IMPLEMENTATION(LaunchSite, delete)
+            HF_MOVE_IMPLEMENTATION(LaunchSite, delete)
+
+        private:
+            const char* _previous;
+        };
+
+        /**
+         * \brief Measures a single kernel launch while alive.
+         * \tparam Kernel Launched kernel.
+         */
+        template <typename Kernel>
+        class ScopedLaunch
+        {
+        public:
+            /**
+             * \brief Starts measuring a launch.
+             * \tparam Order Order (dimensions) of the kernel.
+             * \param params Kernel execution parameters.
+             * \param rowLaunch Whether the kernel is executed row by row, which launches exactly
+             *                  the requested no. of threads.
+             * \param synchronizeDevice Whether to wait for the device before taking the time.
+             */
+            template <uint Order>
+            ScopedLaunch(const KernelParams<Order>& params, bool rowLaunch, bool synchronizeDevice)
+                : _order(Order)
+                , _threadCount(1)
+                , _cellCount(1)
+                , _synchronizeDevice(synchronizeDevice)
+            {
+                for (uint axis = 0; axis < Order; ++axis)
+                {
+                    _cellCount *= ulonglong(params.threadCount[axis]);
+                    _threadCount *= ulonglong(params.blockCount[axis]) * ulonglong(params.blockDims[axis]);
+                }
+
+                if (rowLaunch)
+                    _threadCount = _cellCount;
+
+                _stopwatch.start();
+            }
+
+            ~ScopedLaunch()
+            {
+                #if HF_CPU_ONLY == false
+                if (_synchronizeDevice)
+                    cudaDeviceSynchronize();
+                #endif
+
+                record(typeid(Kernel), _order, _threadCount, _cellCount, _stopwatch.end());
+            }
+
+            HF_COPY_IMPLEMENTATION(ScopedLaunch, delete)
+            HF_MOVE_IMPLEMENTATION(ScopedLaunch, delete)
+
+        private:
+            Stopwatch _stopwatch;
+            uint      _order;
+            ulonglong _threadCount;
+            ulonglong _cellCount;
+            bool      _synchronizeDevice;
+        };
+
+    public:
+        /**
+         * \brief Returns the statistics gathered so far, sorted by decreasing total time.
+         */
+        static std::vector<KernelStats> getStats()
+        {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            std::vector<KernelStats> stats;
+            stats.reserve(registry.entries.size());
+
+            for (const auto& entry : registry.entries)
+            {
+                KernelStats entryStats = entry.second.stats;
+                entryStats.p99Time = getPercentile(entry.second.recentTimes, 0.99);
+                stats.push_back(entryStats);
+            }
+
+            std::sort(stats.begin(), stats.end(), [](const KernelStats& lhs, const KernelStats& rhs)
+            {
+                return lhs.totalTime > rhs.totalTime;
+            });
+
+            return stats;
+        }
+
+        /**
+         * \brief Discards the statistics gathered so far.
+         */
+        static void reset()
+        {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            registry.entries.clear();
+        }
+
+        /**
+         * \brief Writes a table with the statistics gathered so far to the given stream.
+         * \param stream Stream to write to.
+         */
+        static void report(std::ostream& stream)
+        {
+            stream << format("%-48s %-24s %8s %12s %10s %10s %10s %10s %8s\n",
+                             "Kernel", "Site", "Calls", "Total (ms)", "Min (ms)", "Max (ms)", "p99 (ms)", "Avg (ms)", "Useful");
+
+            for (const KernelStats& stats : getStats())
+            {
+                stream << format("%-48s %-24s %8llu %12.3f %10.3f %10.3f %10.3f %10.3f %7.1f%%\n",
+                                 stats.kernel.c_str(),
+                                 stats.site.c_str(),
+                                 stats.callCount,
+                                 stats.totalTime,
+                                 stats.minTime,
+                                 stats.maxTime,
+                                 stats.p99Time,
+                                 stats.totalTime / double(std::max(1ull, stats.callCount)),
+                                 100.0 * double(stats.cellCount) / double(std::max(1ull, stats.threadCount)));
+            }
+        }
+
+    private:
+        /**
+         * \brief No. of most recent launches the percentiles are computed from.
+         */
+        static constexpr size_t RecentTimeCount = 1024;
+
+        struct Entry
+        {
+            KernelStats         stats;
+            std::vector<double> recentTimes;
+            size_t              nextRecentTime = 0;
+        };
+
+        struct Registry
+        {
+            std::mutex                                               mutex;
+            std::map<std::pair<std::type_index, std::string>, Entry> entries;
+        };
+
+    private:
+        static void record(const std::type_info& kernel, uint order, ulonglong threadCount, ulonglong cellCount, double time)
+        {
+            const char* site = getCurrentSite();
+
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            Entry& entry = registry.entries[std::make_pair(std::type_index(kernel), std::string(site != nullptr ? site : ""))];
+            KernelStats& stats = entry.stats;
+
+            if (stats.callCount == 0)
+            {
+                stats.kernel = demangle(kernel.name());
+                stats.site = site != nullptr ? site : "";
+                stats.order = order;
+            }
+
+            stats.callCount++;
+            stats.totalTime += time;
+            stats.minTime = std::min(stats.minTime, time);
+            stats.maxTime = std::max(stats.maxTime, time);
+            stats.threadCount += threadCount;
+            stats.cellCount += cellCount;
+
+            // Keep a window of the most recent launch times for the percentiles.
+
+            if (entry.recentTimes.size() < RecentTimeCount)
+            {
+                entry.recentTimes.push_back(time);
+            }
+            else
+            {
+                entry.recentTimes[entry.nextRecentTime] = time;
+                entry.nextRecentTime = (entry.nextRecentTime + 1) % RecentTimeCount;
+            }
+        }
+
+        static double getPercentile(std::vector<double> times, double percentile)
+        {
+            if (times.empty())
+                return 0.0;
+
+            const size_t rank = size_t(std::ceil(percentile * double(times.size()))) - 1;
+            std::nth_element(times.begin(), times.begin() + rank, times.end());
+
+            return times[rank];
+        }
+
+        static std::string demangle(const char* name)
+        {
+            #if defined(__GNUG__)
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+            if (status == 0 && demangled != nullptr)
+            {
+                const std::string result(demangled);
+                std::free(demangled);
+                return result;
+            }
+            #endif
+
+            return name;
+        }
+
+        static const char*& getCurrentSite()
+        {
+            static thread_local const char* currentSite = nullptr;
+            return currentSite;
+        }
+
+        static Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_KERNEL_PROFILER_HPP */
@@ -0,0 +1,68 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_KERNEL_ROW_HPP
+#define HF_SIMULATOR_COMPUTE_KERNEL_ROW_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/KernelThread.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Structure describing a contiguous run of threads along the X axis, handed to the
+     *        optional kernelRow entry point of host kernels. Kernels implementing it process the
+     *        whole run in a single call, which lets the compiler vectorize the inner loop.
+     * \tparam Order Order (number of dimensions) of the kernel.
+     */
+    template <uint Order>
+    struct KernelRow
+    {
+    public:
+        using Index  = IntN<Order>;
+        using Thread = KernelThread<Order>;
+
+    public:
+        HF_HINLINE KernelRow(const Index& index, int length)
+            : index(index)
+            , length(length)
+        {
+        }
+
+    public:
+        /**
+         * \brief Returns the thread at the given offset within the row, so that kernels can fall
+         *        back to their per-thread entry point for cells needing special treatment.
+         * \param x Offset of the thread along the X axis, relative to the start of the row.
+         * \return Thread information.
+         */
+        HF_HINLINE Thread getThread(int x) const
+        {
+            Index threadIndex = index;
+            threadIndex[0] += x;
+
+            return Thread(threadIndex, Index(0), Index(1));
+        }
+
+    public:
+        /**
+         * \brief Index of the first thread of the row.
+         */
+        const Index index;
+
+        /**
+         * \brief No. of threads in the row.
+         */
+        const int length;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    using KernelRow1 = KernelRow<1>;
+    using KernelRow2 = KernelRow<2>;
+    using KernelRow3 = KernelRow<3>;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_KERNEL_ROW_HPP */
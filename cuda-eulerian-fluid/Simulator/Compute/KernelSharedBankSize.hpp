@@ -12,17 +12,17 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         /**
          * \brief Use default bank size.
          */
-        Default = cudaSharedMemBankSizeDefault,
+        Default = HF_CUDA_CONSTANT(cudaSharedMemBankSizeDefault, 0),
 
         /**
          * \brief Use banks of 4 bytes.
          */
-        FourBytes = cudaSharedMemBankSizeFourByte,
+        FourBytes = HF_CUDA_CONSTANT(cudaSharedMemBankSizeFourByte, 1),
 
         /**
          * \brief Use banks of 8 bytes.
          */
-        EightBytes = cudaSharedMemBankSizeEightByte
+        EightBytes = HF_CUDA_CONSTANT(cudaSharedMemBankSizeEightByte, 2)
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
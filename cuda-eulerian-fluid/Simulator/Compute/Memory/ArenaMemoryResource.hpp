@@ -0,0 +1,160 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_ARENA_MEMORY_RESOURCE_HPP
+#define HF_SIMULATOR_COMPUTE_ARENA_MEMORY_RESOURCE_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Memory/MemoryResource.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Memory resource handing out consecutive ranges of a single large block, typically
+     *        sized to hold every buffer of a simulation. Releasing a range does nothing: the
+     *        whole block is returned to the upstream resource once the arena is destroyed, i.e.
+     *        once every buffer allocated from it is gone.
+     *
+     *        Arenas created as zeroed acquire zero-filled blocks, so every range they hand out is
+     *        zero-filled for free. Requests exceeding the remaining capacity are served from
+     *        additional blocks.
+     */
+    class ArenaMemoryResource : public MemoryResource
+    {
+    public:
+        using Ref = HF::Ref<ArenaMemoryResource>;
+
+        /**
+         * \brief Alignment of the blocks acquired from the upstream resource, in bytes.
+         */
+        static constexpr std::size_t BlockAlignment = 4096;
+
+    private:
+        struct Block
+        {
+            char*       ptr;
+            std::size_t size;
+            std::size_t used;
+        };
+
+    protected:
+        ArenaMemoryResource(const MemoryResource::Ref& upstream, std::size_t capacity, bool zeroed)
+            : _upstream(upstream)
+            , _zeroed(zeroed)
+        {
+            HF_ASSERT(upstream != nullptr, "Unable to create a memory arena without an upstream resource.");
+
+            if (capacity > 0)
+                addBlock(capacity);
+        }
+
+    public:
+        ~ArenaMemoryResource()
+        {
+            for (const Block& block : _blocks)
+                _upstream->deallocate(block.ptr, block.size, BlockAlignment);
+        }
+
+    public:
+        /**
+         * \brief Returns the resource the arena acquires its blocks from.
+         */
+        const MemoryResource::Ref& getUpstream() const
+        {
+            return _upstream;
+        }
+
+        /**
+         * \brief Returns whether the ranges handed out by the arena are always zero-filled.
+         */
+        bool isZeroed() const
+        {
+            return _zeroed;
+        }
+
+        /**
+         * \brief Returns the total size of the blocks acquired by the arena, in bytes.
+         */
+        std::size_t getCapacity() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            std::size_t capacity = 0;
+
+            for (const Block& block : _blocks)
+                capacity += block.size;
+
+            return capacity;
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment, bool zeroed) override
+        {
+            HF_ASSERT(alignment <= BlockAlignment, format("Unable to align arena memory to %zu bytes.", alignment));
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            Block* block = _blocks.empty() ? nullptr : &_blocks.back();
+            std::size_t offset = block != nullptr ? alignUp(block->used, alignment) : 0;
+
+            if (block == nullptr || offset + size > block->size)
+            {
+                block = &addBlock(size);
+                offset = 0;
+            }
+
+            block->used = offset + size;
+
+            void* ptr = block->ptr + offset;
+
+            // Ranges are never handed out twice, so they are only dirty on non-zeroed arenas.
+
+            if (zeroed && !_zeroed)
+                std::memset(ptr, 0, size);
+
+            return ptr;
+        }
+
+        void deallocate(void*, std::size_t, std::size_t) override
+        {
+        }
+
+    private:
+        Block& addBlock(std::size_t size)
+        {
+            size = alignUp(size, BlockAlignment);
+
+            char* ptr = static_cast<char*>(_upstream->allocate(size, BlockAlignment, _zeroed));
+            _blocks.push_back({ ptr, size, 0 });
+
+            return _blocks.back();
+        }
+
+        static std::size_t alignUp(std::size_t value, std::size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+    private:
+        MemoryResource::Ref _upstream;
+        std::vector<Block>  _blocks;
+        bool                _zeroed;
+        mutable std::mutex  _mutex;
+
+    public:
+        /**
+         * \brief Creates a new arena on top of the given resource.
+         * \param upstream Resource to acquire blocks from.
+         * \param capacity Size of the first block, in bytes. Zero to defer it to the first
+         *                 allocation.
+         * \param zeroed Whether every range handed out must be zero-filled.
+         */
+        static Ref Create(const MemoryResource::Ref& upstream, std::size_t capacity, bool zeroed = true)
+        {
+            return Ref(new ArenaMemoryResource(upstream, capacity, zeroed));
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_ARENA_MEMORY_RESOURCE_HPP */
@@ -0,0 +1,68 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_DEVICE_MEMORY_RESOURCE_HPP
+#define HF_SIMULATOR_COMPUTE_DEVICE_MEMORY_RESOURCE_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Memory/MemoryResource.hpp>
+
+#if HF_CPU_ONLY == false
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Memory resource acquiring device memory straight from the CUDA runtime.
+     */
+    class DeviceMemoryResource : public MemoryResource
+    {
+    public:
+        using Ref = HF::Ref<DeviceMemoryResource>;
+
+    protected:
+        DeviceMemoryResource() = default;
+
+    public:
+        void* allocate(std::size_t size, std::size_t alignment, bool zeroed) override
+        {
+            // Device allocations are aligned to at least 256 bytes.
+
+            HF_ASSERT(alignment <= 256, format("Unable to align device memory to %zu bytes.", alignment));
+
+            void* ptr = nullptr;
+            HF_CUDA(Malloc(&ptr, size));
+
+            if (zeroed)
+                HF_CUDA(Memset(ptr, 0, size));
+
+            return ptr;
+        }
+
+        void deallocate(void* ptr, std::size_t size, std::size_t alignment) override
+        {
+            if (ptr != nullptr)
+                HF_IGNORE_THROW(HF_CUDA(Free(ptr)));
+        }
+
+        void zeroBlock(void* ptr, std::size_t size) override
+        {
+            HF_CUDA(Memset(ptr, 0, size));
+        }
+
+    public:
+        /**
+         * \brief Returns the shared device memory resource.
+         */
+        static Ref Get()
+        {
+            static const Ref resource(new DeviceMemoryResource());
+            return resource;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif
+
+#endif /* HF_SIMULATOR_COMPUTE_DEVICE_MEMORY_RESOURCE_HPP */
@@ -0,0 +1,259 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_HOST_MEMORY_RESOURCE_HPP
+#define HF_SIMULATOR_COMPUTE_HOST_MEMORY_RESOURCE_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/HostExecutor.hpp>
+#include <Simulator/Compute/Buffers/BufferFlags.hpp>
+#include <Simulator/Compute/Memory/MemoryResource.hpp>
+#include <Simulator/Utility/Memory/AlignedMemory.hpp>
+
+#if HF_CPU_ONLY == true && defined(__unix__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define HF_HOST_MEMORY_MAPPING true
+#else
+#define HF_HOST_MEMORY_MAPPING false
+#endif
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Memory resource acquiring host memory straight from the system. Page-locked when
+     *        CUDA is available, so transfers to the device do not require an intermediate copy.
+     *
+     *        Otherwise, large blocks are mapped from the OS on POSIX systems: their pages are
+     *        zero-filled and only backed once touched, so zeroed allocations are free, and
+     *        zeroing a whole block simply drops its pages. Under NUMA placement, blocks are
+     *        first-touched by the host workers (see HostExecutor::firstTouch).
+     *
+     *        The host allocation policies of BufferFlags (huge pages, prefaulting and access
+     *        hints) only apply to mapped blocks, and are ignored where unsupported.
+     */
+    class HostMemoryResource : public MemoryResource
+    {
+    public:
+        using Ref = HF::Ref<HostMemoryResource>;
+
+        /**
+         * \brief Min. size of the blocks mapped from the OS, in bytes.
+         */
+        static constexpr std::size_t MappingThreshold = 256 * 1024;
+
+        /**
+         * \brief Size of the huge pages requested by the huge page policies, in bytes.
+         */
+        static constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+
+    protected:
+        HostMemoryResource(BufferFlags flags)
+            : _flags(flags)
+        {
+        }
+
+    public:
+        /**
+         * \brief Returns the flags used for page-locked allocations.
+         */
+        BufferFlags getFlags() const
+        {
+            return _flags;
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment, bool zeroed) override
+        {
+            void* ptr = nullptr;
+
+            #if HF_CPU_ONLY == false
+            HF_CUDA(HostAlloc(&ptr, size, static_cast<unsigned>(_flags & BufferFlags::CudaMask)));
+
+            if (zeroed)
+                std::memset(ptr, 0, size);
+            #else
+            if (isMapped(size, alignment))
+            {
+                ptr = map(size);
+            }
+            else
+            {
+                ptr = alignedAlloc(size, alignment);
+
+                if (zeroed || hasFlags(_flags, BufferFlags::Prefault))
+                    std::memset(ptr, 0, size);
+            }
+
+            HostExecutor::firstTouch(ptr, size);
+            #endif
+
+            return ptr;
+        }
+
+        void deallocate(void* ptr, std::size_t size, std::size_t alignment) override
+        {
+            if (ptr == nullptr)
+                return;
+
+            #if HF_CPU_ONLY == false
+            HF_IGNORE_THROW(HF_CUDA(FreeHost(ptr)));
+            #else
+            if (isMapped(size, alignment))
+            {
+                #if HF_HOST_MEMORY_MAPPING == true
+                munmap(ptr, getMappingSize(size));
+                #endif
+            }
+            else
+            {
+                alignedFree(ptr);
+            }
+            #endif
+        }
+
+        void zeroBlock(void* ptr, std::size_t size) override
+        {
+            #if HF_HOST_MEMORY_MAPPING == true && defined(MADV_DONTNEED)
+            if (isMapped(size, 1))
+            {
+                // Private anonymous pages dropped this way read back as zero on next access. Old
+                // kernels refuse to drop explicit huge pages, though.
+
+                if (madvise(ptr, getMappingSize(size), MADV_DONTNEED) == 0)
+                {
+                    if (hasFlags(_flags, BufferFlags::Prefault) && !HostExecutor::isNumaPlacementEnabled())
+                        std::memset(ptr, 0, size);
+
+                    HostExecutor::firstTouch(ptr, size);
+                    return;
+                }
+            }
+            #endif
+
+            std::memset(ptr, 0, size);
+        }
+
+    private:
+        #if HF_HOST_MEMORY_MAPPING == true
+        void* map(std::size_t size) const
+        {
+            const std::size_t mappingSize = getMappingSize(size);
+
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+            // Under NUMA placement pages are prefaulted by the workers instead, from the right
+            // nodes (see HostExecutor::firstTouch).
+
+            #if defined(MAP_POPULATE)
+            if (hasFlags(_flags, BufferFlags::Prefault) && !HostExecutor::isNumaPlacementEnabled())
+                flags |= MAP_POPULATE;
+            #endif
+
+            void* ptr = MAP_FAILED;
+
+            #if defined(MAP_HUGETLB)
+            if (hasFlags(_flags, BufferFlags::ExplicitHugePages))
+                ptr = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+            #endif
+
+            if (ptr == MAP_FAILED)
+            {
+                const bool useHugePages = hasFlags(_flags, BufferFlags::HugePages) || hasFlags(_flags, BufferFlags::ExplicitHugePages);
+                ptr = useHugePages ? mapHugeAligned(mappingSize, flags) : mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+                HF_ASSERT(ptr != MAP_FAILED, format("Unable to map %zu bytes of host memory.", size));
+
+                #if defined(MADV_HUGEPAGE)
+                if (useHugePages)
+                    madvise(ptr, mappingSize, MADV_HUGEPAGE);
+                #endif
+            }
+
+            #if defined(MADV_SEQUENTIAL)
+            if (hasFlags(_flags, BufferFlags::Sequential))
+                madvise(ptr, mappingSize, MADV_SEQUENTIAL);
+            #endif
+
+            return ptr;
+        }
+
+        static void* mapHugeAligned(std::size_t size, int flags)
+        {
+            // Transparent huge pages can only back ranges aligned to the huge page size, so map
+            // a larger range and trim it down to an aligned one.
+
+            char* ptr = static_cast<char*>(mmap(nullptr, size + HugePageSize, PROT_READ | PROT_WRITE, flags, -1, 0));
+
+            if (ptr == MAP_FAILED)
+                return MAP_FAILED;
+
+            const std::size_t head = (HugePageSize - reinterpret_cast<std::uintptr_t>(ptr) % HugePageSize) % HugePageSize;
+
+            if (head > 0)
+                munmap(ptr, head);
+
+            munmap(ptr + head + size, HugePageSize - head);
+
+            return ptr + head;
+        }
+        #else
+        void* map(std::size_t size) const
+        {
+            return nullptr;
+        }
+        #endif
+
+        std::size_t getMappingSize(std::size_t size) const
+        {
+            // Mappings span whole pages, and explicit huge page ones whole huge pages.
+
+            const std::size_t pageSize = hasFlags(_flags, BufferFlags::ExplicitHugePages) ? HugePageSize : getPageSize();
+            return (size + pageSize - 1) / pageSize * pageSize;
+        }
+
+        static bool isMapped(std::size_t size, std::size_t alignment)
+        {
+            #if HF_HOST_MEMORY_MAPPING == true
+            return size >= MappingThreshold && alignment <= getPageSize();
+            #else
+            return false;
+            #endif
+        }
+
+        static std::size_t getPageSize()
+        {
+            #if HF_HOST_MEMORY_MAPPING == true
+            static const std::size_t pageSize = std::size_t(sysconf(_SC_PAGESIZE));
+            return pageSize;
+            #else
+            return 4096;
+            #endif
+        }
+
+    private:
+        BufferFlags _flags;
+
+    public:
+        /**
+         * \brief Returns the shared host memory resource for the given flags.
+         * \param flags Flags used for page-locked allocations.
+         */
+        static Ref Get(BufferFlags flags = BufferFlags::Default)
+        {
+            static std::mutex mutex;
+            static std::map<BufferFlags, Ref> resources;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            Ref& resource = resources[flags];
+
+            if (resource == nullptr)
+                resource = Ref(new HostMemoryResource(flags));
+
+            return resource;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_HOST_MEMORY_RESOURCE_HPP */
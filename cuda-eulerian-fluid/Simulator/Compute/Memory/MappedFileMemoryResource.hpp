@@ -0,0 +1,104 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_MAPPED_FILE_MEMORY_RESOURCE_HPP
+#define HF_SIMULATOR_COMPUTE_MAPPED_FILE_MEMORY_RESOURCE_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Memory/MemoryResource.hpp>
+#include <Simulator/Utility/Memory/MappedFile.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Memory resource owning a single block backed by a range of a mapped file, which
+     *        buffers loaded from that file use as their storage. The file stays mapped as long as
+     *        the resource is alive.
+     *
+     *        Any other request is forwarded to the upstream resource, so buffers created with the
+     *        parameters of a mapped one get regular storage.
+     */
+    class MappedFileMemoryResource : public MemoryResource
+    {
+    public:
+        using Ref = HF::Ref<MappedFileMemoryResource>;
+
+    protected:
+        MappedFileMemoryResource(const MappedFile::Ref& file, std::size_t offset, std::size_t size, const MemoryResource::Ref& upstream)
+            : _file(file)
+            , _offset(offset)
+            , _size(size)
+            , _upstream(upstream)
+        {
+            HF_ASSERT(file != nullptr && offset + size <= file->getSize(), "The given range is outside of the bounds of the file.");
+            HF_ASSERT(upstream != nullptr, "Unable to create a mapped file resource without an upstream resource.");
+        }
+
+    public:
+        /**
+         * \brief Returns the block backed by the file.
+         */
+        void* getBlock() const
+        {
+            return _file->getData() + _offset;
+        }
+
+        /**
+         * \brief Returns the size of the block backed by the file, in bytes.
+         */
+        std::size_t getBlockSize() const
+        {
+            return _size;
+        }
+
+        /**
+         * \brief Returns the resource other requests are forwarded to.
+         */
+        const MemoryResource::Ref& getUpstream() const
+        {
+            return _upstream;
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment, bool zeroed) override
+        {
+            return _upstream->allocate(size, alignment, zeroed);
+        }
+
+        void deallocate(void* ptr, std::size_t size, std::size_t alignment) override
+        {
+            if (ptr != getBlock())
+                _upstream->deallocate(ptr, size, alignment);
+        }
+
+        void zeroBlock(void* ptr, std::size_t size) override
+        {
+            if (ptr != getBlock())
+                _upstream->zeroBlock(ptr, size);
+            else
+                std::memset(ptr, 0, size);
+        }
+
+    private:
+        MappedFile::Ref     _file;
+        std::size_t         _offset;
+        std::size_t         _size;
+        MemoryResource::Ref _upstream;
+
+    public:
+        /**
+         * \brief Creates a new resource whose block is the given range of a mapped file.
+         * \param file Mapped file.
+         * \param offset Offset of the block within the file, in bytes.
+         * \param size Size of the block, in bytes.
+         * \param upstream Resource to forward other requests to.
+         */
+        static Ref Create(const MappedFile::Ref& file, std::size_t offset, std::size_t size, const MemoryResource::Ref& upstream)
+        {
+            return Ref(new MappedFileMemoryResource(file, offset, size, upstream));
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_MAPPED_FILE_MEMORY_RESOURCE_HPP */
@@ -0,0 +1,67 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_MEMORY_RESOURCE_HPP
+#define HF_SIMULATOR_COMPUTE_MEMORY_RESOURCE_HPP
+
+#include <Simulator/Simulator.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Source of the storage backing buffers. Resources may be stacked (e.g. an arena on
+     *        top of a pool on top of the system allocator), each layer forwarding the requests it
+     *        cannot serve to the one below, its upstream.
+     *
+     *        Every block must be released to the resource it was acquired from, with the same
+     *        size and alignment. Resources are kept alive by the buffers using them.
+     */
+    class MemoryResource
+    {
+    public:
+        using Ref = HF::Ref<MemoryResource>;
+
+    protected:
+        MemoryResource() = default;
+
+    public:
+        virtual ~MemoryResource() = default;
+
+        HF_COPY_IMPLEMENTATION(MemoryResource, delete)
+        HF_MOVE_IMPLEMENTATION(MemoryResource, delete)
+
+    public:
+        /**
+         * \brief Acquires a block of memory.
+         * \param size Size of the block, in bytes.
+         * \param alignment Alignment of the block, in bytes. Must be a power of two.
+         * \param zeroed Whether the block must be zero-filled.
+         * \return Pointer to the block.
+         */
+        virtual void* allocate(std::size_t size, std::size_t alignment, bool zeroed) = 0;
+
+        /**
+         * \brief Releases a block of memory acquired from this resource.
+         * \param ptr Pointer to the block. May be null.
+         * \param size Size of the block, in bytes, as requested on allocation.
+         * \param alignment Alignment of the block, in bytes, as requested on allocation.
+         */
+        virtual void deallocate(void* ptr, std::size_t size, std::size_t alignment) = 0;
+
+        /**
+         * \brief Zero-fills a whole block acquired from this resource, typically so that it can
+         *        be handed out again as zeroed. Resources able to do so replace the pages of the
+         *        block by fresh zero pages instead of writing to them.
+         * \param ptr Pointer to the block.
+         * \param size Size of the block, in bytes, as requested on allocation.
+         */
+        virtual void zeroBlock(void* ptr, std::size_t size)
+        {
+            std::memset(ptr, 0, size);
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_MEMORY_RESOURCE_HPP */
@@ -0,0 +1,193 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_POOLED_MEMORY_RESOURCE_HPP
+#define HF_SIMULATOR_COMPUTE_POOLED_MEMORY_RESOURCE_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Memory/HostMemoryResource.hpp>
+#include <Simulator/Compute/Memory/MemoryResource.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Memory resource keeping released blocks around for reuse, instead of returning
+     *        them to its upstream. Requests are rounded up to size classes (four per power of
+     *        two), so blocks can be reused by requests of slightly different sizes while
+     *        wasting at most a quarter of their size.
+     *
+     *        Cached blocks are only returned to the upstream on trim or destruction of the pool.
+     */
+    class PooledMemoryResource : public MemoryResource
+    {
+    public:
+        using Ref = HF::Ref<PooledMemoryResource>;
+
+        /**
+         * \brief Size of the smallest size class, in bytes.
+         */
+        static constexpr std::size_t MinBlockSize = 4096;
+
+    protected:
+        PooledMemoryResource(const MemoryResource::Ref& upstream)
+            : _upstream(upstream)
+            , _cachedSize(0)
+        {
+            HF_ASSERT(upstream != nullptr, "Unable to create a memory pool without an upstream resource.");
+        }
+
+    public:
+        ~PooledMemoryResource()
+        {
+            trim();
+        }
+
+    public:
+        /**
+         * \brief Returns the resource the pool acquires its blocks from.
+         */
+        const MemoryResource::Ref& getUpstream() const
+        {
+            return _upstream;
+        }
+
+        /**
+         * \brief Returns the total size of the blocks cached for reuse, in bytes.
+         */
+        std::size_t getCachedSize() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _cachedSize;
+        }
+
+        /**
+         * \brief Returns every cached block to the upstream resource.
+         */
+        void trim()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            for (auto& entry : _blocks)
+            {
+                for (void* ptr : entry.second)
+                    _upstream->deallocate(ptr, entry.first.size, entry.first.alignment);
+            }
+
+            _blocks.clear();
+            _cachedSize = 0;
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment, bool zeroed) override
+        {
+            const BlockClass blockClass = { getClassSize(size), alignment };
+            void* ptr = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                const auto it = _blocks.find(blockClass);
+
+                if (it != _blocks.end() && !it->second.empty())
+                {
+                    ptr = it->second.back();
+                    it->second.pop_back();
+                    _cachedSize -= blockClass.size;
+                }
+            }
+
+            if (ptr == nullptr)
+                return _upstream->allocate(blockClass.size, alignment, zeroed);
+
+            if (zeroed)
+                _upstream->zeroBlock(ptr, blockClass.size);
+
+            return ptr;
+        }
+
+        void deallocate(void* ptr, std::size_t size, std::size_t alignment) override
+        {
+            if (ptr == nullptr)
+                return;
+
+            const BlockClass blockClass = { getClassSize(size), alignment };
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _blocks[blockClass].push_back(ptr);
+            _cachedSize += blockClass.size;
+        }
+
+        void zeroBlock(void* ptr, std::size_t size) override
+        {
+            _upstream->zeroBlock(ptr, getClassSize(size));
+        }
+
+    private:
+        struct BlockClass
+        {
+            std::size_t size;
+            std::size_t alignment;
+
+            bool operator<(const BlockClass& other) const
+            {
+                return size != other.size ? size < other.size : alignment < other.alignment;
+            }
+        };
+
+    private:
+        static std::size_t getClassSize(std::size_t size)
+        {
+            if (size <= MinBlockSize)
+                return MinBlockSize;
+
+            // Round up to the next multiple of a quarter of the largest power of two not
+            // greater than the size.
+
+            std::size_t power = MinBlockSize;
+
+            while (power <= size / 2)
+                power *= 2;
+
+            const std::size_t step = power / 4;
+            return (size + step - 1) / step * step;
+        }
+
+    private:
+        MemoryResource::Ref                         _upstream;
+        std::map<BlockClass, std::vector<void*>>    _blocks;
+        std::size_t                                 _cachedSize;
+        mutable std::mutex                          _mutex;
+
+    public:
+        /**
+         * \brief Creates a new pool on top of the given resource.
+         * \param upstream Resource to acquire blocks from.
+         */
+        static Ref Create(const MemoryResource::Ref& upstream)
+        {
+            return Ref(new PooledMemoryResource(upstream));
+        }
+
+        /**
+         * \brief Returns the process-wide pool on top of the shared host memory resource for the
+         *        given flags.
+         * \param flags Flags of the host memory resource.
+         */
+        static Ref GetHostPool(BufferFlags flags = BufferFlags::Default)
+        {
+            static std::mutex mutex;
+            static std::map<BufferFlags, Ref> pools;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            Ref& pool = pools[flags];
+
+            if (pool == nullptr)
+                pool = Create(HostMemoryResource::Get(flags));
+
+            return pool;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_POOLED_MEMORY_RESOURCE_HPP */
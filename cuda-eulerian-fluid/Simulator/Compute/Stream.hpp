@@ -0,0 +1,234 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_STREAM_HPP
+#define HF_SIMULATOR_COMPUTE_STREAM_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Copy.hpp>
+#include <Simulator/Compute/Event.hpp>
+#include <Simulator/Compute/Kernel.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Queue of host work executed asynchronously, in submission order, mirroring CUDA
+     *        streams. Kernel launches, copies and any other function can be enqueued, each of
+     *        them returning an event completed once it (and everything before it) has finished.
+     *
+     *        Work is executed by a thread owned by the stream, which shares the host worker pool
+     *        with every other launch, so host kernels enqueued on a stream still run in parallel.
+     *        Every argument is captured by value. Kernels receive accessors, which do not keep
+     *        their buffers alive: callers must keep those buffers alive until the returned event
+     *        has completed (or the stream has been synchronized). Copies take the buffer
+     *        references themselves, which keep the buffers alive until the copy is done. Either
+     *        way, the caller is responsible for not touching the buffers meanwhile.
+     */
+    class Stream
+    {
+    public:
+        using Ref      = HF::Ref<Stream>;
+        using Function = std::function<void()>;
+
+    private:
+        struct Work
+        {
+            Function   function;
+            Event::Ref event;
+        };
+
+    protected:
+        Stream()
+            : _stopping(false)
+        {
+            _thread = std::thread(&Stream::threadMain, this);
+        }
+
+    public:
+        ~Stream()
+        {
+            // Pending work is finished, not discarded, as callers may still be waiting on it.
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+
+            _wakeUp.notify_all();
+            _thread.join();
+        }
+
+        HF_COPY_IMPLEMENTATION(Stream, delete)
+        HF_MOVE_IMPLEMENTATION(Stream, delete)
+
+    public:
+        /**
+         * \brief Enqueues the given function.
+         * \param function Function to execute.
+         * \return Event completed once the function has returned. Exceptions thrown by the
+         *         function are rethrown by Event::wait.
+         */
+        Event::Ref enqueue(Function function)
+        {
+            Event::Ref event = Event::CreatePending();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _queue.push_back({ std::move(function), event });
+            }
+
+            _wakeUp.notify_one();
+
+            return event;
+        }
+
+        /**
+         * \brief Enqueues the execution of the given kernel on the host.
+         * \tparam Order Order (dimensions) of the kernel to execute.
+         * \tparam Kernel Type of the kernel to execute.
+         * \tparam Args Type of the arguments supplied to the kernel.
+         * \param threadCount No. of threads to launch.
+         * \param args Arguments supplied to the kernel.
+         * \return Event completed once the kernel has finished.
+         */
+        template <uint Order, template <uint, typename> class Kernel, typename... Args>
+        Event::Ref execute(const IntN<Order>& threadCount, Args... args)
+        {
+            return enqueue([threadCount, args...]
+            {
+                Compute::Kernel::execute<Order, Kernel>(Location::Host, threadCount, args...);
+            });
+        }
+
+        /**
+         * \brief Enqueues a copy of a subregion of the given buffers (see
+         *        Copy::bufferToBuffer). The buffers are kept alive until the copy is done.
+         * \tparam SrcBufferRef Type of the source buffer.
+         * \tparam DstBufferRef Type of the destination buffer.
+         * \tparam Order Order (dimensions) of the buffers.
+         * \param src Source buffer.
+         * \param dst Destination buffer.
+         * \param region Subregion of the buffers that will be copied.
+         * \return Event completed once the copy has finished.
+         */
+        template <typename SrcBufferRef, typename DstBufferRef, uint Order>
+        Event::Ref copy(const SrcBufferRef& src, const DstBufferRef& dst, const CopyRegion<Order>& region)
+        {
+            return enqueue([src, dst, region]() mutable
+            {
+                Copy::bufferToBuffer(src, dst, region);
+            });
+        }
+
+        /**
+         * \brief Enqueues a copy of the contents of the given buffers (see
+         *        Copy::bufferToBuffer). The buffers are kept alive until the copy is done.
+         * \tparam SrcBufferRef Type of the source buffer.
+         * \tparam DstBufferRef Type of the destination buffer.
+         * \param src Source buffer.
+         * \param dst Destination buffer.
+         * \return Event completed once the copy has finished.
+         */
+        template <typename SrcBufferRef, typename DstBufferRef>
+        Event::Ref copy(const SrcBufferRef& src, const DstBufferRef& dst)
+        {
+            return enqueue([src, dst]() mutable
+            {
+                Copy::bufferToBuffer(src, dst);
+            });
+        }
+
+        /**
+         * \brief Makes every piece of work enqueued from now on wait for the given event, which
+         *        may belong to another stream.
+         * \param event Event to wait for.
+         */
+        void waitFor(const Event::Ref& event)
+        {
+            HF_ASSERT(event != nullptr, "Unable to wait for a null event.");
+
+            enqueue([event]
+            {
+                event->wait();
+            });
+        }
+
+        /**
+         * \brief Records an event, completed once every piece of work enqueued so far has
+         *        finished.
+         * \return Recorded event.
+         */
+        Event::Ref record()
+        {
+            return enqueue([] {});
+        }
+
+        /**
+         * \brief Blocks the calling thread until every piece of work enqueued so far has
+         *        finished. Exceptions thrown by that work are not rethrown; wait on the events
+         *        returned at submission to observe them.
+         */
+        void synchronize()
+        {
+            record()->wait();
+        }
+
+    private:
+        void threadMain()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (true)
+            {
+                _wakeUp.wait(lock, [this] { return _stopping || !_queue.empty(); });
+
+                if (_queue.empty())
+                    return;
+
+                Work work = std::move(_queue.front());
+                _queue.pop_front();
+
+                lock.unlock();
+
+                std::exception_ptr exception;
+
+                try
+                {
+                    work.function();
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+
+                // Release whatever the function captured before signaling, so that waiting on
+                // an event also means the resources of the work have been released.
+
+                work.function = nullptr;
+                work.event->complete(exception);
+
+                lock.lock();
+            }
+        }
+
+    private:
+        std::thread             _thread;
+        std::deque<Work>        _queue;
+        std::mutex              _mutex;
+        std::condition_variable _wakeUp;
+        bool                    _stopping;
+
+    public:
+        /**
+         * \brief Creates a new stream executing its work on the host.
+         */
+        static Ref Create()
+        {
+            return Ref(new Stream());
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_STREAM_HPP */
@@ -21,7 +21,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         using LocationTag = Location::DeviceTag;
         static constexpr LocationTag Location = Location::Device;
 
-        using Ref           = Ref<Surface>;
+        using Ref           = HF::Ref<Surface>;
         using Value         = _Value;
         using BuiltInValue  = typename Traits<Value>::BuiltInType;
         using Dims          = IntN<Order>;
@@ -0,0 +1,233 @@
+﻿#ifndef HF_SIMULATOR_COMPUTE_TASK_GRAPH_HPP
+#define HF_SIMULATOR_COMPUTE_TASK_GRAPH_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/HostExecutor.hpp>
+#include <Simulator/Compute/HostKernelTuner.hpp>
+#include <Simulator/Compute/KernelProfiler.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Compute)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Dependency graph of tasks (typically kernel launches), recorded once and replayed
+     *        as many times as needed. Every task declares the resources it reads and writes, and
+     *        is made to depend on every previous task it conflicts with (read after write, write
+     *        after read and write after write). Tasks are grouped into levels while recording,
+     *        so that replaying the graph has no planning cost: levels are executed in order, and
+     *        the tasks within a level are executed concurrently on the host worker pool.
+     *
+     *        While the HostKernelTuner is enabled, the graph is replayed one task at a time until
+     *        a replay no longer times any launch, so that candidate block dims are not measured
+     *        while competing with other tasks for the workers.
+     */
+    class TaskGraph
+    {
+    public:
+        using Ref      = HF::Ref<TaskGraph>;
+        using Resource = uint;
+        using Function = std::function<void()>;
+
+    private:
+        struct Task
+        {
+            std::string name;
+            Function    function;
+            uint        level;
+        };
+
+        struct ResourceState
+        {
+            int  lastWriter = -1;
+            uint readLevel  = 0;
+        };
+
+    protected:
+        TaskGraph(bool concurrent)
+            : _concurrent(concurrent)
+            , _tuned(false)
+        {
+        }
+
+    public:
+        /**
+         * \brief Returns whether tasks within the same level are executed concurrently.
+         */
+        bool isConcurrent() const
+        {
+            return _concurrent;
+        }
+
+        /**
+         * \brief Returns the no. of recorded tasks.
+         */
+        uint getTaskCount() const
+        {
+            return uint(_tasks.size());
+        }
+
+        /**
+         * \brief Returns the no. of levels the recorded tasks have been grouped into.
+         */
+        uint getLevelCount() const
+        {
+            return uint(_levels.size());
+        }
+
+        /**
+         * \brief Returns the name of the given task.
+         */
+        const std::string& getTaskName(uint task) const
+        {
+            return _tasks[task].name;
+        }
+
+        /**
+         * \brief Returns the level the given task has been scheduled at.
+         */
+        uint getTaskLevel(uint task) const
+        {
+            return _tasks[task].level;
+        }
+
+        /**
+         * \brief Records a new task at the end of the graph.
+         * \param name Name of the task, for debugging purposes.
+         * \param reads Resources read by the task.
+         * \param writes Resources written by the task.
+         * \param function Function executing the task.
+         * \return Index of the new task.
+         */
+        uint addTask(const std::string& name,
+                     std::initializer_list<Resource> reads,
+                     std::initializer_list<Resource> writes,
+                     Function function)
+        {
+            // The task must run after the last writer of everything it touches, and after every
+            // reader of the resources it overwrites.
+
+            uint level = 0;
+
+            for (const Resource resource : reads)
+            {
+                const ResourceState& state = _resources[resource];
+
+                if (state.lastWriter >= 0)
+                    level = std::max(level, _tasks[state.lastWriter].level + 1);
+            }
+
+            for (const Resource resource : writes)
+            {
+                const ResourceState& state = _resources[resource];
+
+                if (state.lastWriter >= 0)
+                    level = std::max(level, _tasks[state.lastWriter].level + 1);
+
+                level = std::max(level, state.readLevel);
+            }
+
+            const uint task = uint(_tasks.size());
+            _tasks.push_back({ name, std::move(function), level });
+
+            // Update the state of the resources.
+
+            for (const Resource resource : reads)
+            {
+                ResourceState& state = _resources[resource];
+                state.readLevel = std::max(state.readLevel, level + 1);
+            }
+
+            for (const Resource resource : writes)
+            {
+                ResourceState& state = _resources[resource];
+                state.lastWriter = int(task);
+                state.readLevel = level + 1;
+            }
+
+            if (level >= _levels.size())
+                _levels.resize(level + 1);
+
+            _levels[level].push_back(task);
+            _tuned = false;
+
+            return task;
+        }
+
+        /**
+         * \brief Executes every recorded task, honoring their dependencies. Returns once all of
+         *        them have finished. Exceptions thrown by the tasks are rethrown on the caller.
+         */
+        void execute() const
+        {
+            const bool tuning = _concurrent && !_tuned && HostKernelTuner::isEnabled();
+            const size_t trialCount = tuning ? HostKernelTuner::getTrialCount() : 0;
+
+            for (const auto& level : _levels)
+            {
+                if (!_concurrent || tuning || level.size() == 1)
+                {
+                    for (const uint task : level)
+                        executeTask(_tasks[task]);
+                }
+                else
+                {
+                    HostExecutor::parallelFor(uint(level.size()), [this, &level](uint i)
+                    {
+                        executeTask(_tasks[level[i]]);
+                    });
+                }
+            }
+
+            if (tuning)
+                _tuned = HostKernelTuner::getTrialCount() == trialCount;
+        }
+
+        /**
+         * \brief Removes every recorded task.
+         */
+        void clear()
+        {
+            _tasks.clear();
+            _levels.clear();
+            _resources.clear();
+            _tuned = false;
+        }
+
+    private:
+        static void executeTask(const Task& task)
+        {
+            // Kernels launched by the task are reported under its name.
+
+            #if HF_PROFILE_KERNELS == true
+            const KernelProfiler::LaunchSite site(task.name.c_str());
+            #endif
+
+            task.function();
+        }
+
+    private:
+        bool                                        _concurrent;
+        mutable bool                                _tuned;
+        std::vector<Task>                           _tasks;
+        std::vector<std::vector<uint>>              _levels;
+        std::unordered_map<Resource, ResourceState> _resources;
+
+    public:
+        /**
+         * \brief Creates a new, empty, task graph.
+         * \param concurrent Whether tasks within the same level may be executed concurrently.
+         *                   Should be disabled for graphs launching device work, which is
+         *                   serialized by the device anyway.
+         */
+        static Ref Create(bool concurrent = true)
+        {
+            return Ref(new TaskGraph(concurrent));
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Compute)
+
+#endif /* HF_SIMULATOR_COMPUTE_TASK_GRAPH_HPP */
@@ -24,7 +24,7 @@ HF_BEGIN_NAMESPACE(HF, Compute)
         using LocationTag = Location::DeviceTag;
         static constexpr LocationTag Location = Location::Device;
 
-        using Ref          = Ref<Texture>;
+        using Ref          = HF::Ref<Texture>;
         using Value        = _Value;
         using BuiltInValue = typename Traits<_Value>::BuiltInType;
         using Dims         = IntN<Order>;
@@ -3,15 +3,22 @@
 
 #include <Simulator/Compute/Kernel.hpp>
 #include <Simulator/Compute/Copy.hpp>
+#include <Simulator/Compute/TaskGraph.hpp>
 #include <Simulator/Compute/Buffers/Buffer.hpp>
+#include <Simulator/Compute/Memory/ArenaMemoryResource.hpp>
+#include <Simulator/Compute/Memory/PooledMemoryResource.hpp>
 #include <Simulator/Geometry/Primitives/AABB.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 #include <Simulator/Fluids/FluidDomainBounds.hpp>
 #include <Simulator/Fluids/FluidDomainBoundsVelocity.hpp>
+#include <Simulator/Fluids/FluidMaskField.hpp>
 #include <Simulator/Fluids/FluidScalarField.hpp>
+#include <Simulator/Fluids/FluidSparseScalarField.hpp>
+#include <Simulator/Fluids/FluidSparseVectorField.hpp>
 #include <Simulator/Fluids/FluidVectorField.hpp>
 #include <Simulator/Fluids/FluidProperty.hpp>
 #include <Simulator/Fluids/FluidParams.hpp>
+#include <Simulator/Fluids/FluidStorage.hpp>
 #include <Simulator/Fluids/Obstacles/SphereCollider.hpp>
 #include <Simulator/Fluids/Obstacles/CapsuleCollider.hpp>
 #include <Simulator/Fluids/Obstacles/Obstacle.hpp>
@@ -20,8 +27,10 @@
 #include <Simulator/Fluids/Kernels/DissipationKernel.hpp>
 #include <Simulator/Fluids/Kernels/ForceKernel.hpp>
 #include <Simulator/Fluids/Kernels/GravityKernel.hpp>
+#include <Simulator/Fluids/Kernels/PressureHaloKernel.hpp>
 #include <Simulator/Fluids/Kernels/PressureJacobiKernel.hpp>
 #include <Simulator/Fluids/Kernels/PressureJacobiProjectionKernel.hpp>
+#include <Simulator/Fluids/Kernels/PressureRedBlackKernel.hpp>
 #include <Simulator/Fluids/Kernels/ObstacleBoundaryKernel.hpp>
 #include <Simulator/Fluids/Kernels/VelocityAdvectionKernel.hpp>
 #include <Simulator/Fluids/Kernels/VelocityBoundaryProjection.hpp>
@@ -31,13 +40,17 @@
 #include <Simulator/Fluids/Kernels/VorticityKernel.hpp>
 #include <Simulator/Fluids/Kernels/SamplingKernel.hpp>
 #include <Simulator/Utility/Patterns/DoubleBuffer.hpp>
-#include <Simulator/Utility/Patterns/TripleBuffer.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Simulator)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint _Order>
+    /**
+     * \brief Eulerian fluid on a staggered grid.
+     * \tparam _Order Order (dimensions) of the fluid.
+     * \tparam _Storage Storage types of the main fields (see FluidStorage).
+     */
+    template <uint _Order, typename _Storage = FluidStorage::Full>
     class Fluid
     {
         static_assert(_Order >= 2 && _Order <= 3, "Only 2D and 3D fluids are supported.");
@@ -45,7 +58,8 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
     public:
         static constexpr uint Order = _Order;
 
-        using Ref                        = Ref<Fluid>;
+        using Storage                    = _Storage;
+        using Ref                        = HF::Ref<Fluid>;
         using Dims                       = IntN<_Order>;
         using Index                      = IntN<_Order>;
         using Coords                     = FloatN<_Order>;
@@ -54,19 +68,42 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using DomainBounds               = FluidDomainBounds<_Order>;
         using DomainBoundsVelocity       = FluidDomainBoundsVelocity<_Order>;
         using Params                     = FluidParams<_Order>;
-                                         
-        using InkField                   = FluidScalarField<_Order, Float4>;
+
+        /**
+         * \brief Extent of the tiles of the fields the step touches, if sparse (see
+         *        FluidStorage::Sparse).
+         */
+        static constexpr uint TileSize = FluidStorage::TileSizeOf<_Storage>::value;
+        static constexpr bool IsSparse = TileSize > 0;
+
+        static_assert(!IsSparse || HF_CPU_ONLY == true, "Sparse fluids are only supported by host-only builds.");
+
+        /**
+         * \brief Fields the step touches, sparse for sparse storages and dense otherwise.
+         */
+        template <typename Value, typename Storage = Value>
+        using StepScalarField            = typename std::conditional<IsSparse,
+                                                                     FluidSparseScalarField<_Order, Value, TileSize>,
+                                                                     FluidScalarField<_Order, Value, Storage>>::type;
+        template <typename Value, typename Storage = Value>
+        using StepVectorField            = typename std::conditional<IsSparse,
+                                                                     FluidSparseVectorField<_Order, Value, TileSize>,
+                                                                     FluidVectorField<_Order, Value, Storage>>::type;
+
+        using InkField                   = StepScalarField<Float4, typename _Storage::Ink>;
         using TemperatureField           = FluidScalarField<_Order, float>;
-        using PressureField              = FluidScalarField<_Order, float>;
-        using PressureGradNormField      = FluidScalarField<_Order, float>;
-        using VelocityField              = FluidVectorField<_Order, float>;
-        using VelocityDivergenceField    = FluidScalarField<_Order, float>;
-        using BoundaryField              = FluidScalarField<_Order, uchar>;
-        using BoundaryDistanceField      = FluidScalarField<_Order, float>;
-        using BoundaryVelocityField      = FluidVectorField<_Order, float>;
-        using VorticityField             = FluidVectorField<_Order, float>;
-        using VorticityNormField         = FluidScalarField<_Order, float>;
-        using ConfinementField           = FluidVectorField<_Order, float>;
+        using PressureField              = StepScalarField<float, typename _Storage::Pressure>;
+        using PressureGradNormField      = StepScalarField<float>;
+        using VelocityField              = StepVectorField<float, typename _Storage::Velocity>;
+        using VelocityDivergenceField    = StepScalarField<float>;
+        using BoundaryField              = typename std::conditional<IsSparse,
+                                                                     FluidSparseScalarField<_Order, uchar, TileSize>,
+                                                                     FluidMaskField<_Order>>::type;
+        using BoundaryDistanceField      = StepScalarField<float>;
+        using BoundaryVelocityField      = StepVectorField<float>;
+        using VorticityField             = StepVectorField<float>;
+        using VorticityNormField         = StepScalarField<float>;
+        using ConfinementField           = StepVectorField<float>;
 
         using InkFieldRef                = typename InkField::Ref;
         using TemperatureFieldRef        = typename TemperatureField::Ref;
@@ -97,59 +134,70 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             , _viscosity(params.viscosity)
             , _confinement(params.confinement)
             , _jacobiSteps(params.jacobiSteps)
+            , _pressureSolver(params.pressureSolver)
+            , _pressureRelaxation(params.pressureRelaxation)
             , _inkDissipation(params.inkDissipation)
             , _velocityDissipation(params.velocityDissipation)
             , _pressureDissipation(params.pressureDissipation)
+            , _inkPruneThreshold(params.inkPruneThreshold)
+            , _velocityPruneThreshold(params.velocityPruneThreshold)
+            , _hostPool(Compute::PooledMemoryResource::GetHostPool(params.hostBufferFlags))
+            , _hostBufferFlags(params.hostBufferFlags)
+            , _temperatureEnabled(false)
+            , _pressureGradNormEnabled(params.pressureGradNorm)
         {
-            // Allocate grids.
-
-            _inkField[0]             = InkField::Create(_domain);
-            _inkField[1]             = InkField::Create(_domain);
-            _inkField[2]             = InkField::Create(_domain);
-            _temperatureField[0]     = TemperatureField::Create(_domain);
-            _temperatureField[1]     = TemperatureField::Create(_domain);
-            _pressureField[0]        = PressureField::Create(_domain);
-            _pressureField[1]        = PressureField::Create(_domain);
-            _pressureGradNormField   = PressureGradNormField::Create(_domain);
-            _velocityField[0]        = VelocityField::Create(_domain, true);
-            _velocityField[1]        = VelocityField::Create(_domain, true);
-            _velocityDivergenceField = VelocityDivergenceField::Create(_domain);
-            _boundaryField           = BoundaryField::Create(_domain);
-            _boundaryDistanceField   = BoundaryDistanceField::Create(_domain);
-            _boundaryVelocityField   = BoundaryVelocityField::Create(_domain, false);
-            _vorticityField          = VorticityField::Create(_domain, false);
-            _vorticityNormField      = VorticityNormField::Create(_domain);
-            _confinementField        = ConfinementField::Create(_domain, false);
-
-            // Initialize them all to zero.
-
-            _inkField[0]->clear(Float4(0.0f));
-            _inkField[1]->clear(Float4(0.0f));
-            _inkField[2]->clear(Float4(0.0f));
-            _temperatureField[0]->clear(0.0f);
-            _temperatureField[1]->clear(0.0f);
-            _pressureField[0]->clear(0.0f);
-            _pressureField[1]->clear(0.0f);
-            _pressureGradNormField->clear(0.0f);
-            _velocityField[0]->getAxis(0)->clear(0.0f);
-            _velocityField[1]->getAxis(0)->clear(0.0f);
-            _velocityField[0]->getAxis(1)->clear(0.0f);
-            _velocityField[1]->getAxis(1)->clear(0.0f);
-            _velocityField[0]->getAxis(2)->clear(0.0f);
-            _velocityField[1]->getAxis(2)->clear(0.0f);
-            _velocityDivergenceField->clear(0.0f);
-            _boundaryField->clear(0);
-            _boundaryDistanceField->clear(0.0f);
-            _boundaryVelocityField->getAxis(0)->clear(0.0f);
-            _boundaryVelocityField->getAxis(1)->clear(0.0f);
-            _boundaryVelocityField->getAxis(2)->clear(0.0f);
-            _vorticityField->getAxis(0)->clear(0.0f);
-            _vorticityField->getAxis(1)->clear(0.0f);
-            _vorticityField->getAxis(2)->clear(0.0f);
-            _vorticityNormField->clear(0.0f);
-            _confinementField->getAxis(0)->clear(0.0f);
-            _confinementField->getAxis(1)->clear(0.0f);
-            _confinementField->getAxis(2)->clear(0.0f);
+            // Allocate the grids every step needs. Host storage comes from a single zero-filled
+            // arena, itself taken from the shared host pool, so creating and destroying fluids
+            // recycles memory instead of allocating (and clearing) every buffer separately. Dense
+            // host pressure fields get a halo, so that Jacobi iterations read across the domain
+            // faces without checking the domain bounds (see fillPressureHalo). Red-black
+            // iterations update the pressure in place, so only Jacobi ones need a second field.
+            // Sparse fields only take their tile tables from the arena, and start with no tile.
+            //
+            // Grids of optional features are taken from the pool on their own instead, once the
+            // feature is first used, and returned to it once the feature is disabled.
+
+            const Compute::MemoryResource::Ref hostArena = Compute::ArenaMemoryResource::Create(_hostPool, getHostStorageSize(_domain, params.hostBufferFlags, params.pressureSolver));
+
+            _inkField[0]             = InkField::Create(_domain, hostArena, params.hostBufferFlags);
+            _inkField[1]             = InkField::Create(_domain, hostArena, params.hostBufferFlags);
+            _pressureField[0]        = PressureField::Create(_domain, hostArena, getPressureFlags(params.hostBufferFlags));
+
+            if (_pressureSolver == FluidPressureSolver::Jacobi)
+                _pressureField[1]    = PressureField::Create(_domain, hostArena, getPressureFlags(params.hostBufferFlags));
+
+            _velocityField[0]        = VelocityField::Create(_domain, true, hostArena, params.hostBufferFlags);
+            _velocityField[1]        = VelocityField::Create(_domain, true, hostArena, params.hostBufferFlags);
+            _velocityDivergenceField = VelocityDivergenceField::Create(_domain, hostArena, params.hostBufferFlags);
+            _boundaryField           = BoundaryField::Create(_domain, hostArena, params.hostBufferFlags);
+            _boundaryDistanceField   = BoundaryDistanceField::Create(_domain, hostArena, params.hostBufferFlags);
+            _boundaryVelocityField   = BoundaryVelocityField::Create(_domain, false, hostArena, params.hostBufferFlags);
+
+            // Initialize them all to zero. Host-side storage already is.
+
+            #if HF_CPU_ONLY == false
+            _inkField[0]->clear(Compute::Location::Device, Float4(0.0f));
+            _inkField[1]->clear(Compute::Location::Device, Float4(0.0f));
+            _pressureField[0]->clear(Compute::Location::Device, 0.0f);
+
+            if (_pressureField[1])
+                _pressureField[1]->clear(Compute::Location::Device, 0.0f);
+
+            _velocityField[0]->getAxis(0)->clear(Compute::Location::Device, 0.0f);
+            _velocityField[1]->getAxis(0)->clear(Compute::Location::Device, 0.0f);
+            _velocityField[0]->getAxis(1)->clear(Compute::Location::Device, 0.0f);
+            _velocityField[1]->getAxis(1)->clear(Compute::Location::Device, 0.0f);
+            _velocityField[0]->getAxis(2)->clear(Compute::Location::Device, 0.0f);
+            _velocityField[1]->getAxis(2)->clear(Compute::Location::Device, 0.0f);
+            _velocityDivergenceField->clear(Compute::Location::Device, 0.0f);
+            _boundaryField->clear(Compute::Location::Device, 0);
+            _boundaryDistanceField->clear(Compute::Location::Device, 0.0f);
+            _boundaryVelocityField->getAxis(0)->clear(Compute::Location::Device, 0.0f);
+            _boundaryVelocityField->getAxis(1)->clear(Compute::Location::Device, 0.0f);
+            _boundaryVelocityField->getAxis(2)->clear(Compute::Location::Device, 0.0f);
+            #endif
+
+            setTemperatureEnabled(params.temperature);
         }
 
     public:
@@ -203,11 +251,94 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             return _viscosity;
         }
 
+        FluidPressureSolver getPressureSolver() const
+        {
+            return _pressureSolver;
+        }
+
+        float getPressureRelaxation() const
+        {
+            return _pressureRelaxation;
+        }
+
+        /**
+         * \brief Sets the over-relaxation factor of red-black pressure iterations, within (0, 2).
+         */
+        void setPressureRelaxation(float relaxation)
+        {
+            HF_ASSERT(relaxation > 0.0f && relaxation < 2.0f, "The relaxation factor must lie within (0, 2).");
+            _pressureRelaxation = relaxation;
+        }
+
+        float getConfinement() const
+        {
+            return _confinement;
+        }
+
+        /**
+         * \brief Sets the strength of the vorticity confinement. The vorticity and confinement
+         *        fields are allocated by the first step run with confinement, and released as
+         *        soon as it is set to zero.
+         */
+        void setConfinement(float confinement)
+        {
+            _confinement = confinement;
+
+            if (_confinement <= 0.0f)
+                releaseConfinementFields();
+        }
+
+        bool isTemperatureEnabled() const
+        {
+            return _temperatureEnabled;
+        }
+
+        /**
+         * \brief Allocates the temperature fields, or releases them. They are not touched by the
+         *        step itself, so they only exist for those who write and read them.
+         */
+        void setTemperatureEnabled(bool enabled)
+        {
+            _temperatureEnabled = enabled;
+
+            if (enabled && !_temperatureField.getFront())
+            {
+                _temperatureField[0] = createScalarField<TemperatureField>();
+                _temperatureField[1] = createScalarField<TemperatureField>();
+            }
+            else if (!enabled)
+            {
+                _temperatureField[0] = nullptr;
+                _temperatureField[1] = nullptr;
+            }
+        }
+
+        bool isPressureGradNormEnabled() const
+        {
+            return _pressureGradNormEnabled;
+        }
+
+        /**
+         * \brief Enables the output of the pressure gradient norm, or disables it and releases
+         *        its field. The field is allocated by the first step run with it enabled.
+         */
+        void setPressureGradNormEnabled(bool enabled)
+        {
+            _pressureGradNormEnabled = enabled;
+
+            if (!enabled)
+                _pressureGradNormField = nullptr;
+        }
+
         const InkFieldRef& getInkField() const
         {
             return _inkField.getFront();
         }
 
+        /**
+         * \brief Returns the current temperature field, or null unless enabled (see
+         *        setTemperatureEnabled).
+         */
         const TemperatureFieldRef& getTemperatureField() const
         {
             return _temperatureField.getFront();
@@ -218,6 +349,10 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             return _pressureField.getFront();
         }
 
+        /**
+         * \brief Returns the norm of the pressure gradient of the last step, or null unless a
+         *        step ran with it enabled (see setPressureGradNormEnabled).
+         */
         const PressureGradNormFieldRef& getPressureGradNormField() const
         {
             return _pressureGradNormField;
@@ -248,6 +383,10 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             return _boundaryVelocityField;
         }
 
+        /**
+         * \brief Returns the vorticity of the last step, or null unless a step ran with
+         *        confinement. Same for the vorticity norm and the confinement force.
+         */
         const VorticityFieldRef& getVorticityField() const
         {
             return _vorticityField;
@@ -263,6 +402,38 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             return _confinementField;
         }
 
+        /**
+         * \brief Makes the ink and velocity within the given region of cells writable. Sparse
+         *        fluids only store the tiles around ink, moving fluid and obstacles, so emitters
+         *        activate those they are about to write into, velocity faces on the far side of
+         *        the region included. Dense ones are left untouched.
+         * \param location Location of the fields.
+         * \param offset Index of the first cell of the region.
+         * \param size Size of the region, in cells.
+         */
+        template <typename LocationTag>
+        void activateRegion(const LocationTag& location, const Index& offset, const Dims& size)
+        {
+            activateRegion(std::integral_constant<bool, IsSparse>(), location, offset, size);
+        }
+
+        /**
+         * \brief Executes a kernel writing into the given region of cells (e.g. an emitter), its
+         *        threads indexing the nodes grid. Sparse fluids launch it over the tiles
+         *        overlapping the region alone, faces on its far side included, so the region must
+         *        have been activated first (see activateRegion). Dense ones launch it over the
+         *        whole nodes grid.
+         * \param location Location where the kernel will be executed.
+         * \param offset Index of the first cell of the region.
+         * \param size Size of the region, in cells.
+         * \param args Arguments supplied to the kernel.
+         */
+        template <template <uint, typename> class Kernel, typename LocationTag, typename... Args>
+        void executeOnRegion(const LocationTag& location, const Index& offset, const Dims& size, Args... args)
+        {
+            executeOnRegion<Kernel>(std::integral_constant<bool, IsSparse>(), location, offset, size, args...);
+        }
+
         BoxObstacleRef createBoxObstacle()
         {
             auto box = std::make_shared<BoxObstacle>();
@@ -322,24 +493,247 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         }
 
     private:
-        template <typename LocationTag, typename FieldRef>
-        void advectScalarField(const LocationTag& location, FieldRef& field, float timestep)
+        template <typename LocationTag>
+        void activateRegion(std::false_type, const LocationTag&, const Index&, const Dims&)
         {
-            auto& velocityField = _velocityField.getFront();
-            auto& frontField = field.getFront();   // N
-            auto& middleField = field.getMiddle(); // N+1 (hat) / N+1
-            auto& backField = field.getBack();     // N (hat)
+        }
 
-            // N+1 (hat)
+        template <typename LocationTag>
+        void activateRegion(std::true_type, const LocationTag& location, const Index& offset, const Dims& size)
+        {
+            _inkField.getFront()->activateRegion(location, offset, size);
+            _velocityField.getFront()->activateRegion(location, offset, size + 1);
+        }
 
-            Compute::Kernel::execute<Order, AdvectionKernel>(location,
-                                                             _domain.getDims(),
-                                                             _domain,
-                                                             frontField->getSampler(location),
-                                                             velocityField->getConstAccessor(location),
-                                                             middleField->getAccessor(location),
-                                                             timestep);
+        template <template <uint, typename> class Kernel, typename LocationTag, typename... Args>
+        void executeOnRegion(std::false_type, const LocationTag& location, const Index&, const Dims&, Args... args)
+        {
+            Compute::Kernel::execute<Order, Kernel>(location, _domain.getDimsOfNodesGrid(), args...);
+        }
+
+        template <template <uint, typename> class Kernel, typename LocationTag, typename... Args>
+        void executeOnRegion(std::true_type, const LocationTag& location, const Index& offset, const Dims& size, Args... args)
+        {
+            const Dims nodesDims = _domain.getDimsOfNodesGrid();
+
+            if (any(lessThan(size, Dims(1))) || any(lessThan(offset + size, Index(0))) || any(greaterThanEqual(offset, nodesDims)))
+                return;
+
+            // Gather the tiles overlapping the region, grown by one node towards its far side.
+
+            const Dims tileDims = Dims(int(TileSize));
+            std::vector<Index> tiles;
+
+            forEachTile(clamp(offset, Index(0), nodesDims - 1) / tileDims, clamp(offset + size, Index(0), nodesDims - 1) / tileDims, [&tiles](const Index& tileIdx)
+            {
+                tiles.push_back(tileIdx);
+            });
+
+            Compute::Kernel::executeOnTiles<Order, Kernel>(location, tiles, tileDims, args...);
+        }
+
+        /**
+         * \brief Executes a kernel of the step over the given no. of threads. Sparse fluids launch
+         *        it over the active tiles of the step alone (see updateActiveTiles), so kernels
+         *        must keep checking their bounds.
+         */
+        template <template <uint, typename> class Kernel, typename LocationTag, typename... Args>
+        void executeOnDomain(const LocationTag& location, const Dims& threadCount, Args... args)
+        {
+            executeOnDomain<Kernel>(std::integral_constant<bool, IsSparse>(), location, threadCount, args...);
+        }
+
+        template <template <uint, typename> class Kernel, typename LocationTag, typename... Args>
+        void executeOnDomain(std::false_type, const LocationTag& location, const Dims& threadCount, Args... args)
+        {
+            Compute::Kernel::execute<Order, Kernel>(location, threadCount, args...);
+        }
+
+        template <template <uint, typename> class Kernel, typename LocationTag, typename... Args>
+        void executeOnDomain(std::true_type, const LocationTag& location, const Dims&, Args... args)
+        {
+            Compute::Kernel::executeOnTiles<Order, Kernel>(location, _activeTiles, Dims(int(TileSize)), args...);
+        }
+
+        /**
+         * \brief Calls the given function with the index of every tile between the given ones,
+         *        both included.
+         */
+        template <typename Function>
+        static void forEachTile(const Index& firstTile, const Index& lastTile, Function&& func)
+        {
+            const Index tileCount = lastTile - firstTile + 1;
+            const uint count = uint(compMul(max(tileCount, Index(0))));
+
+            for (uint i = 0; i < count; ++i)
+            {
+                Index tileIdx = firstTile;
+                uint remainder = i;
+
+                for (uint axis = 0; axis < Order; ++axis)
+                {
+                    tileIdx[axis] += int(remainder % uint(tileCount[axis]));
+                    remainder /= uint(tileCount[axis]);
+                }
+
+                func(tileIdx);
+            }
+        }
+
+        /**
+         * \brief Returns the no. of tiles (of the given size) values may travel across within a
+         *        step of the given timestep. Values travel up to |velocity| * timestep / dx cells
+         *        along each axis, and sampling reaches one cell further.
+         */
+        template <typename LocationTag>
+        int getTravelInTiles(const LocationTag& location, float timestep, uint tileSize) const
+        {
+            const auto& velocityField = _velocityField.getFront();
+            const Coords oneOverDx = _domain.getOneOverDx();
+            float travel = 0.0f;
+
+            for (uint axis = 0; axis < Order; ++axis)
+                travel = std::max(travel, velocityField->getAxis(axis)->getMaxAbs(location) * std::abs(timestep) * oneOverDx[axis]);
+
+            travel = std::min(travel, float(compMax(_domain.getDims())));
+
+            return int(std::ceil((travel + 1.0f) / tileSize));
+        }
+
+        template <typename LocationTag>
+        void updateActiveTiles(const LocationTag& location)
+        {
+            updateActiveTiles(std::integral_constant<bool, IsSparse>(), location);
+        }
+
+        template <typename LocationTag>
+        void updateActiveTiles(std::false_type, const LocationTag&)
+        {
+        }
+
+        /**
+         * \brief Picks the tiles the step of a sparse fluid runs over, and makes them the active
+         *        ones of every field it touches but the ink, which follows its own tiles. Those
+         *        are the tiles holding ink, moving fluid or obstacles, grown by the distance
+         *        values may travel within the step. The fluid elsewhere is at rest, and cells
+         *        there read as solid (see clearBoundaryFields), so the edges of the active region
+         *        act as walls the region is moved away from as the fluid reaches them.
+         */
+        void updateActiveTiles(std::true_type, const Compute::Location::HostTag& location)
+        {
+            // Release the velocity tiles of the fluid that came to rest.
+
+            _velocityField.getFront()->pruneTiles(location, _velocityPruneThreshold);
+
+            // Mark the tiles around ink, moving fluid and obstacles. Tiles cover the nodes grid,
+            // so that every face of the staggered fields is reached.
+
+            const int dilation = getTravelInTiles(location, _timestep, TileSize);
+            const Dims tileDims = (_domain.getDimsOfNodesGrid() + int(TileSize) - 1) / int(TileSize);
+            const Index tileStride = exclusiveCumProd(tileDims);
+
+            std::vector<uchar> required(std::size_t(compMul(tileDims)), 0);
+
+            const auto markTiles = [&](const Index& firstTile, const Index& lastTile)
+            {
+                forEachTile(clamp(firstTile - dilation, Index(0), tileDims - 1), clamp(lastTile + dilation, Index(0), tileDims - 1), [&](const Index& tileIdx)
+                {
+                    required[std::size_t(compAdd(tileIdx * tileStride))] = 1;
+                });
+            };
+
+            for (const Index& tileIdx : _inkField.getFront()->getActiveTiles(location))
+                markTiles(tileIdx, tileIdx);
+
+            for (uint axis = 0; axis < Order; ++axis)
+            {
+                for (const Index& tileIdx : _velocityField.getFront()->getAxis(axis)->getActiveTiles(location))
+                    markTiles(tileIdx, tileIdx);
+            }
+
+            forEachObstacleRegion([&](const Index& offset, const Dims& size)
+            {
+                markTiles(offset / int(TileSize), (offset + size - 1) / int(TileSize));
+            });
+
+            _activeTiles.clear();
+
+            forEachTile(Index(0), tileDims - 1, [&](const Index& tileIdx)
+            {
+                if (required[std::size_t(compAdd(tileIdx * tileStride))])
+                    _activeTiles.push_back(tileIdx);
+            });
+
+            // Make them the tiles of every field of the step. Values of the tiles staying active
+            // are kept, e.g. as the initial guess of the pressure.
+
+            setActiveTiles(*_velocityField.getFront());
+            setActiveTiles(*_velocityField.getBack());
+            setActiveTiles(*_pressureField.getFront());
+
+            if (_pressureField.getBack())
+                setActiveTiles(*_pressureField.getBack());
+
+            setActiveTiles(*_velocityDivergenceField);
+            setActiveTiles(*_boundaryField);
+            setActiveTiles(*_boundaryDistanceField);
+            setActiveTiles(*_boundaryVelocityField);
+
+            if (_pressureGradNormField)
+                setActiveTiles(*_pressureGradNormField);
+
+            if (_vorticityField)
+            {
+                setActiveTiles(*_vorticityField);
+                setActiveTiles(*_vorticityNormField);
+                setActiveTiles(*_confinementField);
+            }
+        }
+
+        /**
+         * \brief Makes the active tiles of a sparse field those of the step (see
+         *        updateActiveTiles). Dense fields are left untouched.
+         */
+        template <typename Field>
+        void setActiveTiles(Field&)
+        {
+        }
+
+        template <typename Value, uint FieldTileSize>
+        void setActiveTiles(FluidSparseScalarField<Order, Value, FieldTileSize>& field)
+        {
+            field.setActiveTiles(Compute::Location::Host, _activeTiles);
+        }
+
+        template <typename Value, uint FieldTileSize>
+        void setActiveTiles(FluidSparseVectorField<Order, Value, FieldTileSize>& field)
+        {
+            field.setActiveTiles(Compute::Location::Host, _activeTiles);
+        }
+
+        template <typename LocationTag, typename FieldRef, typename Dissipation>
+        void advectScalarField(const LocationTag& location, FieldRef& field, float timestep, Dissipation dissipation)
+        {
+            auto& velocityField = _velocityField.getFront();
+            auto& frontField = field.getFront(); // N
+            auto& backField = field.getBack();   // N+1
+
+            // N+1. Dissipation only touches the advected cell, so it runs in the same sweep.
+
+            Compute::Kernel::executeFused<Order, AdvectionKernel, DissipationKernel>(location,
+                                                                                     _domain.getDims(),
+                                                                                     Compute::Kernel::args(_domain,
+                                                                                                           frontField->getSampler(location),
+                                                                                                           velocityField->getConstAccessor(location),
+                                                                                                           backField->getAccessor(location),
+                                                                                                           timestep),
+                                                                                     Compute::Kernel::args(_domain,
+                                                                                                           backField->getAccessor(location),
+                                                                                                           timestep * dissipation));
             /*
+            // MacCormack correction. Needs a third field (i.e. a triple buffer), holding N+1 (hat)
+            // in the middle and N (hat) in the back.
+
             // N (hat)
 
             Compute::Kernel::execute<Order, AdvectionKernel>(location,
@@ -365,61 +759,101 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             field.swap();
         }
 
+        template <typename Value, uint TileSize, typename Dissipation>
+        void advectScalarField(const Compute::Location::HostTag& location, DoubleBuffer<HF::Ref<FluidSparseScalarField<Order, Value, TileSize>>>& field, float timestep, Dissipation dissipation)
+        {
+            auto& velocityField = _velocityField.getFront();
+            auto& frontField = field.getFront(); // N
+            auto& middleField = field.getBack(); // N+1
+
+            // The advected field is covered by the tiles of the current one, dilated by the
+            // distance values travel within the step. Only those are swept.
+
+            middleField->matchTiles(location, *frontField, getTravelInTiles(location, timestep, TileSize));
+
+            Compute::Kernel::executeFusedOnTiles<Order, AdvectionKernel, DissipationKernel>(location,
+                                                                                            middleField->getActiveTiles(location),
+                                                                                            middleField->getTileDims(),
+                                                                                            Compute::Kernel::args(_domain,
+                                                                                                                  frontField->getSampler(location),
+                                                                                                                  velocityField->getConstAccessor(location),
+                                                                                                                  middleField->getAccessor(location),
+                                                                                                                  timestep),
+                                                                                            Compute::Kernel::args(_domain,
+                                                                                                                  middleField->getAccessor(location),
+                                                                                                                  timestep * dissipation));
+
+            // Release the tiles left empty, i.e. whose contents decayed or moved away.
+
+            middleField->pruneTiles(location, _inkPruneThreshold);
+
+            field.swap();
+        }
+
         template <typename LocationTag>
         void advectVelocityField(const LocationTag& location, float timestep, float dissipation)
         {
-            Compute::Kernel::execute<Order, VelocityAdvectionKernel>(location,
-                                                                     _domain.getDimsOfNodesGrid(),
-                                                                     _domain,
-                                                                     _velocityField.getFront()->getSampler(location),
-                                                                     _velocityField.getBack()->getAccessor(location),
-                                                                     timestep,
-                                                                     dissipation);
+            // Gravity only touches the advected face, so it runs in the same sweep.
+
+            if (dot(_gravity, _gravity) > 0.0f)
+            {
+                executeOnDomain<Compute::Kernel::Fused<VelocityAdvectionKernel, GravityKernel>::template Type>(location,
+                                                                                                               _domain.getDimsOfNodesGrid(),
+                                                                                                               Compute::Kernel::args(_domain,
+                                                                                                                                     _velocityField.getFront()->getSampler(location),
+                                                                                                                                     _velocityField.getBack()->getAccessor(location),
+                                                                                                                                     timestep,
+                                                                                                                                     dissipation),
+                                                                                                               Compute::Kernel::args(_domain,
+                                                                                                                                     _velocityField.getBack()->getAccessor(location),
+                                                                                                                                     _gravity,
+                                                                                                                                     timestep));
+            }
+            else
+            {
+                executeOnDomain<VelocityAdvectionKernel>(location,
+                                                         _domain.getDimsOfNodesGrid(),
+                                                         _domain,
+                                                         _velocityField.getFront()->getSampler(location),
+                                                         _velocityField.getBack()->getAccessor(location),
+                                                         timestep,
+                                                         dissipation);
+            }
+        }
 
+        void swapVelocityField()
+        {
             _velocityField.swap();
         }
 
         template <typename LocationTag, typename FieldRef>
         void applyForces(const LocationTag& location, FieldRef& field, float timestep)
         {
-            Compute::Kernel::execute<Order, ForceKernel>(location,
-                                                         _domain.getDimsOfNodesGrid(),
-                                                         _domain,
-                                                         field->getConstAccessor(location),
-                                                         _velocityField.getFront()->getAccessor(location),
-                                                         timestep);
+            executeOnDomain<ForceKernel>(location,
+                                         _domain.getDimsOfNodesGrid(),
+                                         _domain,
+                                         field->getConstAccessor(location),
+                                         _velocityField.getFront()->getAccessor(location),
+                                         timestep);
         }
 
         template <typename LocationTag, typename FieldRef, typename Dissipation>
         void applyDissipation(const LocationTag& location, FieldRef& field, float timestep, Dissipation dissipation)
         {
-            Compute::Kernel::execute<Order, DissipationKernel>(location,
-                                                               _domain.getDims(),
-                                                               _domain,
-                                                               field->getAccessor(location),
-                                                               timestep * dissipation);
-        }
+            // Same as DissipationKernel, for fields not advected in the same sweep.
 
-        template <typename LocationTag>
-        void applyGravityForces(const LocationTag& location, float timestep)
-        {
-            Compute::Kernel::execute<Order, GravityKernel>(location,
-                                                           _domain.getDimsOfNodesGrid(),
-                                                           _domain,
-                                                           _velocityField.getFront()->getAccessor(location),
-                                                           _gravity,
-                                                           timestep);
+            field->scale(location, 1.0f - timestep * dissipation);
         }
 
         template <typename LocationTag>
         void applyViscosityForces(const LocationTag& location, float timestep, float viscosity)
         {
-            Compute::Kernel::execute<Order, ViscosityKernel>(location,
-                                                             _domain.getDimsOfNodesGrid() + 5,
-                                                             _domain,
-                                                             _velocityField.getFront()->getConstAccessor(location),
-                                                             _velocityField.getBack()->getAccessor(location),
-                                                             viscosity * timestep / _density);
+            executeOnDomain<ViscosityKernel>(location,
+                                             _domain.getDimsOfNodesGrid() + 5,
+                                             _domain,
+                                             _velocityField.getFront()->getConstAccessor(location),
+                                             _velocityField.getBack()->getAccessor(location),
+                                             viscosity * timestep / _density);
 
             _velocityField.swap();
         }
@@ -427,34 +861,34 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         template <typename LocationTag>
         void computeDivergence(const LocationTag& location)
         {
-            Compute::Kernel::execute<Order, VelocityDivergenceKernel>(location,
-                                                                      _domain.getDims(),
-                                                                      _domain,
-                                                                      _velocityField.getFront()->getConstAccessor(location),
-                                                                      _velocityDivergenceField->getAccessor(location));
+            executeOnDomain<VelocityDivergenceKernel>(location,
+                                                      _domain.getDims(),
+                                                      _domain,
+                                                      _velocityField.getFront()->getConstAccessor(location),
+                                                      _velocityDivergenceField->getAccessor(location));
         }
 
         template <typename LocationTag>
         void computeVorticity(const LocationTag& location)
         {
-            Compute::Kernel::execute<Order, VorticityKernel>(location,
-                                                             _domain.getDims(),
-                                                             _domain,
-                                                             _velocityField.getFront()->getConstAccessor(location),
-                                                             _vorticityField->getAccessor(location),
-                                                             _vorticityNormField->getAccessor(location));
+            executeOnDomain<VorticityKernel>(location,
+                                             _domain.getDims(),
+                                             _domain,
+                                             _velocityField.getFront()->getConstAccessor(location),
+                                             _vorticityField->getAccessor(location),
+                                             _vorticityNormField->getAccessor(location));
         }
 
         template <typename LocationTag>
         void computeConfinement(const LocationTag& location)
         {
-            Compute::Kernel::execute<Order, VorticityConfinementKernel>(location,
-                                                                        _domain.getDims(),
-                                                                        _domain,
-                                                                        _vorticityField->getConstAccessor(location),
-                                                                        _vorticityNormField->getConstAccessor(location),
-                                                                        _confinementField->getAccessor(location),
-                                                                        _confinement);
+            executeOnDomain<VorticityConfinementKernel>(location,
+                                                        _domain.getDims(),
+                                                        _domain,
+                                                        _vorticityField->getConstAccessor(location),
+                                                        _vorticityNormField->getConstAccessor(location),
+                                                        _confinementField->getAccessor(location),
+                                                        _confinement);
         }
 
         template <typename LocationTag>
@@ -464,60 +898,150 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
             applyDissipation(location, _pressureField.getFront(), _timestep, _pressureDissipation);
 
+            if (_pressureSolver == FluidPressureSolver::RedBlackSOR)
+            {
+                computePressureRedBlack(location, timestep);
+                return;
+            }
+
             for (uint i = 0; i < _jacobiSteps; ++i)
             {
-                Compute::Kernel::execute<Order, PressureJacobiKernel>(location,
-                                                                      _domain.getDims(),
-                                                                      _domain,
-                                                                      _domainBounds,
-                                                                      _pressureField.getFront()->getConstAccessor(location),
-                                                                      _velocityDivergenceField->getConstAccessor(location),
-                                                                      _boundaryField->getConstAccessor(location),
-                                                                      _pressureField.getBack()->getAccessor(location),
-                                                                      _density / timestep);
+                fillPressureHalo(location, _pressureField.getFront());
+
+                executeOnDomain<PressureJacobiKernel>(location,
+                                                      _domain.getDims(),
+                                                      _domain,
+                                                      _domainBounds,
+                                                      _pressureField.getFront()->getConstAccessor(location),
+                                                      _velocityDivergenceField->getConstAccessor(location),
+                                                      _boundaryField->getConstAccessor(location),
+                                                      _pressureField.getBack()->getAccessor(location),
+                                                      _density / timestep);
                 _pressureField.swap();
             }
         }
 
+        template <typename LocationTag>
+        void computePressureRedBlack(const LocationTag& location, float timestep)
+        {
+            // Each iteration updates the red cells and then the black ones, in place. Ghost cells
+            // only mirror the cell next to them, which is of a single color, so filling the halo
+            // once per iteration keeps it current for both halves.
+
+            auto& pressureField = _pressureField.getFront();
+
+            for (uint i = 0; i < _jacobiSteps; ++i)
+            {
+                fillPressureHalo(location, pressureField);
+
+                for (uint color = 0; color < 2; ++color)
+                {
+                    executeOnDomain<PressureRedBlackKernel>(location,
+                                                            _domain.getDims(),
+                                                            _domain,
+                                                            _domainBounds,
+                                                            pressureField->getAccessor(location),
+                                                            _velocityDivergenceField->getConstAccessor(location),
+                                                            _boundaryField->getConstAccessor(location),
+                                                            _density / timestep,
+                                                            color,
+                                                            _pressureRelaxation);
+                }
+            }
+        }
+
+        template <typename LocationTag>
+        void fillPressureHalo(const LocationTag& location, PressureFieldRef& field)
+        {
+            fillPressureHalo(std::integral_constant<bool, IsSparse>(), location, field);
+        }
+
+        void fillPressureHalo(std::true_type, const Compute::Location::HostTag&, PressureFieldRef&)
+        {
+            // Sparse fields have no halo, as the kernels read the domain bounds instead.
+        }
+
+        void fillPressureHalo(std::false_type, const Compute::Location::HostTag& location, PressureFieldRef& field)
+        {
+            // Encode the boundary conditions of the domain faces into the halo, one axis (i.e.
+            // pair of faces) at a time.
+
+            for (uint axis = 0; axis < Order; ++axis)
+            {
+                Dims faceDims = _domain.getDims();
+                faceDims[axis] = 2;
+
+                Compute::Kernel::execute<Order, PressureHaloKernel>(location,
+                                                                    faceDims,
+                                                                    _domain,
+                                                                    _domainBounds,
+                                                                    field->getAccessor(location),
+                                                                    axis);
+            }
+        }
+
+        #if HF_CPU_ONLY == false
+        void fillPressureHalo(std::false_type, const Compute::Location::DeviceTag&, PressureFieldRef&)
+        {
+            // Device fields have no halo, as the device path reads the domain bounds instead.
+        }
+        #endif
+
         template <typename LocationTag>
         void applyPressureForces(const LocationTag& location, float timestep)
         {
-            Compute::Kernel::execute<Order, PressureJacobiProjectionKernel>(location,
-                                                                            _domain.getDimsOfNodesGrid(),
-                                                                            _domain,
-                                                                            _domainBounds,
-                                                                            _pressureField.getFront()->getConstAccessor(location),
-                                                                            _boundaryField->getConstAccessor(location),
-                                                                            _velocityField.getFront()->getAccessor(location),
-                                                                            _pressureGradNormField->getAccessor(location),
-                                                                            timestep / _density);
+            // The gradient norm is only stored when asked for, the kernel dropping it otherwise.
+
+            if (_pressureGradNormEnabled)
+            {
+                if (!_pressureGradNormField)
+                    _pressureGradNormField = createScalarField<PressureGradNormField>();
+
+                applyPressureForces(location, timestep, _pressureGradNormField->getAccessor(location));
+            }
+            else
+            {
+                applyPressureForces(location, timestep, nullptr);
+            }
+        }
+
+        template <typename LocationTag, typename PressureGradNormAccessor>
+        void applyPressureForces(const LocationTag& location, float timestep, PressureGradNormAccessor pressureGradNormAccessor)
+        {
+            executeOnDomain<PressureJacobiProjectionKernel>(location,
+                                                            _domain.getDimsOfNodesGrid(),
+                                                            _domain,
+                                                            _domainBounds,
+                                                            _pressureField.getFront()->getConstAccessor(location),
+                                                            _boundaryField->getConstAccessor(location),
+                                                            _velocityField.getFront()->getAccessor(location),
+                                                            pressureGradNormAccessor,
+                                                            timestep / _density);
         }
 
         template <typename LocationTag>
         void enforceBoundaryConditions(const LocationTag& location)
         {
-            Compute::Kernel::execute<Order, VelocityBoundaryProjectionKernel>(location,
-                                                                              _domain.getDimsOfNodesGrid(),
-                                                                              _domain,
-                                                                              _domainBounds,
-                                                                              _domainBoundsVelocity,
-                                                                              _boundaryField->getConstAccessor(location),
-                                                                              _boundaryDistanceField->getConstAccessor(location),
-                                                                              _boundaryVelocityField->getConstAccessor(location),
-                                                                              _velocityField.getFront()->getAccessor(location));
+            // Every face is written, so the back field holds the whole velocity afterwards.
+
+            executeOnDomain<VelocityBoundaryProjectionKernel>(location,
+                                                              _domain.getDimsOfNodesGrid(),
+                                                              _domain,
+                                                              _domainBounds,
+                                                              _domainBoundsVelocity,
+                                                              _boundaryField->getConstAccessor(location),
+                                                              _boundaryDistanceField->getConstAccessor(location),
+                                                              _boundaryVelocityField->getConstAccessor(location),
+                                                              _velocityField.getFront()->getConstAccessor(location),
+                                                              _velocityField.getBack()->getAccessor(location));
+
+            _velocityField.swap();
         }
 
         template <typename LocationTag>
         void rasterizeObstacles(const LocationTag& location)
         {
-            // Clear boundary field -- Only boundary and distances are required to be cleared,
-            // the velocity will be overwritten at the necessary locations
-
-            _boundaryField->clear(location, false);
-            _boundaryDistanceField->clear(location, 1e10);
-            _boundaryVelocityField->getAxis(0)->clear(location, 0.0f);
-            _boundaryVelocityField->getAxis(1)->clear(location, 0.0f);
-            _boundaryVelocityField->getAxis(2)->clear(location, 0.0f);
+            clearBoundaryFields(std::integral_constant<bool, IsSparse>(), location);
 
             // Compute narrow-band threshold.
 
@@ -544,13 +1068,13 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                     const Index minIndex = _domain.getCellIndex(minCoords, true);
                     const Index maxIndex = _domain.getCellIndex(maxCoords, true);
 
-                    const Index subRegionOffset = _domain.getCellIndex(minCoords, true);
-                    const Index subRegionSize   = _domain.getCellIndex(maxCoords, true) - subRegionOffset + Index(1);
+                    const Index subRegionOffset = minIndex;
+                    const Index subRegionSize   = maxIndex - minIndex + Index(1);
 
                     // Rasterize obstacle!
 
                     Compute::Kernel::execute<Order, ObstacleBoundaryKernel>(location,
-                                                                            _domain.getDims(),
+                                                                            subRegionSize,
                                                                             _domain,
                                                                             subRegionOffset,
                                                                             subRegionSize,
@@ -582,13 +1106,13 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                     const Index minIndex = _domain.getCellIndex(minCoords, true);
                     const Index maxIndex = _domain.getCellIndex(maxCoords, true);
 
-                    const Index subRegionOffset = _domain.getCellIndex(minCoords, true);
-                    const Index subRegionSize   = _domain.getCellIndex(maxCoords, true) - subRegionOffset + Index(1);
+                    const Index subRegionOffset = minIndex;
+                    const Index subRegionSize   = maxIndex - minIndex + Index(1);
 
                     // Rasterize obstacle!
 
                     Compute::Kernel::execute<Order, ObstacleBoundaryKernel>(location,
-                                                                            _domain.getDims(),
+                                                                            subRegionSize,
                                                                             _domain,
                                                                             subRegionOffset,
                                                                             subRegionSize,
@@ -622,13 +1146,13 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                     const Index minIndex = _domain.getCellIndex(minCoords, true);
                     const Index maxIndex = _domain.getCellIndex(maxCoords, true);
 
-                    const Index subRegionOffset = _domain.getCellIndex(minCoords, true);
-                    const Index subRegionSize   = _domain.getCellIndex(maxCoords, true) - subRegionOffset + Index(1);
+                    const Index subRegionOffset = minIndex;
+                    const Index subRegionSize   = maxIndex - minIndex + Index(1);
 
                     // Rasterize obstacle!
 
                     Compute::Kernel::execute<Order, ObstacleBoundaryKernel>(location,
-                                                                            _domain.getDims(),
+                                                                            subRegionSize,
                                                                             _domain,
                                                                             subRegionOffset,
                                                                             subRegionSize,
@@ -641,12 +1165,78 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             }
         }
 
+        template <typename LocationTag>
+        void clearBoundaryFields(std::false_type, const LocationTag& location)
+        {
+            // Clear boundary field -- Only boundary and distances are required to be cleared,
+            // the velocity will be overwritten at the necessary locations
+
+            _boundaryField->clear(location, false);
+            _boundaryDistanceField->clear(location, 1e10);
+            _boundaryVelocityField->getAxis(0)->clear(location, 0.0f);
+            _boundaryVelocityField->getAxis(1)->clear(location, 0.0f);
+            _boundaryVelocityField->getAxis(2)->clear(location, 0.0f);
+        }
+
+        void clearBoundaryFields(std::true_type, const Compute::Location::HostTag& location)
+        {
+            // Cells outside of the active tiles read as solid and at rest, so the step takes the
+            // edges of the active region as walls. Their distance is below that of any cell of
+            // the region, so the normals of those walls point into it.
+
+            _boundaryField->setBackground(location, 1);
+            _boundaryField->fill(location, 0);
+            _boundaryDistanceField->setBackground(location, -1e10f);
+            _boundaryDistanceField->fill(location, 1e10f);
+
+            for (uint axis = 0; axis < Order; ++axis)
+                _boundaryVelocityField->getAxis(axis)->fill(location, 0.0f);
+        }
+
+        /**
+         * \brief Calls the given function with the region of cells (i.e. offset and size) each
+         *        enabled obstacle is rasterized into, narrow band included.
+         */
+        template <typename Function>
+        void forEachObstacleRegion(Function&& func) const
+        {
+            const float narrowBandThreshold = 2.0f * length(_domain.getDx());
+
+            const auto visitRegion = [&](const AABB& aabb)
+            {
+                const Coords minCoords = floor(_domain.getCellCoords(aabb.getMinPoint() - narrowBandThreshold));
+                const Coords maxCoords = ceil(_domain.getCellCoords(aabb.getMaxPoint() + narrowBandThreshold));
+
+                const Index minIndex = _domain.getCellIndex(minCoords, true);
+                const Index maxIndex = _domain.getCellIndex(maxCoords, true);
+
+                func(minIndex, maxIndex - minIndex + Index(1));
+            };
+
+            for (const auto& sphere : _sphereObstacles)
+            {
+                if (sphere->isEnabled())
+                    visitRegion(sphere->getCollider().getBoundingBox());
+            }
+
+            for (const auto& capsule : _capsuleObstacles)
+            {
+                if (capsule->isEnabled())
+                    visitRegion(capsule->getCollider().getBoundingBox());
+            }
+
+            for (const auto& box : _boxObstacles)
+            {
+                if (box->isEnabled())
+                    visitRegion(box->getCollider().getBoundingBox());
+            }
+        }
+
     public:
         template <typename LocationTag>
         void clear(const LocationTag& location)
         {
             _inkField.getFront()->clear(location, Float4(0.0f));
-            _temperatureField.getFront()->clear(location, 0.0f);
             _pressureField.getFront()->clear(location, 0.0f);
             _velocityField.getFront()->getAxis(0)->clear(location, 0.0f);
             _velocityField.getFront()->getAxis(1)->clear(location, 0.0f);
@@ -656,48 +1246,22 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             _boundaryVelocityField->getAxis(0)->clear(location, 0.0f);
             _boundaryVelocityField->getAxis(1)->clear(location, 0.0f);
             _boundaryVelocityField->getAxis(2)->clear(location, 0.0f);
+
+            if (_temperatureField.getFront())
+                _temperatureField.getFront()->clear(location, 0.0f);
         }
 
         template <typename LocationTag>
         void step(const LocationTag& location)
         {
-            // 0) Rasterize obstacles
-
-            rasterizeObstacles(location);
-
-            // 1) Advect property fields
-
-            advectScalarField(location, _inkField, _timestep);
-            applyDissipation(location, _inkField.getFront(), _timestep, _inkDissipation);
+            // The step graph is recorded on first use and replayed afterwards.
 
-            advectVelocityField(location, _timestep, _velocityDissipation);
+            Compute::TaskGraph::Ref& stepGraph = getStepGraph(location);
 
-            // 2) Internal & external body forces
-            
-            if (dot(_gravity, _gravity) > 0.0f)
-                applyGravityForces(location, _timestep);
-
-            if (_viscosity > 0.0f)
-                applyViscosityForces(location, _timestep, _viscosity);
-
-            // 3) Apply pressure projection
+            if (!stepGraph)
+                stepGraph = recordStep(location);
 
-            //enforceBoundaryConditions(location);    // enfore before (proper divergence)
-
-            computeDivergence(location);
-            computePressure(location, _timestep);
-            applyPressureForces(location, _timestep);
-
-            // 4) Enforce boundary conditions
-
-            enforceBoundaryConditions(location);
-
-            if (_confinement > 0.0f)
-            {
-                computeVorticity(location);
-                computeConfinement(location);
-                applyForces(location, _confinementField, _timestep);
-            }
+            stepGraph->execute();
         }
 
         template <typename LocationTag>
@@ -731,7 +1295,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                 std::cout << format("Writing velocity field to \"%s\"...", filename) << std::endl;
             }
 
-            if (vorticity)
+            if (vorticity && _vorticityField)
             {
                 const std::string filename = baseFilename + "_vorticity?.npy";
                 const std::string filenameX = baseFilename + "_vorticityX.npy";
@@ -745,6 +1309,213 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             }
         }
 
+    private:
+        /**
+         * \brief Resources touched by the tasks of the step graph.
+         */
+        enum StepResource : Compute::TaskGraph::Resource
+        {
+            InkResource,
+            VelocityResource,
+            NextVelocityResource,
+            PressureResource,
+            DivergenceResource,
+            BoundaryResource,
+            VorticityResource,
+            ConfinementResource
+        };
+
+        template <typename LocationTag>
+        Compute::TaskGraph::Ref recordStep(const LocationTag& location)
+        {
+            // Device work is serialized by the device anyway, so only host graphs run their
+            // independent tasks concurrently.
+
+            const bool concurrent = std::is_same<LocationTag, Compute::Location::HostTag>::value;
+            Compute::TaskGraph::Ref graph = Compute::TaskGraph::Create(concurrent);
+
+            // Sparse fluids first pick the tiles the step runs over, which every other field of
+            // the step is laid out on.
+
+            if (IsSparse)
+            {
+                graph->addTask("UpdateActiveTiles",
+                               { InkResource, VelocityResource },
+                               { VelocityResource, NextVelocityResource, PressureResource, DivergenceResource, BoundaryResource, VorticityResource, ConfinementResource },
+                               [this, location]
+                {
+                    updateActiveTiles(location);
+                });
+            }
+
+            // 0) Rasterize obstacles. Only the pressure projection and boundary enforcement
+            //    depend on them, so they overlap with the advection.
+
+            graph->addTask("RasterizeObstacles", {}, { BoundaryResource }, [this, location]
+            {
+                rasterizeObstacles(location);
+            });
+
+            // 1) Advect property fields. Both read the current velocity, and write disjoint
+            //    fields. The velocity is swapped once both of them are done.
+
+            graph->addTask("AdvectInk", { VelocityResource }, { InkResource }, [this, location]
+            {
+                advectScalarField(location, _inkField, _timestep, _inkDissipation);
+            });
+
+            graph->addTask("AdvectVelocity", { VelocityResource }, { NextVelocityResource }, [this, location]
+            {
+                advectVelocityField(location, _timestep, _velocityDissipation);
+            });
+
+            graph->addTask("SwapVelocity", {}, { VelocityResource, NextVelocityResource }, [this]
+            {
+                swapVelocityField();
+            });
+
+            // 2) Internal & external body forces (gravity is applied along with the advection)
+
+            graph->addTask("ApplyViscosity", { VelocityResource }, { VelocityResource, NextVelocityResource }, [this, location]
+            {
+                if (_viscosity > 0.0f)
+                    applyViscosityForces(location, _timestep, _viscosity);
+            });
+
+            // 3) Apply pressure projection
+
+            graph->addTask("ComputeDivergence", { VelocityResource }, { DivergenceResource }, [this, location]
+            {
+                computeDivergence(location);
+            });
+
+            graph->addTask("ComputePressure", { DivergenceResource, BoundaryResource }, { PressureResource }, [this, location]
+            {
+                computePressure(location, _timestep);
+            });
+
+            graph->addTask("ApplyPressure", { PressureResource, BoundaryResource }, { VelocityResource }, [this, location]
+            {
+                applyPressureForces(location, _timestep);
+            });
+
+            // 4) Enforce boundary conditions
+
+            graph->addTask("EnforceBoundaries", { BoundaryResource }, { VelocityResource, NextVelocityResource }, [this, location]
+            {
+                enforceBoundaryConditions(location);
+            });
+
+            graph->addTask("ComputeVorticity", { VelocityResource }, { VorticityResource }, [this, location]
+            {
+                if (_confinement > 0.0f)
+                {
+                    requireConfinementFields();
+                    computeVorticity(location);
+                }
+            });
+
+            graph->addTask("ComputeConfinement", { VorticityResource }, { ConfinementResource }, [this, location]
+            {
+                if (_confinement > 0.0f)
+                    computeConfinement(location);
+            });
+
+            graph->addTask("ApplyConfinement", { ConfinementResource }, { VelocityResource }, [this, location]
+            {
+                if (_confinement > 0.0f)
+                    applyForces(location, _confinementField, _timestep);
+            });
+
+            return graph;
+        }
+
+        static std::size_t getHostStorageSize(const Domain& domain, Compute::BufferFlags hostFlags, FluidPressureSolver pressureSolver)
+        {
+            const std::size_t pressureFieldCount = pressureSolver == FluidPressureSolver::Jacobi ? 2 : 1;
+
+            return 2 * InkField::getHostStorageSize(domain.getDims(), hostFlags)
+                 + pressureFieldCount * PressureField::getHostStorageSize(domain.getDims(), getPressureFlags(hostFlags))
+                 + 2 * VelocityField::getHostStorageSize(domain, true, hostFlags)
+                 + VelocityDivergenceField::getHostStorageSize(domain.getDims(), hostFlags)
+                 + BoundaryField::getHostStorageSize(domain.getDims(), hostFlags)
+                 + BoundaryDistanceField::getHostStorageSize(domain.getDims(), hostFlags)
+                 + BoundaryVelocityField::getHostStorageSize(domain, false, hostFlags);
+        }
+
+        static Compute::BufferFlags getPressureFlags(Compute::BufferFlags hostFlags)
+        {
+            // Sparse pressure fields have no halo, their kernels reading the domain bounds.
+
+            return IsSparse ? hostFlags : hostFlags | Compute::BufferFlags::Halo1;
+        }
+
+        /**
+         * \brief Creates a zero-filled scalar field of an optional feature, taken from the host
+         *        pool on its own so that it goes back to it once released. Sparse fields start
+         *        with the active tiles of the step.
+         */
+        template <typename Field>
+        typename Field::Ref createScalarField()
+        {
+            typename Field::Ref field = Field::Create(_domain, _hostPool, _hostBufferFlags);
+
+            #if HF_CPU_ONLY == false
+            field->clear(Compute::Location::Device, typename Field::Value(0));
+            #endif
+
+            setActiveTiles(*field);
+
+            return field;
+        }
+
+        /**
+         * \brief Vector counterpart of createScalarField.
+         */
+        template <typename Field>
+        typename Field::Ref createVectorField(bool staggered)
+        {
+            typename Field::Ref field = Field::Create(_domain, staggered, _hostPool, _hostBufferFlags);
+
+            #if HF_CPU_ONLY == false
+            for (uint i = 0; i < Order; ++i)
+                field->getAxis(i)->clear(Compute::Location::Device, 0.0f);
+            #endif
+
+            setActiveTiles(*field);
+
+            return field;
+        }
+
+        void requireConfinementFields()
+        {
+            if (_vorticityField)
+                return;
+
+            _vorticityField     = createVectorField<VorticityField>(false);
+            _vorticityNormField = createScalarField<VorticityNormField>();
+            _confinementField   = createVectorField<ConfinementField>(false);
+        }
+
+        void releaseConfinementFields()
+        {
+            _vorticityField     = nullptr;
+            _vorticityNormField = nullptr;
+            _confinementField   = nullptr;
+        }
+
+        Compute::TaskGraph::Ref& getStepGraph(const Compute::Location::HostTag&)
+        {
+            return _hostStepGraph;
+        }
+
+        #if HF_CPU_ONLY == false
+        Compute::TaskGraph::Ref& getStepGraph(const Compute::Location::DeviceTag&)
+        {
+            return _deviceStepGraph;
+        }
+        #endif
+
     private:
         Domain                            _domain;
         DomainBounds                      _domainBounds;
@@ -755,11 +1526,20 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         float                             _viscosity;
         float                             _confinement;
         uint                              _jacobiSteps;
+        FluidPressureSolver               _pressureSolver;
+        float                             _pressureRelaxation;
         Float4                            _inkDissipation;
         float                             _velocityDissipation;
         float                             _pressureDissipation;
+        float                             _inkPruneThreshold;
+        float                             _velocityPruneThreshold;
 
-        TripleBuffer<InkFieldRef>         _inkField;
+        Compute::MemoryResource::Ref      _hostPool;
+        Compute::BufferFlags              _hostBufferFlags;
+        bool                              _temperatureEnabled;
+        bool                              _pressureGradNormEnabled;
+
+        DoubleBuffer<InkFieldRef>         _inkField;
         DoubleBuffer<TemperatureFieldRef> _temperatureField;
         DoubleBuffer<PressureFieldRef>    _pressureField;
         PressureGradNormFieldRef          _pressureGradNormField;
@@ -771,11 +1551,17 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         VorticityFieldRef                 _vorticityField;
         VorticityNormFieldRef             _vorticityNormField;
         ConfinementFieldRef               _confinementField;
+        std::vector<Index>                _activeTiles;
             
         std::vector<BoxObstacleRef>       _boxObstacles;
         std::vector<SphereObstacleRef>    _sphereObstacles;
         std::vector<CapsuleObstacleRef>   _capsuleObstacles;
 
+        Compute::TaskGraph::Ref           _hostStepGraph;
+        #if HF_CPU_ONLY == false
+        Compute::TaskGraph::Ref           _deviceStepGraph;
+        #endif
+
     public:
         static Ref Create(const Params& params)
         {
@@ -43,7 +43,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             return _dx;
         }
 
-        HF_HDINLINE const Coords& getOneOverDx() const
+        HF_HDINLINE Coords getOneOverDx() const
         {
             return 1.0f / _dx;
         }
@@ -87,7 +87,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         {
             Coords nodeCoords(coords);
 
-            for (uint i = 0; i < axis;  ++i)
+            for (int i = 0; i < axis;  ++i)
                 nodeCoords[i] += 0.5f;
 
             for (uint i = axis + 1; i < Order; ++i)
@@ -116,7 +116,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         {
             Coords nodeCoords = getNodeCoords(point);
 
-            for (uint i = 0; i < axis;  ++i)
+            for (int i = 0; i < axis;  ++i)
                 nodeCoords[i] -= 0.5f;
 
             for (uint i = axis + 1; i < Order; ++i) 
@@ -22,9 +22,8 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
     public:
         static constexpr uint Order = _Order;
 
-        using Fluid    = Fluid<Order>;
-        using FluidRef = typename Fluid::Ref;
-        using Coords   = FloatN<_Order>;
+        using Coords = FloatN<_Order>;
+        using Index  = IntN<_Order>;
 
     public:
         FluidEmitter() = default;
@@ -136,13 +135,19 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         }
 
     public:
-        template <typename LocationTag>
-        void emit(const FluidRef& fluid, const LocationTag& location) const
+        template <typename Storage, typename LocationTag>
+        void emit(const Ref<Fluid<Order, Storage>>& fluid, const LocationTag& location) const
         {
-            const auto threadCount = fluid->getDomain().getDimsOfNodesGrid();
+            // Ink and velocity are only written within the radius of the emitter.
 
-            Compute::Kernel::execute<Order, EmissionKernel>(location,
-                                                            threadCount,
+            const Index minIdx = Index(floor(fluid->getDomain().getCellCoords(_center - _radius)));
+            const Index maxIdx = Index(ceil(fluid->getDomain().getCellCoords(_center + _radius)));
+
+            fluid->activateRegion(location, minIdx, maxIdx - minIdx + 1);
+
+            fluid->template executeOnRegion<EmissionKernel>(location,
+                                                            minIdx,
+                                                            maxIdx - minIdx + 1,
                                                             fluid->getDomain(),
                                                             fluid->getInkField()->getAccessor(location),
                                                             fluid->getVelocityField()->getAccessor(location),
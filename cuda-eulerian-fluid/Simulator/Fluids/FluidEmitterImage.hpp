@@ -17,9 +17,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
     public:
         static constexpr uint Order = _Order;
 
-        using Fluid    = Fluid<Order>;
-        using FluidRef = typename Fluid::Ref;
-        using Index    = IntN<Order>;
+        using Index = IntN<Order>;
 
     public:
         FluidEmitterImage() = default;
@@ -36,17 +34,21 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                         reinterpret_cast<void*>(data),
                         sizeof(uchar) * 4 * width * height);
 
+            #if HF_CPU_ONLY == false
             _image->copyHostToDevice();
+            #endif
         }
 
     public:
-        template <typename LocationTag>
-        void emit(const FluidRef& fluid, const LocationTag& location) const
+        template <typename Storage, typename LocationTag>
+        void emit(const Ref<Fluid<Order, Storage>>& fluid, const LocationTag& location) const
         {
             // FIXME: Assumes 3D fluid,
 
             const auto threadCount = Int3(_size, _extrusion);
 
+            fluid->activateRegion(location, _offset, threadCount);
+
             Compute::Kernel::execute<Order, EmissionImageKernel>(location,
                                                                  threadCount,
                                                                 fluid->getInkField()->getAccessor(location),
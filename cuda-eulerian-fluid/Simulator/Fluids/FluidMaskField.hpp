@@ -0,0 +1,220 @@
+﻿#ifndef HF_SIMULATOR_FLUID_MASK_FIELD_HPP
+#define HF_SIMULATOR_FLUID_MASK_FIELD_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Buffers/Buffer.hpp>
+#include <Simulator/Compute/Buffers/BitMaskAccessor.hpp>
+#include <Simulator/Compute/BulkOps.hpp>
+#include <Simulator/Compute/Copy.hpp>
+#include <Simulator/Fluids/FluidDomain.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Simulator)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Field of one bit per cell, packed along the X axis into 32-bit words (see
+     *        Compute::BitMaskAccessor). Takes an eighth of the memory of a uchar field, and lets
+     *        kernels read the bits of a whole run of cells at once. Device fields are always
+     *        kept in buffers, as bits can't be addressed through surfaces.
+     */
+    template <uint _Order>
+    class FluidMaskField
+    {
+    public:
+        static constexpr uint Order = _Order;
+
+        // Basic information regarding the grid
+
+        using Ref                 = HF::Ref<FluidMaskField>;
+        using Value               = uchar;
+        using Word                = uint;
+        using Domain              = FluidDomain<_Order>;
+        using Dims                = IntN<_Order>;
+        using Index               = IntN<_Order>;
+
+        // Host-side datatypes
+
+        using HostBuffer          = Compute::HostBuffer<Order, Word>;
+        using HostBufferRef       = typename HostBuffer::Ref;
+        using HostAccessor        = Compute::BitMaskAccessor<HostBuffer>;
+        using HostConstAccessor   = Compute::BitMaskConstAccessor<HostBuffer>;
+
+        // Device-side datatypes
+
+        #if HF_CPU_ONLY == false
+        using DeviceBuffer        = Compute::DeviceBuffer<Order, Word>;
+        using DeviceBufferRef     = typename DeviceBuffer::Ref;
+        using DeviceAccessor      = Compute::BitMaskAccessor<DeviceBuffer>;
+        using DeviceConstAccessor = Compute::BitMaskConstAccessor<DeviceBuffer>;
+        #endif
+
+        static constexpr uint WordBits = HostConstAccessor::WordBits;
+
+    protected:
+        FluidMaskField(const Dims& dims, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+            : _dims(dims)
+        {
+            // Allocate host-side words. Buffers acquired from a given resource start zeroed.
+
+            if (hostResource != nullptr)
+                _hostBuffer = HostBuffer::Create(getWordDims(dims), hostResource, true, hostFlags);
+            else
+                _hostBuffer = HostBuffer::Create(getWordDims(dims), hostFlags);
+
+            #if HF_CPU_ONLY == false
+            _deviceBuffer = DeviceBuffer::Create(getWordDims(dims));
+            #endif
+        }
+
+        FluidMaskField(const Domain& domain, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+            : FluidMaskField(domain.getDims(), hostResource, hostFlags)
+        {
+        }
+
+    public:
+        const Dims& getDims() const
+        {
+            return _dims;
+        }
+
+        HostConstAccessor getConstAccessor(const Compute::Location::HostTag&) const
+        {
+            return HostConstAccessor(_hostBuffer->getConstAccessor(), _dims);
+        }
+
+        HostAccessor getAccessor(const Compute::Location::HostTag&)
+        {
+            return HostAccessor(_hostBuffer->getAccessor(), _dims);
+        }
+
+        #if HF_CPU_ONLY == false
+        DeviceConstAccessor getConstAccessor(const Compute::Location::DeviceTag&) const
+        {
+            return DeviceConstAccessor(_deviceBuffer->getConstAccessor(), _dims);
+        }
+
+        DeviceAccessor getAccessor(const Compute::Location::DeviceTag&)
+        {
+            return DeviceAccessor(_deviceBuffer->getAccessor(), _dims);
+        }
+        #endif
+
+        /**
+         * \brief Sets (value != 0) or clears every bit of the mask.
+         */
+        void clear(const Compute::Location::HostTag&, const Value& value)
+        {
+            Compute::BulkOps::fill(_hostBuffer, value != 0 ? ~Word(0) : Word(0));
+        }
+
+        #if HF_CPU_ONLY == false
+        void clear(const Compute::Location::DeviceTag&, const Value& value)
+        {
+            Compute::BulkOps::fill(_deviceBuffer, value != 0 ? ~Word(0) : Word(0));
+        }
+        #endif
+
+        void clear(const Value& value)
+        {
+            clear(Compute::Location::Host, value);
+            #if HF_CPU_ONLY == false
+            clear(Compute::Location::Device, value);
+            #endif
+        }
+
+        #if HF_CPU_ONLY == false
+        void copyHostToDevice()
+        {
+            Compute::Copy::bufferToBuffer(_hostBuffer, _deviceBuffer);
+        }
+
+        void copyDeviceToHost()
+        {
+            Compute::Copy::bufferToBuffer(_deviceBuffer, _hostBuffer);
+        }
+        #endif
+
+    public:
+        Dims             _dims;
+        HostBufferRef    _hostBuffer;
+        #if HF_CPU_ONLY == false
+        DeviceBufferRef  _deviceBuffer;
+        #endif
+
+    public:
+        static Ref Create(const Domain& domain)
+        {
+            return Ref(new FluidMaskField(domain));
+        }
+
+        static Ref Create(const Dims& dims)
+        {
+            return Ref(new FluidMaskField(dims));
+        }
+
+        /**
+         * \brief Creates a new mask whose host storage is acquired, zero-filled, from the given
+         *        memory resource.
+         * \param domain Domain of the mask.
+         * \param hostResource Memory resource to acquire the host storage from.
+         * \param hostFlags Flags of the host buffer.
+         */
+        static Ref Create(const Domain& domain, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidMaskField(domain, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Creates a new mask whose host storage is acquired, zero-filled, from the given
+         *        memory resource.
+         * \param dims Dimensions of the mask.
+         * \param hostResource Memory resource to acquire the host storage from.
+         * \param hostFlags Flags of the host buffer.
+         */
+        static Ref Create(const Dims& dims, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidMaskField(dims, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Returns the dimensions of the buffer holding the words of a mask with the given
+         *        dimensions, i.e. with rows padded to whole words.
+         */
+        static Dims getWordDims(const Dims& dims)
+        {
+            Dims wordDims = dims;
+            wordDims[0] = (dims[0] + int(WordBits) - 1) / int(WordBits);
+
+            return wordDims;
+        }
+
+        /**
+         * \brief Returns the size of the host storage of a mask with the given dimensions, in
+         *        bytes, including the padding required to place it after another one.
+         * \param dims Dimensions of the mask.
+         * \param hostFlags Flags of the host buffer.
+         */
+        static std::size_t getHostStorageSize(const Dims& dims, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            const std::size_t alignment = HostBuffer::Alignment;
+            return (HostBuffer::getStorageSize(getWordDims(dims), hostFlags) + alignment - 1) / alignment * alignment;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    template <uint O> using FluidMaskFieldRef = typename FluidMaskField<O>::Ref;
+
+    using FluidMaskField1 = FluidMaskField<1>;
+    using FluidMaskField2 = FluidMaskField<2>;
+    using FluidMaskField3 = FluidMaskField<3>;
+    using FluidMaskField1Ref = FluidMaskFieldRef<1>;
+    using FluidMaskField2Ref = FluidMaskFieldRef<2>;
+    using FluidMaskField3Ref = FluidMaskFieldRef<3>;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Simulator)
+
+#endif /* HF_SIMULATOR_FLUID_MASK_FIELD_HPP */
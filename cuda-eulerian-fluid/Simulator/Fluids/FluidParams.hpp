@@ -2,6 +2,8 @@
 #define HF_SIMULATION_FLUID_PARAMS_HPP
 
 #include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Buffers/BufferFlags.hpp>
+#include <Simulator/Fluids/FluidPressureSolver.hpp>
 #include <Simulator/Geometry/Primitives/AABB.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Simulator)
@@ -29,6 +31,50 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         Float4 inkDissipation;
         float  velocityDissipation;
         float  pressureDissipation;
+
+        /**
+         * \brief Flags of the host buffers of every field (e.g. row alignment or huge pages).
+         */
+        Compute::BufferFlags hostBufferFlags = Compute::BufferFlags::Default;
+
+        /**
+         * \brief Tiles of sparse ink fields (see FluidStorage::Sparse) whose ink all stays below
+         *        this magnitude are released after each step.
+         */
+        float inkPruneThreshold = 1e-4f;
+
+        /**
+         * \brief Tiles of sparse velocity fields whose velocity all stays below this magnitude
+         *        are released after each step, the fluid there coming to rest. The pressure
+         *        projection sets the whole fluid in motion, if faintly, so higher thresholds keep
+         *        the region the step sweeps tighter.
+         */
+        float velocityPruneThreshold = 1e-4f;
+
+        /**
+         * \brief Whether to allocate the temperature fields, which the step itself leaves alone.
+         */
+        bool temperature = false;
+
+        /**
+         * \brief Whether to store the norm of the pressure gradient of each step. Vorticity fields
+         *        are likewise only allocated when confinement is greater than zero.
+         */
+        bool pressureGradNorm = false;
+
+        /**
+         * \brief Solver of the pressure, running jacobiSteps iterations per step either way.
+         *        Red-black iterations update the pressure in place, so the fluid then keeps a
+         *        single pressure field.
+         */
+        FluidPressureSolver pressureSolver = FluidPressureSolver::Jacobi;
+
+        /**
+         * \brief Over-relaxation factor of red-black iterations, within (0, 2). One makes them
+         *        plain Gauss-Seidel iterations, and larger factors converge faster on smooth
+         *        pressure fields.
+         */
+        float pressureRelaxation = 1.7f;
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
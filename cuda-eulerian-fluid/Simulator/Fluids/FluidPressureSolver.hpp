@@ -0,0 +1,33 @@
+﻿#ifndef HF_SIMULATOR_FLUID_PRESSURE_SOLVER_HPP
+#define HF_SIMULATOR_FLUID_PRESSURE_SOLVER_HPP
+
+#include <Simulator/Simulator.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Simulator)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Iterative method solving the pressure of a fluid (see FluidParams::pressureSolver).
+     */
+    enum struct FluidPressureSolver
+    {
+        /**
+         * \brief Jacobi iterations, reading the pressure of the previous iteration and writing
+         *        the next one into a second field (see PressureJacobiKernel).
+         */
+        Jacobi,
+
+        /**
+         * \brief Red-black Gauss-Seidel with successive over-relaxation, updating the pressure
+         *        in place one half of a checkerboard of cells at a time (see
+         *        PressureRedBlackKernel). Converges in a fraction of the iterations of Jacobi.
+         */
+        RedBlackSOR
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Simulator)
+
+#endif /* HF_SIMULATOR_FLUID_PRESSURE_SOLVER_HPP */
@@ -3,17 +3,28 @@
 
 #include <Simulator/Simulator.hpp>
 #include <Simulator/Compute/Buffers/Buffer.hpp>
+#include <Simulator/Compute/Buffers/PlanarBuffer.hpp>
+#include <Simulator/Compute/BulkOps.hpp>
+#include <Simulator/Compute/Copy.hpp>
+#include <Simulator/Fluids/FluidDomain.hpp>
+
+#if HF_CPU_ONLY == false
 #include <Simulator/Compute/Arrays/Array.hpp>
 #include <Simulator/Compute/Surfaces/Surface.hpp>
 #include <Simulator/Compute/Textures/Texture.hpp>
-#include <Simulator/Compute/Copy.hpp>
-#include <Simulator/Fluids/FluidDomain.hpp>
+#endif
 
 HF_BEGIN_NAMESPACE(HF, Simulator)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint _Order, typename _Value>
+    /**
+     * \brief Scalar field kept in memory as the given storage type (see Compute::BufferStorage),
+     *        and accessed as its value type. Device fields stored as arrays keep the value type.
+     *        Vector values stored as Compute::PlanarStorage are kept on the host as a plane per
+     *        component (see Compute::PlanarBuffer), and as values on the device.
+     */
+    template <uint _Order, typename _Value, typename _Storage = _Value>
     class FluidScalarField
     {
     public:
@@ -21,8 +32,10 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
         // Basic information regarding the grid
 
-        using Ref                 = Ref<FluidScalarField>;
+        using Ref                 = HF::Ref<FluidScalarField>;
         using Value               = _Value;
+        using Storage             = _Storage;
+        using PlanarTraits        = Compute::PlanarStorageTraits<_Storage>;
         using Domain              = FluidDomain<_Order>;
         using Dims                = IntN<_Order>;
         using Index               = IntN<_Order>;
@@ -30,7 +43,9 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
         // Host-side datatypes
 
-        using HostBuffer          = Compute::HostBuffer<Order, Value>;
+        using HostBuffer          = typename std::conditional<PlanarTraits::IsPlanar,
+                                                              Compute::PlanarBuffer<Order, Value, typename PlanarTraits::Scalar>,
+                                                              Compute::HostBuffer<Order, Value, Storage>>::type;
         using HostBufferRef       = typename HostBuffer::Ref;
         using HostAccessor        = typename HostBuffer::Accessor;
         using HostConstAccessor   = typename HostBuffer::ConstAccessor;
@@ -38,6 +53,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
         // Device-side datatypes
 
+        #if HF_CPU_ONLY == false
         using DeviceArray         = Compute::Array<Order, Value>;
         #if HF_DEVICE_FIELDS_AS_ARRAYS == true
         using DeviceArrayRef      = typename DeviceArray::Ref;
@@ -49,24 +65,29 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using DeviceConstAccessor = typename DeviceSurface::ConstAccessor;
         using DeviceSampler       = typename DeviceTexture::Sampler;
         #else
-        using DeviceBuffer        = Compute::HostBuffer<Order, Value>;
+        using DeviceBuffer        = Compute::HostBuffer<Order, Value, typename std::conditional<PlanarTraits::IsPlanar, Value, Storage>::type>;
         using DeviceBufferRef     = typename DeviceBuffer::Ref;
         using DeviceAccessor      = typename DeviceBuffer::Accessor;
         using DeviceConstAccessor = typename DeviceBuffer::ConstAccessor;
         using DeviceSampler       = typename DeviceBuffer::Sampler;
         #endif
+        #endif
         
     protected:
-        FluidScalarField(const Dims& dims)
+        FluidScalarField(const Dims& dims, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
             : _dims(dims)
         {
-            // Allocate host-side buffer.
+            // Allocate host-side buffer. Buffers acquired from a given resource start zeroed.
 
-            _hostBuffer  = HostBuffer::Create(dims, Compute::BufferFlags::Default);
+            if (hostResource != nullptr)
+                _hostBuffer = HostBuffer::Create(dims, hostResource, true, hostFlags);
+            else
+                _hostBuffer = HostBuffer::Create(dims, hostFlags);
 
             // Allocate device-side array and corresponding data structures.
 
-            #if HF_DEVICE_FIELDS_AS_ARRAYS == true
+            #if HF_CPU_ONLY == true
+            #elif HF_DEVICE_FIELDS_AS_ARRAYS == true
             const bool isFloatingPointType = Traits<Value>::IsFloatingPoint;
 
             _deviceArray = DeviceArray::Create(dims,
@@ -88,8 +109,8 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             #endif
         }
 
-        FluidScalarField(const Domain& domain)
-            : FluidScalarField(domain.getDims())
+        FluidScalarField(const Domain& domain, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+            : FluidScalarField(domain.getDims(), hostResource, hostFlags)
         {
         }
 
@@ -120,6 +141,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                                            true);
         }
 
+        #if HF_CPU_ONLY == false
         DeviceConstAccessor getConstAccessor(const Compute::Location::DeviceTag&) const
         {
             #if HF_DEVICE_FIELDS_AS_ARRAYS == true
@@ -152,27 +174,70 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                                              true);
             #endif
         }
+        #endif
 
         void clear(const Compute::Location::HostTag&, const Value& value)
         {
-            Compute::Copy::valueToBuffer(value, _hostBuffer);
+            Compute::BulkOps::fill(_hostBuffer, value);
         }
 
+        #if HF_CPU_ONLY == false
+
         void clear(const Compute::Location::DeviceTag&, const Value& value)
         {
             #if HF_DEVICE_FIELDS_AS_ARRAYS == true
             Compute::Copy::valueToArray(value, _deviceArray);
             #else
-            Compute::Copy::valueToBuffer(value, _deviceBuffer);
+            Compute::BulkOps::fill(_deviceBuffer, value);
+            #endif
+        }
+        #endif
+
+        /**
+         * \brief Multiplies every value of the field by the given factor, either a scalar or a
+         *        value (i.e. one factor per component).
+         */
+        template <typename Factor>
+        void scale(const Compute::Location::HostTag&, const Factor& factor)
+        {
+            Compute::BulkOps::scale(_hostBuffer, factor);
+        }
+
+        /**
+         * \brief Returns the largest magnitude of the values of a field of scalars.
+         */
+        Value getMaxAbs(const Compute::Location::HostTag&) const
+        {
+            return Compute::BulkOps::maxAbs(_hostBuffer);
+        }
+
+        #if HF_CPU_ONLY == false
+
+        template <typename Factor>
+        void scale(const Compute::Location::DeviceTag&, const Factor& factor)
+        {
+            #if HF_DEVICE_FIELDS_AS_ARRAYS == true
+            Compute::Kernel::execute<Order, Compute::BulkOps::Detail::ScaleKernel>(Compute::Location::Device,
+                                                                                  _dims,
+                                                                                  Compute::CopyValueRegion<Order>(_dims),
+                                                                                  getAccessor(Compute::Location::Device),
+                                                                                  factor);
+            #else
+            Compute::BulkOps::scale(_deviceBuffer, factor);
             #endif
         }
+        #endif
 
         void clear(const Value& value)
         {
             clear(Compute::Location::Host, value);
+            #if HF_CPU_ONLY == false
             clear(Compute::Location::Device, value);
+            #endif
         }
 
+        #if HF_CPU_ONLY == false
+
         void copyHostToDevice()
         {
             #if HF_DEVICE_FIELDS_AS_ARRAYS == true
@@ -243,17 +308,20 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             
             return false;
         }
+        #endif
 
         bool loadFromFile(const Compute::Location::HostTag&, const std::string& filename) const
         {
             return _hostBuffer->loadFromFile(filename);
         }
 
+        #if HF_CPU_ONLY == false
         bool saveToFile(const Compute::Location::DeviceTag&, const std::string& filename)
         {
             copyDeviceToHost();
             return saveToFile(Compute::Location::Host, filename);
         }
+        #endif
 
         bool saveToFile(const Compute::Location::HostTag&, const std::string& filename) const
         {
@@ -263,7 +331,8 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
     public:
         Dims             _dims;
         HostBufferRef    _hostBuffer;
-        #if HF_DEVICE_FIELDS_AS_ARRAYS == true
+        #if HF_CPU_ONLY == true
+        #elif HF_DEVICE_FIELDS_AS_ARRAYS == true
         DeviceArrayRef   _deviceArray;
         DeviceSurfaceRef _deviceSurface;
         DeviceTexturePtr _deviceTexture;
@@ -281,11 +350,47 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         {
             return Ref(new FluidScalarField(dims));
         }
+
+        /**
+         * \brief Creates a new field whose host storage is acquired, zero-filled, from the given
+         *        memory resource.
+         * \param domain Domain of the field.
+         * \param hostResource Memory resource to acquire the host storage from.
+         * \param hostFlags Flags of the host buffer (e.g. BufferFlags::AlignRows).
+         */
+        static Ref Create(const Domain& domain, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidScalarField(domain, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Creates a new field whose host storage is acquired, zero-filled, from the given
+         *        memory resource.
+         * \param dims Dimensions of the field.
+         * \param hostResource Memory resource to acquire the host storage from.
+         * \param hostFlags Flags of the host buffer (e.g. BufferFlags::AlignRows).
+         */
+        static Ref Create(const Dims& dims, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidScalarField(dims, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Returns the size of the host storage of a field with the given dimensions, in
+         *        bytes, including the padding required to place it after another one.
+         * \param dims Dimensions of the field.
+         * \param hostFlags Flags of the host buffer.
+         */
+        static std::size_t getHostStorageSize(const Dims& dims, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            const std::size_t alignment = HostBuffer::Alignment;
+            return (HostBuffer::getStorageSize(dims, hostFlags) + alignment - 1) / alignment * alignment;
+        }
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint O, typename V> using FluidScalarFieldRef = typename FluidScalarField<O, V>::Ref;
+    template <uint O, typename V, typename S = V> using FluidScalarFieldRef = typename FluidScalarField<O, V, S>::Ref;
 
     template <typename V> using FluidScalarField1 = FluidScalarField<1, V>;
     template <typename V> using FluidScalarField2 = FluidScalarField<2, V>;
@@ -0,0 +1,263 @@
+﻿#ifndef HF_SIMULATOR_FLUID_SPARSE_SCALAR_FIELD_HPP
+#define HF_SIMULATOR_FLUID_SPARSE_SCALAR_FIELD_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Location.hpp>
+#include <Simulator/Compute/Buffers/SparseBuffer.hpp>
+#include <Simulator/Fluids/FluidDomain.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Simulator)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Scalar field only storing the tiles of cells holding something other than its
+     *        background value (see Compute::SparseBuffer), accessed and sampled like
+     *        FluidScalarField. Kernels writing into it must be launched over its active tiles
+     *        (see Compute::Kernel::executeOnTiles), which are only kept on the host.
+     * \tparam _Order Order (dimensions) of the field.
+     * \tparam _Value Type of the values.
+     * \tparam _TileSize Extent of the tiles along each axis.
+     */
+    template <uint _Order, typename _Value, uint _TileSize = 8>
+    class FluidSparseScalarField
+    {
+    public:
+        static constexpr uint Order    = _Order;
+        static constexpr uint TileSize = _TileSize;
+
+        // Basic information regarding the grid
+
+        using Ref               = HF::Ref<FluidSparseScalarField>;
+        using Value             = _Value;
+        using Domain            = FluidDomain<_Order>;
+        using Dims              = IntN<_Order>;
+        using Index             = IntN<_Order>;
+
+        // Host-side datatypes
+
+        using HostBuffer        = Compute::SparseBuffer<Order, Value, TileSize>;
+        using HostBufferRef     = typename HostBuffer::Ref;
+        using HostAccessor      = typename HostBuffer::Accessor;
+        using HostConstAccessor = typename HostBuffer::ConstAccessor;
+        using HostSampler       = typename HostBuffer::Sampler;
+
+    protected:
+        FluidSparseScalarField(const Dims& dims, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+            : _dims(dims)
+        {
+            // Allocate the tile table. Tables acquired from a given resource start zeroed,
+            // i.e. with every tile inactive.
+
+            if (hostResource != nullptr)
+                _hostBuffer = HostBuffer::Create(dims, hostResource, true, hostFlags);
+            else
+                _hostBuffer = HostBuffer::Create(dims, hostFlags);
+        }
+
+        FluidSparseScalarField(const Domain& domain, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+            : FluidSparseScalarField(domain.getDims(), hostResource, hostFlags)
+        {
+        }
+
+    public:
+        const Dims& getDims() const
+        {
+            return _dims;
+        }
+
+        /**
+         * \brief Returns the dimensions of the tiles, in cells.
+         */
+        Dims getTileDims() const
+        {
+            return Dims(int(TileSize));
+        }
+
+        HostConstAccessor getConstAccessor(const Compute::Location::HostTag&) const
+        {
+            return _hostBuffer->getConstAccessor();
+        }
+
+        HostAccessor getAccessor(const Compute::Location::HostTag&)
+        {
+            return _hostBuffer->getAccessor();
+        }
+
+        HostSampler getSampler(const Compute::Location::HostTag&) const
+        {
+            const bool isFloatingPointType = Traits<Value>::IsFloatingPoint;
+
+            return _hostBuffer->getSampler(Compute::BufferAddressMode::Clamp,
+                                           isFloatingPointType ? Compute::BufferFilterMode::LinearFilter
+                                                               : Compute::BufferFilterMode::PointFilter,
+                                           Compute::BufferCoordMode::BufferSpace,
+                                           true);
+        }
+
+        /**
+         * \brief Returns the indices of the active tiles.
+         */
+        const std::vector<Index>& getActiveTiles(const Compute::Location::HostTag&) const
+        {
+            return _hostBuffer->getActiveTiles();
+        }
+
+        /**
+         * \brief Activates the tiles overlapping the given region of cells, so that they can be
+         *        written.
+         */
+        void activateRegion(const Compute::Location::HostTag&, const Index& offset, const Dims& size)
+        {
+            _hostBuffer->activateRegion(offset, size);
+        }
+
+        /**
+         * \brief Makes the active tiles those of another field, grown by the given no. of tiles
+         *        (see Compute::SparseBuffer::matchTiles).
+         */
+        void matchTiles(const Compute::Location::HostTag&, const FluidSparseScalarField& other, int dilation)
+        {
+            _hostBuffer->matchTiles(*other._hostBuffer, dilation);
+        }
+
+        /**
+         * \brief Makes the given tiles the active ones, releasing the rest (see
+         *        Compute::SparseBuffer::setActiveTiles).
+         */
+        void setActiveTiles(const Compute::Location::HostTag&, const std::vector<Index>& tiles)
+        {
+            _hostBuffer->setActiveTiles(tiles);
+        }
+
+        /**
+         * \brief Releases the tiles whose values are all within the given distance of the
+         *        background value (see Compute::SparseBuffer::pruneTiles).
+         */
+        uint pruneTiles(const Compute::Location::HostTag&, float threshold)
+        {
+            return _hostBuffer->pruneTiles(threshold);
+        }
+
+        /**
+         * \brief Releases every tile, so that the whole field reads as the given value.
+         */
+        void clear(const Compute::Location::HostTag&, const Value& value)
+        {
+            _hostBuffer->clear(value);
+        }
+
+        void clear(const Value& value)
+        {
+            clear(Compute::Location::Host, value);
+        }
+
+        /**
+         * \brief Sets the value read outside of the active tiles, leaving them as they are.
+         */
+        void setBackground(const Compute::Location::HostTag&, const Value& value)
+        {
+            _hostBuffer->setBackground(value);
+        }
+
+        /**
+         * \brief Sets every value of the active tiles, leaving the background value as it is.
+         */
+        void fill(const Compute::Location::HostTag&, const Value& value)
+        {
+            _hostBuffer->fill(value);
+        }
+
+        /**
+         * \brief Multiplies every value of the field, the background one included, by the given
+         *        factor.
+         */
+        template <typename Factor>
+        void scale(const Compute::Location::HostTag&, const Factor& factor)
+        {
+            _hostBuffer->scale(factor);
+        }
+
+        /**
+         * \brief Returns the largest magnitude of the values of a field of scalars.
+         */
+        Value getMaxAbs(const Compute::Location::HostTag&) const
+        {
+            return _hostBuffer->getMaxAbs();
+        }
+
+        bool saveToFile(const Compute::Location::HostTag&, const std::string& filename) const
+        {
+            return _hostBuffer->saveToFile(filename);
+        }
+
+    public:
+        Dims          _dims;
+        HostBufferRef _hostBuffer;
+
+    public:
+        static Ref Create(const Domain& domain)
+        {
+            return Ref(new FluidSparseScalarField(domain));
+        }
+
+        static Ref Create(const Dims& dims)
+        {
+            return Ref(new FluidSparseScalarField(dims));
+        }
+
+        /**
+         * \brief Creates a new field whose tile table is acquired, zero-filled, from the given
+         *        memory resource.
+         * \param domain Domain of the field.
+         * \param hostResource Memory resource to acquire the tile table from.
+         * \param hostFlags Flags of the host allocations.
+         */
+        static Ref Create(const Domain& domain, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidSparseScalarField(domain, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Creates a new field whose tile table is acquired, zero-filled, from the given
+         *        memory resource.
+         * \param dims Dimensions of the field.
+         * \param hostResource Memory resource to acquire the tile table from.
+         * \param hostFlags Flags of the host allocations.
+         */
+        static Ref Create(const Dims& dims, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidSparseScalarField(dims, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Returns the size of the tile table of a field with the given dimensions, in
+         *        bytes, including the padding required to place it after another one. Tiles are
+         *        allocated separately, as they are activated.
+         * \param dims Dimensions of the field.
+         * \param hostFlags Flags of the host allocations.
+         */
+        static std::size_t getHostStorageSize(const Dims& dims, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            // Tiles are allocated separately, so the flags don't change the storage held upfront.
+            (void)hostFlags;
+
+            const std::size_t alignment = HostBuffer::Alignment;
+            return (HostBuffer::getStorageSize(dims) + alignment - 1) / alignment * alignment;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    template <uint O, typename V, uint T = 8> using FluidSparseScalarFieldRef = typename FluidSparseScalarField<O, V, T>::Ref;
+
+    template <typename V> using FluidSparseScalarField2 = FluidSparseScalarField<2, V>;
+    template <typename V> using FluidSparseScalarField3 = FluidSparseScalarField<3, V>;
+    template <typename V> using FluidSparseScalarField2Ref = FluidSparseScalarFieldRef<2, V>;
+    template <typename V> using FluidSparseScalarField3Ref = FluidSparseScalarFieldRef<3, V>;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Simulator)
+
+#endif /* HF_SIMULATOR_FLUID_SPARSE_SCALAR_FIELD_HPP */
@@ -0,0 +1,180 @@
+﻿#ifndef HF_SIMULATOR_FLUID_SPARSE_VECTOR_FIELD_HPP
+#define HF_SIMULATOR_FLUID_SPARSE_VECTOR_FIELD_HPP
+
+#include <Simulator/Fluids/FluidDomain.hpp>
+#include <Simulator/Fluids/FluidSparseScalarField.hpp>
+#include <Simulator/Utility/Containers/FixedArray.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Simulator)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Vector field made of a sparse scalar field per axis (see FluidSparseScalarField),
+     *        accessed and sampled like FluidVectorField. Components of staggered fields have one
+     *        more face than cells along their axis, so their tile tables may be a tile longer.
+     * \tparam _Order Order (dimensions) of the field.
+     * \tparam _Value Type of the components.
+     * \tparam _TileSize Extent of the tiles along each axis.
+     */
+    template <uint _Order, typename _Value, uint _TileSize = 8>
+    class FluidSparseVectorField
+    {
+    public:
+        static constexpr uint Order    = _Order;
+        static constexpr uint TileSize = _TileSize;
+
+        using Ref      = HF::Ref<FluidSparseVectorField>;
+        using Value    = _Value;
+        using Domain   = FluidDomain<Order>;
+        using Dims     = IntN<Order>;
+        using Index    = IntN<Order>;
+        using Field    = FluidSparseScalarField<Order, Value, TileSize>;
+        using FieldRef = FluidSparseScalarFieldRef<Order, Value, TileSize>;
+
+        using HostAccessor      = FixedArray<Order, typename Field::HostAccessor>;
+        using HostConstAccessor = FixedArray<Order, typename Field::HostConstAccessor>;
+        using HostSampler       = FixedArray<Order, typename Field::HostSampler>;
+
+    protected:
+        FluidSparseVectorField(const Domain& domain, bool staggered, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+            : _staggered(staggered)
+        {
+            for (uint i = 0; i < Order; i++)
+            {
+                const Dims dims = getAxisDims(domain, staggered, i);
+                _fields[i] = hostResource != nullptr ? Field::Create(dims, hostResource, hostFlags) : Field::Create(dims);
+            }
+        }
+
+    public:
+        bool isStaggered() const
+        {
+            return _staggered;
+        }
+
+        const FieldRef& getAxis(uint axis) const
+        {
+            return _fields[axis];
+        }
+
+        HostConstAccessor getConstAccessor(const Compute::Location::HostTag& location) const
+        {
+            HostConstAccessor constAccessor;
+            for (uint i = 0; i < Order; i++) constAccessor[i] = _fields[i]->getConstAccessor(location);
+            return constAccessor;
+        }
+
+        HostAccessor getAccessor(const Compute::Location::HostTag& location)
+        {
+            HostAccessor accessor;
+            for (uint i = 0; i < Order; i++) accessor[i] = _fields[i]->getAccessor(location);
+            return accessor;
+        }
+
+        HostSampler getSampler(const Compute::Location::HostTag& location) const
+        {
+            HostSampler sampler;
+            for (uint i = 0; i < Order; i++) sampler[i] = _fields[i]->getSampler(location);
+            return sampler;
+        }
+
+        /**
+         * \brief Activates the tiles of every component overlapping the given region.
+         */
+        void activateRegion(const Compute::Location::HostTag& location, const Index& offset, const Dims& size)
+        {
+            for (uint i = 0; i < Order; ++i)
+                _fields[i]->activateRegion(location, offset, size);
+        }
+
+        /**
+         * \brief Makes the given tiles the active ones of every component, releasing the rest
+         *        (see Compute::SparseBuffer::setActiveTiles).
+         */
+        void setActiveTiles(const Compute::Location::HostTag& location, const std::vector<Index>& tiles)
+        {
+            for (uint i = 0; i < Order; ++i)
+                _fields[i]->setActiveTiles(location, tiles);
+        }
+
+        /**
+         * \brief Releases the tiles of each component whose values are all within the given
+         *        distance of its background value.
+         * \return No. of released tiles, across every component.
+         */
+        uint pruneTiles(const Compute::Location::HostTag& location, float threshold)
+        {
+            uint releasedCount = 0;
+
+            for (uint i = 0; i < Order; ++i)
+                releasedCount += _fields[i]->pruneTiles(location, threshold);
+
+            return releasedCount;
+        }
+
+        bool saveToFile(const Compute::Location::HostTag& location, const std::string& filename, uint axis) const
+        {
+            return _fields[axis]->saveToFile(location, filename);
+        }
+
+    private:
+        static Dims getAxisDims(const Domain& domain, bool staggered, uint axis)
+        {
+            return staggered ? domain.getDimsOfFaceGrid(axis) : domain.getDims();
+        }
+
+    private:
+        bool     _staggered;
+        FieldRef _fields[Order];
+
+    public:
+        static Ref Create(const Domain& domain, bool staggered)
+        {
+            return Ref(new FluidSparseVectorField(domain, staggered));
+        }
+
+        /**
+         * \brief Creates a new field whose tile tables are acquired, zero-filled, from the given
+         *        memory resource.
+         * \param domain Domain of the field.
+         * \param staggered Whether the components are stored on the faces of the cells.
+         * \param hostResource Memory resource to acquire the tile tables from.
+         * \param hostFlags Flags of the host allocations.
+         */
+        static Ref Create(const Domain& domain, bool staggered, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidSparseVectorField(domain, staggered, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Returns the size of the tile tables of a field over the given domain, in bytes.
+         * \param domain Domain of the field.
+         * \param staggered Whether the components are stored on the faces of the cells.
+         * \param hostFlags Flags of the host allocations.
+         */
+        static std::size_t getHostStorageSize(const Domain& domain, bool staggered, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            std::size_t size = 0;
+
+            for (uint i = 0; i < Order; i++)
+                size += Field::getHostStorageSize(getAxisDims(domain, staggered, i), hostFlags);
+
+            return size;
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    template <uint O, typename V, uint T = 8> using FluidSparseVectorFieldRef = typename FluidSparseVectorField<O, V, T>::Ref;
+
+    template <typename V> using FluidSparseVectorField2 = FluidSparseVectorField<2, V>;
+    template <typename V> using FluidSparseVectorField3 = FluidSparseVectorField<3, V>;
+    template <typename V> using FluidSparseVectorField2Ref = FluidSparseVectorFieldRef<2, V>;
+    template <typename V> using FluidSparseVectorField3Ref = FluidSparseVectorFieldRef<3, V>;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Simulator)
+
+#endif /* HF_SIMULATOR_FLUID_SPARSE_VECTOR_FIELD_HPP */
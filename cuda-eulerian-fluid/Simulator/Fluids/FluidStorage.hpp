@@ -0,0 +1,88 @@
+﻿#ifndef HF_SIMULATION_FLUID_STORAGE_HPP
+#define HF_SIMULATION_FLUID_STORAGE_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/Buffers/BufferStorage.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Simulator)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Storage types of the fields of a fluid whose traffic dominates a step. Kernels
+     *        compute in float regardless, values being converted on load and store.
+     */
+    namespace FluidStorage
+    {
+        /**
+         * \brief Every field stored in fp32.
+         */
+        struct Full
+        {
+            using Ink      = Float4;
+            using Velocity = float;
+            using Pressure = float;
+        };
+
+        /**
+         * \brief Velocity, pressure and ink stored in fp16. Halves their footprint.
+         */
+        struct Half
+        {
+            using Ink      = Compute::HalfN<4>;
+            using Velocity = Compute::Half;
+            using Pressure = Compute::Half;
+        };
+
+        /**
+         * \brief Velocity and pressure stored in bf16, keeping the range of fp32, and ink in
+         *        unorm8, which saturates it to [0, 1]. Quarters the footprint of the ink.
+         */
+        struct Compact
+        {
+            using Ink      = Compute::Unorm8N<4>;
+            using Velocity = Compute::BFloat16;
+            using Pressure = Compute::BFloat16;
+        };
+
+        /**
+         * \brief Every field stored in fp32, with ink kept as a plane per channel (see
+         *        Compute::PlanarBuffer), so that host kernels walk it a channel at a time.
+         */
+        struct Planar : Full
+        {
+            using Ink = Compute::PlanarStorage<float>;
+        };
+
+        /**
+         * \brief Every field stored in fp32, with those the step touches kept in sparse fields
+         *        only allocating the tiles (of TileSize cells along each axis) around ink, moving
+         *        fluid and obstacles. The step only sweeps those tiles, and the fluid outside of
+         *        them is at rest, behind solid walls. Host-only.
+         */
+        struct Sparse : Full
+        {
+            static constexpr uint TileSize = 8;
+        };
+
+        /**
+         * \brief Extent of the tiles of the sparse fields of the given storage, or 0 when they
+         *        are dense.
+         */
+        template <typename Storage, typename = void>
+        struct TileSizeOf : std::integral_constant<uint, 0>
+        {
+        };
+
+        template <typename Storage>
+        struct TileSizeOf<Storage, typename std::conditional<true, void, decltype(Storage::TileSize)>::type>
+            : std::integral_constant<uint, Storage::TileSize>
+        {
+        };
+    }
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Simulator)
+
+#endif /* HF_SIMULATION_FLUID_STORAGE_HPP */
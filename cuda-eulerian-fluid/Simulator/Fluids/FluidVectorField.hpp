@@ -9,27 +9,34 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint _Order, typename _Value>
+    /**
+     * \brief Vector field made of a scalar field per axis, kept in memory as the given storage
+     *        type (see Compute::BufferStorage).
+     */
+    template <uint _Order, typename _Value, typename _Storage = _Value>
     class FluidVectorField
     {
     public:
         static constexpr uint Order = _Order;
 
-        using Ref      = Ref<FluidVectorField>;
+        using Ref      = HF::Ref<FluidVectorField>;
         using Value    = _Value;
+        using Storage  = _Storage;
         using Domain   = FluidDomain<Order>;
         using Dims     = IntN<Order>;
         using Index    = IntN<Order>;
-        using Field    = FluidScalarField<Order, Value>;
-        using FieldRef = FluidScalarFieldRef<Order, Value>;
+        using Field    = FluidScalarField<Order, Value, Storage>;
+        using FieldRef = FluidScalarFieldRef<Order, Value, Storage>;
 
         using HostAccessor        = FixedArray<Order, typename Field::HostAccessor>;
         using HostConstAccessor   = FixedArray<Order, typename Field::HostConstAccessor>;
         using HostSampler         = FixedArray<Order, typename Field::HostSampler>;
 
+        #if HF_CPU_ONLY == false
         using DeviceAccessor      = FixedArray<Order, typename Field::DeviceAccessor>;
         using DeviceConstAccessor = FixedArray<Order, typename Field::DeviceConstAccessor>;
         using DeviceSampler       = FixedArray<Order, typename Field::DeviceSampler>;
+        #endif
         
     protected:
         FluidVectorField(const Dims& dims)
@@ -39,18 +46,13 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                 _fields[i] = Field::Create(dims);
         }
 
-        FluidVectorField(const Domain& domain, bool staggered)
+        FluidVectorField(const Domain& domain, bool staggered, const Compute::MemoryResource::Ref& hostResource = nullptr, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
             : _staggered(staggered)
         {
-            if (staggered)
-            {
-                for (uint i = 0; i < Order; i++)
-                    _fields[i] = Field::Create(domain.getDimsOfFaceGrid(i));
-            }
-            else
+            for (uint i = 0; i < Order; i++)
             {
-                for (uint i = 0; i < Order; i++)
-                    _fields[i] = Field::Create(domain.getDims());
+                const Dims dims = getAxisDims(domain, staggered, i);
+                _fields[i] = hostResource != nullptr ? Field::Create(dims, hostResource, hostFlags) : Field::Create(dims);
             }
         }
 
@@ -86,6 +88,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             return sampler;
         }
 
+        #if HF_CPU_ONLY == false
         DeviceConstAccessor getConstAccessor(const Compute::Location::DeviceTag& location) const
         {
             DeviceConstAccessor constAccessor;
@@ -124,6 +127,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         {
             _fields[index]->copyDeviceToResource(res);
         }
+        #endif
 
         template <typename LocationTag>
         bool loadFromFile(const LocationTag& location, const std::string& filename, uint axis) const
@@ -137,6 +141,12 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             return _fields[axis]->saveToFile(location, filename);
         }
 
+    private:
+        static Dims getAxisDims(const Domain& domain, bool staggered, uint axis)
+        {
+            return staggered ? domain.getDimsOfFaceGrid(axis) : domain.getDims();
+        }
+
     private:
         bool     _staggered;
         FieldRef _fields[Order];
@@ -151,11 +161,40 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         {
             return Ref(new FluidVectorField(domain, staggered));
         }
+
+        /**
+         * \brief Creates a new field whose host storage is acquired, zero-filled, from the given
+         *        memory resource.
+         * \param domain Domain of the field.
+         * \param staggered Whether the components are stored on the faces of the cells.
+         * \param hostResource Memory resource to acquire the host storage from.
+         * \param hostFlags Flags of the host buffers (e.g. BufferFlags::AlignRows).
+         */
+        static Ref Create(const Domain& domain, bool staggered, const Compute::MemoryResource::Ref& hostResource, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            return Ref(new FluidVectorField(domain, staggered, hostResource, hostFlags));
+        }
+
+        /**
+         * \brief Returns the size of the host storage of a field over the given domain, in bytes.
+         * \param domain Domain of the field.
+         * \param staggered Whether the components are stored on the faces of the cells.
+         * \param hostFlags Flags of the host buffers.
+         */
+        static std::size_t getHostStorageSize(const Domain& domain, bool staggered, Compute::BufferFlags hostFlags = Compute::BufferFlags::Default)
+        {
+            std::size_t size = 0;
+
+            for (uint i = 0; i < Order; i++)
+                size += Field::getHostStorageSize(getAxisDims(domain, staggered, i), hostFlags);
+
+            return size;
+        }
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
-    template <uint O, typename V> using FluidVectorFieldRef = typename FluidVectorField<O, V>::Ref;
+    template <uint O, typename V, typename S = V> using FluidVectorFieldRef = typename FluidVectorField<O, V, S>::Ref;
 
     template <typename V> using FluidVectorField1 = FluidVectorField<1, V>;
     template <typename V> using FluidVectorField2 = FluidVectorField<2, V>;
@@ -20,7 +20,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Domain  = FluidDomain<Order>;
         using Coords  = FloatN<Order>;
         using Index   = IntN<Order>;
-        using Helpers = Helpers<Order>;
+        using Helpers = Simulator::Helpers<Order>;
 
         template <typename ValueSampler,
                   typename VelocityAccessor,
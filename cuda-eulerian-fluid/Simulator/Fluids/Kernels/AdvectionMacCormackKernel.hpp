@@ -25,7 +25,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Domain  = FluidDomain3;
         using Coords  = Float3;
         using Index   = Int3;
-        using Helpers = Helpers<3>;
+        using Helpers = Simulator::Helpers<3>;
 
         template <typename ValueSampler,
                   typename ValueConstAccessor,
@@ -3,7 +3,9 @@
 
 #include <Simulator/Simulator.hpp>
 #include <Simulator/Compute/KernelConfig.hpp>
+#include <Simulator/Compute/KernelRow.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
+#include <Simulator/Compute/Buffers/PlanarBufferAccessor.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Simulator)
@@ -16,6 +18,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Config = Compute::KernelConfig<Compute::KernelBlockDims::Inferred>;
         
         using Thread = Compute::KernelThread<Order>;
+        using Row    = Compute::KernelRow<Order>;
         using Domain = FluidDomain<Order>;
         using Coords = FloatN<Order>;
         using Index  = IntN<Order>;
@@ -34,6 +37,50 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             value -= value * dissipationByTimestep;
             valueField.setValue(thread.index, value);
         }
+
+        template <typename ValueAccessor,
+                  typename Dissipation>
+        static HF_HINLINE void kernelRow(Row           row,
+                                         Domain        dom,
+                                         ValueAccessor valueField,
+                                         Dissipation   dissipationByTimestep)
+        {
+            if (any(greaterThanEqual(row.index, dom.getDims())))
+                return;
+
+            const int length = std::min(row.length, dom.getDims()[0]);
+            dissipateRow(Compute::IsPlanarAccessor<ValueAccessor>(), row, length, valueField, dissipationByTimestep);
+        }
+
+    private:
+        template <typename ValueAccessor,
+                  typename Dissipation>
+        static HF_HINLINE void dissipateRow(std::false_type, Row row, int length, ValueAccessor valueField, Dissipation dissipationByTimestep)
+        {
+            auto* values = valueField.getPtr(row.index);
+
+            for (int x = 0; x < length; ++x)
+                values[x] -= values[x] * dissipationByTimestep;
+        }
+
+        template <typename ValueAccessor,
+                  typename Dissipation>
+        static HF_HINLINE void dissipateRow(std::true_type, Row row, int length, ValueAccessor valueField, Dissipation dissipationByTimestep)
+        {
+            // Walk the row a plane at a time, so that consecutive cells are dissipated at once.
+
+            using Value = typename ValueAccessor::Value;
+            const Value dissipation = Value(dissipationByTimestep);
+
+            for (uint c = 0; c < ValueAccessor::Components; ++c)
+            {
+                auto* values = valueField.getPlanePtr(c, row.index);
+                const float componentDissipation = dissipation[c];
+
+                for (int x = 0; x < length; ++x)
+                    values[x] -= values[x] * componentDissipation;
+            }
+        }
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
@@ -32,7 +32,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                                        int           extrusion,
                                        ImageAccessor imageField)
         {
-            if (any(greaterThan(Int2(thread.index.xy), size)) && thread.index.z > extrusion)
+            if (any(greaterThan(Int2(thread.index), size)) && thread.index.z > extrusion)
                 return;
 
             Float4 image = Float4(imageField.getValue(thread.index)) / 255.0f;
@@ -89,7 +89,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         {
             Coords value;
 
-            for (uint i = 0; i < axis; ++i)
+            for (int i = 0; i < axis; ++i)
             {
                 Index nextIdx = idx; ++nextIdx[i];
                 value[i] = 0.5f * (vectorField[i].getValue(nextIdx) + vectorField[i].getValue(idx));
@@ -113,7 +113,9 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                                                          const Index& idx)
         {
             // If the index lies outside of the domain, get the corresponding face and
-            // retrieve the kind of boundary.
+            // retrieve the kind of boundary. Boundary masks have no halo (their words pack a row
+            // of cells), so faces are looked up here for every cell. Row kernels of the pressure
+            // read the faces from its halo instead (see PressureHaloKernel).
 
             const FluidDomainFace face = dom.getDomainFace(idx);
             
@@ -128,6 +130,59 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                  : FluidBounds::None;
         }
 
+        template <typename BoundaryStencil>
+        static HF_HDINLINE FluidBounds getBoundaryAtNeighbor(const Domain& dom,
+                                                             const DomainBounds& domBounds,
+                                                             const BoundaryStencil& boundaryField,
+                                                             uint axis,
+                                                             int direction)
+        {
+            // Same as getBoundaryAtCell, for the neighbour of the cell the stencil is
+            // positioned at.
+
+            auto idx = boundaryField.getIndex(); idx[axis] += direction;
+            const FluidDomainFace face = dom.getDomainFace(idx);
+
+            if (face != FluidDomainFace::None)
+                return domBounds.getFaceBoundary(face);
+
+            return boundaryField.at(axis, direction) == 1
+                 ? FluidBounds::Solid
+                 : FluidBounds::None;
+        }
+
+        template <typename BoundaryMaskConstAccessor>
+        static HF_HDINLINE uint getSolidNeighborsAtWord(const BoundaryMaskConstAccessor& boundaryField,
+                                                        const IntN<Order>& idx,
+                                                        uint axis,
+                                                        int direction)
+        {
+            // Gather, for every cell sharing the word of the boundary mask that holds the given
+            // one, the bit of its neighbour along the axis. Neighbours along X are the word
+            // itself shifted by one, with the bit crossing into the previous or next word.
+            // Neighbours beyond the domain faces read as clear, so cells next to them must take
+            // the face boundaries from elsewhere (e.g. a halo, see PressureHaloKernel).
+
+            const uint wordBits = BoundaryMaskConstAccessor::WordBits;
+            const IntN<Order>& maxIdx = boundaryField.getMaxIndex();
+
+            IntN<Order> neighborIdx = idx;
+            neighborIdx[axis] += axis == 0 ? direction * int(wordBits) : direction;
+
+            const bool isInside = neighborIdx[axis] >= 0 && neighborIdx[axis] <= (axis == 0 ? (maxIdx[0] | int(wordBits - 1)) : maxIdx[axis]);
+            const uint neighborWord = isInside ? boundaryField.getWord(neighborIdx) : 0u;
+
+            if (axis == 0)
+            {
+                const uint word = boundaryField.getWord(idx);
+
+                return direction < 0 ? (word << 1) | (neighborWord >> (wordBits - 1))
+                                     : (word >> 1) | (neighborWord << (wordBits - 1));
+            }
+
+            return neighborWord;
+        }
+
         template <typename VelocityConstAccessor>
         static HF_HDINLINE Coords getBoundaryVelocityAtCell(const Domain& dom,
                                                             const DomainBoundsVelocity& domVelocity,
@@ -0,0 +1,68 @@
+﻿#ifndef HF_SIMULATOR_FLUIDS_PRESSURE_HALO_KERNEL_HPP
+#define HF_SIMULATOR_FLUIDS_PRESSURE_HALO_KERNEL_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/KernelConfig.hpp>
+#include <Simulator/Compute/KernelThread.hpp>
+#include <Simulator/Fluids/FluidBounds.hpp>
+#include <Simulator/Fluids/FluidDomain.hpp>
+#include <Simulator/Fluids/FluidDomainBounds.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Simulator)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Fills the first layer of the halo of a pressure field (see Compute::BufferFlags::Halo1)
+     *        beyond the domain faces normal to the given axis, so that the pressure can be read
+     *        across them without checking the domain bounds: zero beyond air faces, and the value
+     *        of the adjacent cell beyond any other face. Launched over the domain dimensions with
+     *        those along the axis replaced by 2, one per face.
+     */
+    template <uint Order, typename LocationTag>
+    struct PressureHaloKernel
+    {
+        using Config = Compute::KernelConfig<Compute::KernelBlockDims::Inferred>;
+
+        using Thread       = Compute::KernelThread<Order>;
+        using Domain       = FluidDomain<Order>;
+        using DomainBounds = FluidDomainBounds<Order>;
+        using Index        = IntN<Order>;
+
+        template <typename PressureAccessor>
+        static HF_HDINLINE void kernel(Thread           thread,
+                                       Domain           dom,
+                                       DomainBounds     domBounds,
+                                       PressureAccessor pressureField,
+                                       uint             axis)
+        {
+            const Index dims = dom.getDims();
+
+            Index faceDims = dims;
+            faceDims[axis] = 2;
+
+            if (any(greaterThanEqual(thread.index, faceDims)))
+                return;
+
+            // Find the cell next to the face and the ghost one across it.
+
+            const int direction = thread.index[axis] == 0 ? -1 : 1;
+
+            Index cellIdx = thread.index;
+            cellIdx[axis] = direction < 0 ? 0 : dims[axis] - 1;
+
+            Index ghostIdx = cellIdx;
+            ghostIdx[axis] += direction;
+
+            const FluidBounds boundary = domBounds.getFaceBoundary(dom.getDomainFace(ghostIdx));
+
+            pressureField.setValue(ghostIdx, boundary == FluidBounds::Air ? 0.0f : pressureField.getValue(cellIdx));
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Simulator)
+
+#endif /* HF_SIMULATOR_FLUIDS_PRESSURE_HALO_KERNEL_HPP */
@@ -2,8 +2,10 @@
 #define HF_SIMULATOR_FLUIDS_PRESSURE_JACOBI_KERNEL_HPP
 
 #include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/KernelRow.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
 #include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/Buffers/StencilAccessor.hpp>
 #include <Simulator/Fluids/FluidBounds.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 #include <Simulator/Fluids/FluidDomainBounds.hpp>
@@ -19,11 +21,12 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Config = Compute::KernelConfig<Compute::KernelBlockDims::Inferred>;
         
         using Thread       = Compute::KernelThread<Order>;
+        using Row          = Compute::KernelRow<Order>;
         using Domain       = FluidDomain<Order>;
         using DomainBounds = FluidDomainBounds<Order>;
         using Coords       = FloatN<Order>;
         using Index        = IntN<Order>;
-        using Helpers      = Helpers<Order>;
+        using Helpers      = Simulator::Helpers<Order>;
 
         template <typename PressureConstAccessor,
                   typename DivergenceConstAccessor,
@@ -56,8 +59,11 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
                 // Retrieve divergence and pressure at the cell
 
+                const auto pressureStencil = Compute::makeStencil(pressureField, thread.index);
+                const auto boundaryStencil = Compute::makeStencil(boundaryField, thread.index);
+
                 const float divergence = divergenceField.getValue(thread.index);
-                const float pressure = pressureField.getValue(thread.index);
+                const float pressure = pressureStencil.at();
 
                 // Compute pressure laplacian taking into account boundary cells.
 
@@ -67,19 +73,16 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                 {
                     // Lookup neighbor cells and compute pressure laplacian. Take into account boundary conditions.
 
-                    Index prevIndex = thread.index; --prevIndex[axis];
-                    Index nextIndex = thread.index; ++nextIndex[axis];
-
-                    const FluidBounds prevBoundary = Helpers::getBoundaryAtCell(dom, domBounds, boundaryField, prevIndex);
-                    const FluidBounds nextBoundary = Helpers::getBoundaryAtCell(dom, domBounds, boundaryField, nextIndex);
+                    const FluidBounds prevBoundary = Helpers::getBoundaryAtNeighbor(dom, domBounds, boundaryStencil, axis, -1);
+                    const FluidBounds nextBoundary = Helpers::getBoundaryAtNeighbor(dom, domBounds, boundaryStencil, axis, 1);
 
                     const float prevPressure = prevBoundary == FluidBounds::Air ? 0.0f
                         : prevBoundary == FluidBounds::Solid ? pressure
-                        : pressureField.getValue(prevIndex);
+                        : pressureStencil.at(axis, -1);
 
                     const float nextPressure = nextBoundary == FluidBounds::Air ? 0.0f
                         : nextBoundary == FluidBounds::Solid ? pressure
-                        : pressureField.getValue(nextIndex);
+                        : pressureStencil.at(axis, 1);
 
                     pressureLaplacian += oneOverDxSqr[axis] * (nextPressure + prevPressure - 2.0f * pressure);
                 }
@@ -97,6 +100,105 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                 newPressureField.setValue(thread.index, newPressure);
             }
         }
+
+        template <typename PressureConstAccessor,
+                  typename DivergenceConstAccessor,
+                  typename BoundaryConstAccessor,
+                  typename PressureAccessor>
+        static HF_HINLINE void kernelRow(Row                     row,
+                                         Domain                  dom,
+                                         DomainBounds            domBounds,
+                                         PressureConstAccessor   pressureField,
+                                         DivergenceConstAccessor divergenceField,
+                                         BoundaryConstAccessor   boundaryField,
+                                         PressureAccessor        newPressureField,
+                                         float                   restDensityOverTimestep)
+        {
+            const Index dims = dom.getDims();
+
+            if (any(greaterThanEqual(row.index, dims)))
+                return;
+
+            const int length = std::min(row.length, dims[0]);
+
+            // Cells next to the domain faces take their neighbours from the domain bounds. When
+            // the pressure has a halo, it already holds them (see PressureHaloKernel) and every
+            // cell is handled here. Otherwise, only the interior of rows away from the faces is,
+            // and the rest of the cells go through the per-thread path.
+
+            const bool hasHalo = pressureField.getIndexer().getHalo() > 0;
+
+            int interiorBegin = hasHalo ? 0 : 1;
+            int interiorEnd = hasHalo ? length : length - 1;
+
+            for (uint axis = 1; axis < Order && !hasHalo; ++axis)
+            {
+                if (row.index[axis] == 0 || row.index[axis] + 1 >= dims[axis])
+                    interiorEnd = interiorBegin;
+            }
+
+            interiorBegin = std::min(interiorBegin, length);
+            interiorEnd = std::max(interiorEnd, interiorBegin);
+
+            for (int x = 0; x < interiorBegin; ++x)
+                kernel(row.getThread(x), dom, domBounds, pressureField, divergenceField, boundaryField, newPressureField, restDensityOverTimestep);
+
+            const Coords oneOverDx = dom.getOneOverDx();
+            const Coords oneOverDxSqr = oneOverDx * oneOverDx;
+            const float oneOverDxSqrSum = compAdd(oneOverDxSqr);
+
+            const Index pressureStride = pressureField.getStride();
+            const uint wordBits = BoundaryConstAccessor::WordBits;
+
+            const auto* pressure = pressureField.getPtr(row.index);
+            const auto* divergence = divergenceField.getPtr(row.index);
+            auto* newPressure = newPressureField.getPtr(row.index);
+
+            for (int wordBegin = interiorBegin; wordBegin < interiorEnd; )
+            {
+                // Neighbours are either inside of the domain or in the halo, so only obstacles
+                // in the boundary mask can turn them into (solid) boundaries. Fetch the bits of
+                // the neighbours of every cell sharing a word of the mask at once, so that the
+                // inner loop is left with branchless selects.
+
+                const Index wordIdx = row.getThread(wordBegin).index;
+                const int wordEnd = std::min(interiorEnd, wordBegin + int(wordBits) - (wordIdx[0] & int(wordBits - 1)));
+
+                const uint solid = boundaryField.getWord(wordIdx);
+                uint prevSolid[Order], nextSolid[Order];
+
+                for (uint axis = 0; axis < Order; ++axis)
+                {
+                    prevSolid[axis] = Helpers::getSolidNeighborsAtWord(boundaryField, wordIdx, axis, -1);
+                    nextSolid[axis] = Helpers::getSolidNeighborsAtWord(boundaryField, wordIdx, axis, 1);
+                }
+
+                for (int x = wordBegin; x < wordEnd; ++x)
+                {
+                    const uint bit = 1u << ((row.index[0] + x) & int(wordBits - 1));
+
+                    const float centerPressure = pressure[x];
+                    float pressureLaplacian = 0.0f;
+
+                    for (uint axis = 0; axis < Order; ++axis)
+                    {
+                        const float prevPressure = (prevSolid[axis] & bit) != 0 ? centerPressure : pressure[x - pressureStride[axis]];
+                        const float nextPressure = (nextSolid[axis] & bit) != 0 ? centerPressure : pressure[x + pressureStride[axis]];
+
+                        pressureLaplacian += oneOverDxSqr[axis] * (nextPressure + prevPressure - 2.0f * centerPressure);
+                    }
+
+                    const float deltaPressure = -0.5f * (restDensityOverTimestep * divergence[x] - pressureLaplacian) / oneOverDxSqrSum;
+
+                    newPressure[x] = (solid & bit) != 0 ? 0.0f : centerPressure + deltaPressure;
+                }
+
+                wordBegin = wordEnd;
+            }
+
+            for (int x = interiorEnd; x < length; ++x)
+                kernel(row.getThread(x), dom, domBounds, pressureField, divergenceField, boundaryField, newPressureField, restDensityOverTimestep);
+        }
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
@@ -4,6 +4,7 @@
 #include <Simulator/Simulator.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
 #include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/Buffers/StencilAccessor.hpp>
 #include <Simulator/Fluids/FluidBounds.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 #include <Simulator/Fluids/FluidDomainBounds.hpp>
@@ -23,7 +24,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using DomainBounds = FluidDomainBounds<Order>;
         using Coords       = FloatN<Order>;
         using Index        = IntN<Order>;
-        using Helpers      = Helpers<Order>;
+        using Helpers      = Simulator::Helpers<Order>;
 
         template <typename PressureConstAccessor,
                   typename BoundaryConstAccessor,
@@ -40,6 +41,9 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         {
             const Coords oneOverDx = dom.getOneOverDx();
 
+            const auto pressureStencil = Compute::makeStencil(pressureField, thread.index);
+            const auto boundaryStencil = Compute::makeStencil(boundaryField, thread.index);
+
             float pressureGradNorm = 0.0f;
 
             for (uint axis = 0; axis < Order; ++axis)
@@ -53,23 +57,20 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
                 // Lookup neighbor cells and compute pressure gradient. Take into account boundary conditions.
 
-                Index prevIndex = thread.index; --prevIndex[axis];
-                Index nextIndex = thread.index;
-
-                const FluidBounds prevBoundary = Helpers::getBoundaryAtCell(dom, domBounds, boundaryField, prevIndex);
-                const FluidBounds nextBoundary = Helpers::getBoundaryAtCell(dom, domBounds, boundaryField, nextIndex);
+                const FluidBounds prevBoundary = Helpers::getBoundaryAtNeighbor(dom, domBounds, boundaryStencil, axis, -1);
+                const FluidBounds nextBoundary = Helpers::getBoundaryAtCell(dom, domBounds, boundaryField, thread.index);
 
                 // Note: if both cells are boundaries, pressure gradient is zero, and therefore velocity does not change.
 
                 if (prevBoundary == FluidBounds::None || nextBoundary == FluidBounds::None)
                 {
                     const float prevPressure = prevBoundary == FluidBounds::Air ? 0.0f
-                                             : prevBoundary == FluidBounds::Solid ? pressureField.getValue(nextIndex)
-                                             : pressureField.getValue(prevIndex);
+                                             : prevBoundary == FluidBounds::Solid ? pressureStencil.at()
+                                             : pressureStencil.at(axis, -1);
 
                     const float nextPressure = nextBoundary == FluidBounds::Air ? 0.0f
-                                             : nextBoundary == FluidBounds::Solid ? pressureField.getValue(prevIndex)
-                                             : pressureField.getValue(nextIndex);
+                                             : nextBoundary == FluidBounds::Solid ? pressureStencil.at(axis, -1)
+                                             : pressureStencil.at();
 
                     vel -= timestepOverRestDensity * oneOverDx[axis] * (nextPressure - prevPressure);
                     pressureGradNorm += (nextPressure - prevPressure) * (nextPressure - prevPressure);
@@ -78,8 +79,26 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                 // Store new velocities
 
                 velocityField[axis].setValue(thread.index, vel);
-                pressureGradNormField.setValue(thread.index, sqrt(pressureGradNorm));
             }
+
+            // Store the gradient norm, which is only defined at the cells themselves.
+
+            if (all(lessThan(thread.index, dom.getDims())))
+                storePressureGradNorm(pressureGradNormField, thread.index, pressureGradNorm);
+        }
+
+    private:
+        template <typename PressureGradNormAccessor>
+        static HF_HDINLINE void storePressureGradNorm(PressureGradNormAccessor& pressureGradNormField, const Index& idx, float pressureGradNormSq)
+        {
+            pressureGradNormField.setValue(idx, sqrt(pressureGradNormSq));
+        }
+
+        /**
+         * \brief Drops the gradient norm, for fluids not storing it.
+         */
+        static HF_HDINLINE void storePressureGradNorm(std::nullptr_t, const Index&, float)
+        {
         }
     };
 
@@ -0,0 +1,197 @@
+﻿#ifndef HF_SIMULATOR_FLUIDS_PRESSURE_RED_BLACK_KERNEL_HPP
+#define HF_SIMULATOR_FLUIDS_PRESSURE_RED_BLACK_KERNEL_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/KernelRow.hpp>
+#include <Simulator/Compute/KernelThread.hpp>
+#include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/Buffers/StencilAccessor.hpp>
+#include <Simulator/Fluids/FluidBounds.hpp>
+#include <Simulator/Fluids/FluidDomain.hpp>
+#include <Simulator/Fluids/FluidDomainBounds.hpp>
+#include <Simulator/Fluids/Kernels/Helpers.hpp>
+
+HF_BEGIN_NAMESPACE(HF, Simulator)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Half of a red-black Gauss-Seidel iteration of the pressure, with successive
+     *        over-relaxation: updates in place the cells of the given color, i.e. those whose
+     *        index components add up to an even (0) or odd (1) number. Their neighbours are all
+     *        of the other color, so they can be updated concurrently, and the second half of the
+     *        iteration already reads the values written by the first one.
+     */
+    template <uint Order, typename LocationTag>
+    struct PressureRedBlackKernel
+    {
+        using Config = Compute::KernelConfig<Compute::KernelBlockDims::Inferred>;
+
+        using Thread       = Compute::KernelThread<Order>;
+        using Row          = Compute::KernelRow<Order>;
+        using Domain       = FluidDomain<Order>;
+        using DomainBounds = FluidDomainBounds<Order>;
+        using Coords       = FloatN<Order>;
+        using Index        = IntN<Order>;
+        using Helpers      = Simulator::Helpers<Order>;
+
+        template <typename PressureAccessor,
+                  typename DivergenceConstAccessor,
+                  typename BoundaryConstAccessor>
+        static HF_HDINLINE void kernel(Thread                  thread,
+                                       Domain                  dom,
+                                       DomainBounds            domBounds,
+                                       PressureAccessor        pressureField,
+                                       DivergenceConstAccessor divergenceField,
+                                       BoundaryConstAccessor   boundaryField,
+                                       float                   restDensityOverTimestep,
+                                       uint                    color,
+                                       float                   relaxation)
+        {
+            if (any(greaterThanEqual(thread.index, dom.getDims())))
+                return;
+
+            if (uint(compAdd(thread.index) & 1) != color)
+                return;
+
+            // Same as PressureJacobiKernel, with the delta scaled by the relaxation factor.
+
+            if (Helpers::getBoundaryAtCell(dom, domBounds, boundaryField, thread.index) != FluidBounds::None)
+            {
+                pressureField.setValue(thread.index, 0.0f);
+                return;
+            }
+
+            const Coords oneOverDx = dom.getOneOverDx();
+            const Coords oneOverDxSqr = oneOverDx * oneOverDx;
+
+            const auto pressureStencil = Compute::makeStencil(pressureField, thread.index);
+            const auto boundaryStencil = Compute::makeStencil(boundaryField, thread.index);
+
+            const float divergence = divergenceField.getValue(thread.index);
+            const float pressure = pressureStencil.at();
+
+            float pressureLaplacian = 0.0f;
+
+            for (uint axis = 0; axis < Order; ++axis)
+            {
+                const FluidBounds prevBoundary = Helpers::getBoundaryAtNeighbor(dom, domBounds, boundaryStencil, axis, -1);
+                const FluidBounds nextBoundary = Helpers::getBoundaryAtNeighbor(dom, domBounds, boundaryStencil, axis, 1);
+
+                const float prevPressure = prevBoundary == FluidBounds::Air ? 0.0f
+                    : prevBoundary == FluidBounds::Solid ? pressure
+                    : pressureStencil.at(axis, -1);
+
+                const float nextPressure = nextBoundary == FluidBounds::Air ? 0.0f
+                    : nextBoundary == FluidBounds::Solid ? pressure
+                    : pressureStencil.at(axis, 1);
+
+                pressureLaplacian += oneOverDxSqr[axis] * (nextPressure + prevPressure - 2.0f * pressure);
+            }
+
+            const float deltaPressure = -0.5f * (restDensityOverTimestep * divergence - pressureLaplacian) / compAdd(oneOverDxSqr);
+
+            pressureField.setValue(thread.index, pressure + relaxation * deltaPressure);
+        }
+
+        template <typename PressureAccessor,
+                  typename DivergenceConstAccessor,
+                  typename BoundaryConstAccessor>
+        static HF_HINLINE void kernelRow(Row                     row,
+                                         Domain                  dom,
+                                         DomainBounds            domBounds,
+                                         PressureAccessor        pressureField,
+                                         DivergenceConstAccessor divergenceField,
+                                         BoundaryConstAccessor   boundaryField,
+                                         float                   restDensityOverTimestep,
+                                         uint                    color,
+                                         float                   relaxation)
+        {
+            const Index dims = dom.getDims();
+
+            if (any(greaterThanEqual(row.index, dims)))
+                return;
+
+            const int length = std::min(row.length, dims[0]);
+
+            // Cells are split into interior and edges like in PressureJacobiKernel::kernelRow.
+            // Within the interior, only every other cell is of the given color.
+
+            const bool hasHalo = pressureField.getIndexer().getHalo() > 0;
+
+            int interiorBegin = hasHalo ? 0 : 1;
+            int interiorEnd = hasHalo ? length : length - 1;
+
+            for (uint axis = 1; axis < Order && !hasHalo; ++axis)
+            {
+                if (row.index[axis] == 0 || row.index[axis] + 1 >= dims[axis])
+                    interiorEnd = interiorBegin;
+            }
+
+            interiorBegin = std::min(interiorBegin, length);
+            interiorEnd = std::max(interiorEnd, interiorBegin);
+
+            for (int x = 0; x < interiorBegin; ++x)
+                kernel(row.getThread(x), dom, domBounds, pressureField, divergenceField, boundaryField, restDensityOverTimestep, color, relaxation);
+
+            const Coords oneOverDx = dom.getOneOverDx();
+            const Coords oneOverDxSqr = oneOverDx * oneOverDx;
+            const float relaxationOverDxSqrSum = relaxation / compAdd(oneOverDxSqr);
+
+            const Index pressureStride = pressureField.getStride();
+            const uint wordBits = BoundaryConstAccessor::WordBits;
+
+            // Offsets (within the row) of the cells of the given color all have this parity.
+
+            const int colorParity = int((uint(compAdd(row.index)) + color) & 1u);
+
+            auto* pressure = pressureField.getPtr(row.index);
+            const auto* divergence = divergenceField.getPtr(row.index);
+
+            for (int wordBegin = interiorBegin; wordBegin < interiorEnd; )
+            {
+                const Index wordIdx = row.getThread(wordBegin).index;
+                const int wordEnd = std::min(interiorEnd, wordBegin + int(wordBits) - (wordIdx[0] & int(wordBits - 1)));
+
+                const uint solid = boundaryField.getWord(wordIdx);
+                uint prevSolid[Order], nextSolid[Order];
+
+                for (uint axis = 0; axis < Order; ++axis)
+                {
+                    prevSolid[axis] = Helpers::getSolidNeighborsAtWord(boundaryField, wordIdx, axis, -1);
+                    nextSolid[axis] = Helpers::getSolidNeighborsAtWord(boundaryField, wordIdx, axis, 1);
+                }
+
+                for (int x = wordBegin + ((wordBegin ^ colorParity) & 1); x < wordEnd; x += 2)
+                {
+                    const uint bit = 1u << ((row.index[0] + x) & int(wordBits - 1));
+
+                    const float centerPressure = pressure[x];
+                    float pressureLaplacian = 0.0f;
+
+                    for (uint axis = 0; axis < Order; ++axis)
+                    {
+                        const float prevPressure = (prevSolid[axis] & bit) != 0 ? centerPressure : pressure[x - pressureStride[axis]];
+                        const float nextPressure = (nextSolid[axis] & bit) != 0 ? centerPressure : pressure[x + pressureStride[axis]];
+
+                        pressureLaplacian += oneOverDxSqr[axis] * (nextPressure + prevPressure - 2.0f * centerPressure);
+                    }
+
+                    const float deltaPressure = -0.5f * (restDensityOverTimestep * divergence[x] - pressureLaplacian) * relaxationOverDxSqrSum;
+
+                    pressure[x] = (solid & bit) != 0 ? 0.0f : centerPressure + deltaPressure;
+                }
+
+                wordBegin = wordEnd;
+            }
+
+            for (int x = interiorEnd; x < length; ++x)
+                kernel(row.getThread(x), dom, domBounds, pressureField, divergenceField, boundaryField, restDensityOverTimestep, color, relaxation);
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF, Simulator)
+
+#endif /* HF_SIMULATOR_FLUIDS_PRESSURE_RED_BLACK_KERNEL_HPP */
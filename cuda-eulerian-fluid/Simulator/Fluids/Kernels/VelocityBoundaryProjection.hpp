@@ -13,6 +13,11 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 {
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
+    /**
+     * \brief Projects the velocity of the faces next to solid cells so that it satisfies the solid
+     *        boundary conditions. Reads the velocity of every axis around each face, so the
+     *        projected velocity goes into a second field rather than in place.
+     */
     template <uint Order, typename LocationTag>
     struct VelocityBoundaryProjectionKernel
     {
@@ -24,11 +29,12 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using DomainBoundsVelocity = FluidDomainBoundsVelocity<Order>;
         using Coords               = FloatN<Order>;
         using Index                = IntN<Order>;
-        using Helpers              = Helpers<Order>;
+        using Helpers              = Simulator::Helpers<Order>;
 
         template <typename BoundaryConstAccessor,
                   typename BoundaryVelocityConstAccessor,
                   typename BoundaryDistanceConstAccessor,
+                  typename VelocityConstAccessor,
                   typename VelocityAccessor>
         static HF_HDINLINE void kernel(Thread                        thread,
                                        Domain                        dom,
@@ -37,7 +43,8 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                                        BoundaryConstAccessor         boundaryField,
                                        BoundaryDistanceConstAccessor boundaryDistanceField,
                                        BoundaryVelocityConstAccessor boundaryVelocityField,
-                                       VelocityAccessor              velocityField)
+                                       VelocityConstAccessor         velocityField,
+                                       VelocityAccessor              newVelocityField)
         {
             for (uint axis = 0; axis < Order; ++axis)
             {
@@ -75,7 +82,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
                 // Store new velocities.
 
-                velocityField[axis].setValue(thread.index, vel[axis]);
+                newVelocityField[axis].setValue(thread.index, vel[axis]);
             }
         }
     };
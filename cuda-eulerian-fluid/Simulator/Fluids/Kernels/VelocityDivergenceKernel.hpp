@@ -2,8 +2,10 @@
 #define HF_SIMULATOR_FLUIDS_VELOCITY_DIVERGENCE_HPP
 
 #include <Simulator/Simulator.hpp>
+#include <Simulator/Compute/KernelRow.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
 #include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/Buffers/StencilAccessor.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Simulator)
@@ -16,6 +18,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Config = Compute::KernelConfig<Compute::KernelBlockDims::Inferred>;
 
         using Thread = Compute::KernelThread<Order>;
+        using Row    = Compute::KernelRow<Order>;
         using Domain = FluidDomain<Order>;
         using Coords = FloatN<Order>;
         using Index  = IntN<Order>;
@@ -38,20 +41,70 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
             for (uint axis = 0; axis < Order; ++axis)
             {
-                // Get coordinates of closest velocity field faces.
+                // Read the closest velocity field faces and accumulate divergence.
 
-                Index prevIndex = thread.index;
-                Index nextIndex = thread.index; ++nextIndex[axis];
+                const auto velocityStencil = Compute::makeStencil(velocityField[axis], thread.index);
 
-                // Accumulate divergence.
-
-                const float prevVelocity = velocityField[axis].getValue(prevIndex);
-                const float nextVelocity = velocityField[axis].getValue(nextIndex);
+                const float prevVelocity = velocityStencil.at();
+                const float nextVelocity = velocityStencil.at(axis, 1);
                 divergence += (nextVelocity - prevVelocity) * oneOverDx[axis];
             }
 
             divergenceField.setValue(thread.index, divergence);
         }
+
+        template <typename VelocityConstAccessor,
+                  typename DivergenceAccessor>
+        static HF_HINLINE void kernelRow(Row                   row,
+                                         Domain                dom,
+                                         VelocityConstAccessor velocityField,
+                                         DivergenceAccessor    divergenceField)
+        {
+            const Index dims = dom.getDims();
+
+            if (any(greaterThanEqual(row.index, dims)))
+                return;
+
+            const int length = std::min(row.length, dims[0]);
+
+            // The last cell along each axis may read its next face from outside of the velocity
+            // field (when it is not staggered), which relies on clamped reads. Leave those cells
+            // to the per-thread path.
+
+            int interiorLength = length - 1;
+
+            for (uint axis = 1; axis < Order; ++axis)
+            {
+                if (row.index[axis] + 1 >= dims[axis])
+                    interiorLength = 0;
+            }
+
+            const Coords oneOverDx = dom.getOneOverDx();
+
+            float const* prevVelocity[Order];
+            float const* nextVelocity[Order];
+
+            for (uint axis = 0; axis < Order; ++axis)
+            {
+                prevVelocity[axis] = velocityField[axis].getPtr(row.index);
+                nextVelocity[axis] = prevVelocity[axis] + velocityField[axis].getStride()[axis];
+            }
+
+            float* divergence = divergenceField.getPtr(row.index);
+
+            for (int x = 0; x < interiorLength; ++x)
+            {
+                float value = 0;
+
+                for (uint axis = 0; axis < Order; ++axis)
+                    value += (nextVelocity[axis][x] - prevVelocity[axis][x]) * oneOverDx[axis];
+
+                divergence[x] = value;
+            }
+
+            for (int x = std::max(interiorLength, 0); x < length; ++x)
+                kernel(row.getThread(x), dom, velocityField, divergenceField);
+        }
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
@@ -4,6 +4,7 @@
 #include <Simulator/Simulator.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
 #include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/Buffers/StencilAccessor.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 #include <Simulator/Fluids/Kernels/Helpers.hpp>
 
@@ -20,7 +21,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Domain       = FluidDomain<Order>;
         using Coords       = FloatN<Order>;
         using Index        = UintN<Order>;
-        using Helpers      = Helpers<Order>;
+        using Helpers      = Simulator::Helpers<Order>;
 
         template <typename VelocityConstAccessor,
                   typename VelocityAccessor>
@@ -44,22 +45,18 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
                 // Initialize it with the common component corresponding to the velocity
                 // at the current index.
 
-                float value = velocityField[axis].getValue(thread.index);
+                const auto velocityStencil = Compute::makeStencil(velocityField[axis], thread.index);
+
+                float value = velocityStencil.at();
                 float laplacian = -2.0f * value * compAdd(oneOverDxSqr);
 
                 for (uint otherAxis = 0; otherAxis < Order; ++otherAxis)
                 {
-                    // Determine adjacent indices
-
-                    Index prevIndex = thread.index; 
-                    Index nextIndex = thread.index;
-                    if (prevIndex[otherAxis] > 0)                   --prevIndex[otherAxis];
-                    if (nextIndex[otherAxis] < dims[otherAxis] - 1) ++nextIndex[otherAxis];
-                    
-                    // Compute partial contribution to the laplacian.
+                    // Compute partial contribution to the laplacian. Adjacent values are clamped
+                    // to the edges of the face grid.
 
-                    const float prevValue = velocityField[axis].getValue(prevIndex);
-                    const float nextValue = velocityField[axis].getValue(nextIndex);
+                    const float prevValue = velocityStencil.at(otherAxis, -1);
+                    const float nextValue = velocityStencil.at(otherAxis, 1);
                     laplacian += (prevValue + nextValue) * oneOverDxSqr[otherAxis];
                 }
 
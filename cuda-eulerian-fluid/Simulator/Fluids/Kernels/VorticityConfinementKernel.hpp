@@ -5,6 +5,7 @@
 #include <Simulator/Compute/KernelConfig.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
 #include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/Buffers/StencilAccessor.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 #include <Simulator/Fluids/Kernels/Helpers.hpp>
 
@@ -26,7 +27,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Domain  = FluidDomain3;
         using Coords  = Float3;
         using Index   = Int3;
-        using Helpers = Helpers<3>;
+        using Helpers = Simulator::Helpers<3>;
 
         template <typename VorticityConstAccessor, 
                   typename VorticityNormConstAccessor, 
@@ -46,12 +47,14 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             // Compute vorticity confinement at the center of the cell
             // First compute N = eta / |eta|, where eta = ∇|w|
 
-            const float wxf = vorticityNormField.getValue(thread.index + Index(1, 0, 0));
-            const float wxb = vorticityNormField.getValue(thread.index + Index(-1, 0, 0));
-            const float wyf = vorticityNormField.getValue(thread.index + Index(0, 1, 0));
-            const float wyb = vorticityNormField.getValue(thread.index + Index(0, -1, 0));
-            const float wzf = vorticityNormField.getValue(thread.index + Index(0, 0, 1));
-            const float wzb = vorticityNormField.getValue(thread.index + Index(0, 0, -1));
+            const auto norm = Compute::makeStencil(vorticityNormField, thread.index);
+
+            const float wxf = norm.template at< 1, 0, 0>();
+            const float wxb = norm.template at<-1, 0, 0>();
+            const float wyf = norm.template at<0,  1, 0>();
+            const float wyb = norm.template at<0, -1, 0>();
+            const float wzf = norm.template at<0, 0,  1>();
+            const float wzb = norm.template at<0, 0, -1>();
 
             const Coords eta = 0.5f * Coords(wxf - wxb, wyf - wyb, wzf - wzb) / dx;
             const Coords N = eta / (length(eta) + 1e-5f);
@@ -5,6 +5,7 @@
 #include <Simulator/Compute/KernelConfig.hpp>
 #include <Simulator/Compute/KernelThread.hpp>
 #include <Simulator/Compute/KernelBlockDims.hpp>
+#include <Simulator/Compute/Buffers/StencilAccessor.hpp>
 #include <Simulator/Fluids/FluidDomain.hpp>
 
 HF_BEGIN_NAMESPACE(HF, Simulator)
@@ -43,13 +44,16 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
 
             // w = ∇×u = ∂uy/∂x - ∂ux/∂
 
-            const float duy_dx = oneOverDx[0] * (velocityField[1].getValue(thread.index + Int2(1, 0)) - velocityField[1].getValue(thread.index));
-            const float dux_dy = oneOverDx[1] * (velocityField[0].getValue(thread.index + Int2(0, 1)) - velocityField[0].getValue(thread.index));
+            const auto ux = Compute::makeStencil(velocityField[0], thread.index);
+            const auto uy = Compute::makeStencil(velocityField[1], thread.index);
+
+            const float duy_dx = oneOverDx[0] * (uy.template at<1, 0>() - uy.at());
+            const float dux_dy = oneOverDx[1] * (ux.template at<0, 1>() - ux.at());
             
             const float w = duy_dx - dux_dy;
 
             vorticityField[0].setValue(thread.index, w);
-            vorticityNormField.setValue(abs(w));
+            vorticityNormField.setValue(thread.index, abs(w));
         }
     };
 
@@ -64,7 +68,6 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
         using Domain  = FluidDomain3;
         using Coords  = Float3;
         using Index   = Int3;
-        using Helpers = Helpers<3>;
 
         template <typename VelocityConstAccessor,
                   typename VorticityAccessor,
@@ -96,18 +99,25 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
             const Coords w = Coords(duz_dy - duy_dz, dux_dz - duz_dx, duy_dx - dux_dy);
             */
 
-            const float duz_dy = oneOverDx[1] * (Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0,  1, 0), 2) -
-                                                 Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0, -1, 0), 2));
-            const float duy_dz = oneOverDx[2] * (Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0, 0,  1), 1) -
-                                                 Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0, 0, -1), 1));
-            const float dux_dz = oneOverDx[2] * (Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0, 0,  1), 0) -
-                                                 Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0, 0, -1), 0));
-            const float duz_dx = oneOverDx[0] * (Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3( 1, 0, 0), 2) -
-                                                 Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(-1, 0, 0), 2));
-            const float duy_dx = oneOverDx[0] * (Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3( 1, 0, 0), 1) -
-                                                 Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(-1, 0, 0), 1));
-            const float dux_dy = oneOverDx[1] * (Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0,  1, 0), 0) -
-                                                 Helpers::getStaggeredVectorAtCell(velocityField, thread.index + Int3(0, -1, 0), 0));
+            // Velocities are averaged at the centers of the neighbouring cells, i.e. from the faces
+            // at the given offset and the next one along the axis of each component.
+
+            const auto ux = Compute::makeStencil(velocityField[0], thread.index);
+            const auto uy = Compute::makeStencil(velocityField[1], thread.index);
+            const auto uz = Compute::makeStencil(velocityField[2], thread.index);
+
+            const float duz_dy = oneOverDx[1] * (0.5f * (uz.template at<0,  1, 1>() + uz.template at<0,  1, 0>()) -
+                                                 0.5f * (uz.template at<0, -1, 1>() + uz.template at<0, -1, 0>()));
+            const float duy_dz = oneOverDx[2] * (0.5f * (uy.template at<0, 1,  1>() + uy.template at<0, 0,  1>()) -
+                                                 0.5f * (uy.template at<0, 1, -1>() + uy.template at<0, 0, -1>()));
+            const float dux_dz = oneOverDx[2] * (0.5f * (ux.template at<1, 0,  1>() + ux.template at<0, 0,  1>()) -
+                                                 0.5f * (ux.template at<1, 0, -1>() + ux.template at<0, 0, -1>()));
+            const float duz_dx = oneOverDx[0] * (0.5f * (uz.template at< 1, 0, 1>() + uz.template at< 1, 0, 0>()) -
+                                                 0.5f * (uz.template at<-1, 0, 1>() + uz.template at<-1, 0, 0>()));
+            const float duy_dx = oneOverDx[0] * (0.5f * (uy.template at< 1, 1, 0>() + uy.template at< 1, 0, 0>()) -
+                                                 0.5f * (uy.template at<-1, 1, 0>() + uy.template at<-1, 0, 0>()));
+            const float dux_dy = oneOverDx[1] * (0.5f * (ux.template at<1,  1, 0>() + ux.template at<0,  1, 0>()) -
+                                                 0.5f * (ux.template at<1, -1, 0>() + ux.template at<0, -1, 0>()));
             const Coords w = 0.5f * Coords(duz_dy - duy_dz, dux_dz - duz_dx, duy_dx - dux_dy);
 
             vorticityField[0].setValue(thread.index, w.x);
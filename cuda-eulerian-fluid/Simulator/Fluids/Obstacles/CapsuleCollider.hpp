@@ -14,7 +14,7 @@ HF_BEGIN_NAMESPACE(HF, Simulator)
     {
     public:
         static constexpr uint Order = _Order;
-        using FloatN = FloatN<_Order>;
+        using FloatN = HF::FloatN<_Order>;
         using AABB = Geometry::AABB<_Order>;
 
     public:
@@ -84,7 +84,7 @@ HF_BEGIN_NAMESPACE(HF, Math)
          */
         Value evaluateSegment(uint segment, float t) const
         {
-            const int index0 = max(segment - 1, 0);
+            const int index0 = max(int(segment) - 1, 0);
             const int index1 = segment;
             const int index2 = min(segment + 1, getNumNodes() - 1);
             const int index3 = min(segment + 2u, getNumNodes() - 1);
@@ -115,7 +115,7 @@ HF_BEGIN_NAMESPACE(HF, Math)
          */
         Value evaluateSegmentDerivative(uint segment, float t) const
         {
-            const int index0 = max(segment - 1, 0);
+            const int index0 = max(int(segment) - 1, 0);
             const int index1 = segment;
             const int index2 = min(segment + 1, getNumNodes() - 1);
             const int index3 = min(segment + 2u, getNumNodes() - 1);
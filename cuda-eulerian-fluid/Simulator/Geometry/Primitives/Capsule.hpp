@@ -12,7 +12,7 @@ HF_BEGIN_NAMESPACE(HF, Geometry)
     {
     public:
         static constexpr uint Order = _Order;
-        using FloatN = FloatN<_Order>;
+        using FloatN = HF::FloatN<_Order>;
 
     public:
         Capsule()
@@ -45,7 +45,7 @@ HF_BEGIN_NAMESPACE(HF, Geometry)
             return _end;
         }
 
-        HF_HDINLINE void setEnd(const FloatN& start)
+        HF_HDINLINE void setEnd(const FloatN& end)
         {
             _end = end;
         }
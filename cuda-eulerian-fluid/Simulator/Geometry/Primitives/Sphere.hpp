@@ -13,7 +13,7 @@ HF_BEGIN_NAMESPACE(HF, Geometry)
     {
     public:
         static constexpr uint Order = _Order;
-        using FloatN = FloatN<_Order>;
+        using FloatN = HF::FloatN<_Order>;
 
     public:
         Sphere()
@@ -8,6 +8,13 @@
 
 //─────────────────────────────────────────────────────────────────────────────────────────────────
 
+// Backend configuration. Define HF_CPU_ONLY as true (e.g. from the compiler command line) to
+// build the host path with a standard C++ compiler, without the CUDA toolkit.
+
+#if !defined(HF_CPU_ONLY)
+#define HF_CPU_ONLY false
+#endif
+
 // Simulator configuration
 
 #define HF_DEVICE_FIELDS_AS_ARRAYS true
@@ -17,6 +24,13 @@
 #define HF_SYNCHRONIZE_AT_KERNELS      false
 #define HF_SYNCHRONIZE_AT_MEM_TRANSFER false
 
+// Define HF_PROFILE_KERNELS as true to gather per-kernel execution statistics (see
+// Compute::KernelProfiler). Device launches are synchronized while profiling.
+
+#if !defined(HF_PROFILE_KERNELS)
+#define HF_PROFILE_KERNELS false
+#endif
+
 // Interop configuration
 
 #define HF_SUPPORT_OPENGL_INTEROP true
@@ -25,40 +39,62 @@
 #define HF_SUPPORT_D3D11_INTEROP  false
 #define HF_SUPPORT_VULKAN_INTEROP true
 
+#if HF_CPU_ONLY == true
+#undef  HF_SUPPORT_OPENGL_INTEROP
+#undef  HF_SUPPORT_VULKAN_INTEROP
+#define HF_SUPPORT_OPENGL_INTEROP false
+#define HF_SUPPORT_VULKAN_INTEROP false
+#endif
+
 // GLM configuration
 
 #define GLM_ENABLE_EXPERIMENTAL
-#define GLM_FORCE_CUDA
 #define GLM_FORCE_SWIZZLE
 
+#if HF_CPU_ONLY == false
+#define GLM_FORCE_CUDA
+#endif
+
 //─────────────────────────────────────────────────────────────────────────────────────────────────
 
 // STL headers.
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-// CUDA headers.
+// CUDA headers (unless building for the host only).
 
+#if HF_CPU_ONLY == false
 #include <cuda.h>
 #include <cuda_runtime.h>
+#endif
 
 // GLM headers.
 
@@ -45,6 +45,8 @@ HF_BEGIN_NAMESPACE(HF)
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
+    #if HF_CPU_ONLY == false
+
     class CudaException : public Exception
     {
     public:
@@ -69,6 +71,8 @@ HF_BEGIN_NAMESPACE(HF)
         cudaError_t _cudaErrorCode;
     };
 
+    #endif
+
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
     #define HF_THROW(MSG)                                                                         \
@@ -153,6 +157,8 @@ HF_BEGIN_NAMESPACE(HF)
     #define HF_CRITICAL_ASSERT_ARE_EQUAL(VAL1, VAL2, MSG)                                         \
         HF_HALT_ON_THROW(HF_ASSERT_ARE_EQUAL(VAL1, VAL2, MSG))                                    
                                                                                                   
+    #if HF_CPU_ONLY == false
+
     #define HF_THROW_CUDA(CODE, ...)                                                              \
         throw HF::CudaException(CODE, __FILE__, __LINE__, __VA_ARGS__)                            
                                                                                                   
@@ -171,6 +177,8 @@ HF_BEGIN_NAMESPACE(HF)
     #define HF_CUDA(CODE, ...)                                                                    \
         HF_CATCH_CUDA(cuda ## CODE, __VA_ARGS__)
 
+    #endif
+
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
     
@@ -16,8 +16,8 @@ HF_BEGIN_NAMESPACE(HF)
         static constexpr uint Count = 8ull * sizeof(Type);
 
         template <uint B> struct Bit  { static constexpr Type Value = (B % (HiPeriod + LoPeriod)) < LoPeriod; };
-        template <uint B> struct Seq  { static constexpr Type Value = Bit<B>::Value | Seq<B + 1>::Value << 1; };
-        template <> struct Seq<Count> { static constexpr Type Value = 0; };
+        template <uint B, bool End = B == Count> struct Seq { static constexpr Type Value = Bit<B>::Value | Seq<B + 1>::Value << 1; };
+        template <uint B> struct Seq<B, true>               { static constexpr Type Value = 0; };
 
         static constexpr Type Value = Seq<0>::Value;
     };
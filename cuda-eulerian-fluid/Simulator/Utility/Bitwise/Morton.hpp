@@ -163,6 +163,47 @@ HF_BEGIN_NAMESPACE(HF)
     };
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Byte-wise lookup tables spreading the bits of a value N bits apart, as done by
+     *        Morton<T, N, 64>::Encode, for hosts where table lookups beat the shift-and-mask
+     *        sequence. Host only.
+     */
+    template <uint N>
+    struct MortonLut
+    {
+        static constexpr uint Bits = 64 / N;
+
+        struct Table
+        {
+            ulonglong values[256] = {};
+
+            constexpr Table()
+            {
+                for (uint x = 0; x < 256; ++x)
+                {
+                    for (uint bit = 0; bit < 8; ++bit)
+                        values[x] |= ulonglong((x >> bit) & 1) << (N * bit);
+                }
+            }
+        };
+
+        static constexpr Table Values = Table();
+
+        static HF_HINLINE ulonglong Encode(ulonglong x)
+        {
+            ulonglong code = 0;
+
+            for (uint byte = 0; byte < (Bits + 7) / 8; ++byte)
+                code |= Values.values[(x >> (8 * byte)) & 0xFF] << (8 * N * byte);
+
+            return code;
+        }
+    };
+
+    template <uint N> constexpr typename MortonLut<N>::Table MortonLut<N>::Values;
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
 }
 HF_END_NAMESPACE(HF)
 
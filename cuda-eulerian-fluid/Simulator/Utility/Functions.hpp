@@ -156,6 +156,8 @@ HF_BEGIN_NAMESPACE(HF)
 
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
+    #if HF_CPU_ONLY == false
+
     // Casting to CUDA built-in types
 
     HF_HDINLINE uchar1 cast(const uchar &x)  { return make_uchar1(uchar(x)); }
@@ -204,6 +206,8 @@ HF_BEGIN_NAMESPACE(HF)
     HF_HINLINE cudaExtent castCudaExtents(const Int2& v) { return make_cudaExtent(uint(v.x), uint(v.y), 1); }
     HF_HINLINE cudaExtent castCudaExtents(const Int3& v) { return make_cudaExtent(uint(v.x), uint(v.y), uint(v.z)); }
 
+    #endif
+
     //─────────────────────────────────────────────────────────────────────────────────────────────
 
     // Additional math functions
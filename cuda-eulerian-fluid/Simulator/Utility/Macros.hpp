@@ -15,9 +15,25 @@
 
 //─────────────────────────────────────────────────────────────────────────────────────────────────
 
+#if HF_CPU_ONLY == true
+#define HF_HINLINE  inline
+#define HF_DINLINE  inline
+#define HF_HDINLINE inline
+#else
 #define HF_HINLINE  __host__ inline
 #define HF_DINLINE  __forceinline__ __device__
 #define HF_HDINLINE __forceinline__ __host__ __device__
+#endif
+
+//─────────────────────────────────────────────────────────────────────────────────────────────────
+
+// Selects the given CUDA constant, or its value when building for the host only.
+
+#if HF_CPU_ONLY == true
+#define HF_CUDA_CONSTANT(NAME, VALUE) VALUE
+#else
+#define HF_CUDA_CONSTANT(NAME, VALUE) NAME
+#endif
 
 //─────────────────────────────────────────────────────────────────────────────────────────────────
 
@@ -80,8 +96,11 @@
 #define HF_NAMESPACE_END_HELPER2(_Ns1, _Ns2) }                  HF_NAMESPACE_END_HELPER1(_Ns2)
 #define HF_NAMESPACE_END_HELPER3(_Ns1, _Ns2, _Ns3) }            HF_NAMESPACE_END_HELPER2(_Ns2, _Ns3)
 
-#define HF_BEGIN_NAMESPACE(_Namespace, ...)                     HF_VA_SELECT(HF_NAMESPACE_BEGIN_HELPER, _Namespace, __VA_ARGS__)
-#define HF_END_NAMESPACE(_Namespace, ...)                       HF_VA_SELECT(HF_NAMESPACE_END_HELPER,   _Namespace, __VA_ARGS__)
+// The namespaces are all taken from __VA_ARGS__: a separate first parameter would leave an empty
+// trailing argument for a single namespace, which GCC counts, opening an anonymous namespace.
+
+#define HF_BEGIN_NAMESPACE(...)                                 HF_VA_SELECT(HF_NAMESPACE_BEGIN_HELPER, __VA_ARGS__)
+#define HF_END_NAMESPACE(...)                                   HF_VA_SELECT(HF_NAMESPACE_END_HELPER,   __VA_ARGS__)
 
 //─────────────────────────────────────────────────────────────────────────────────────────────────
 
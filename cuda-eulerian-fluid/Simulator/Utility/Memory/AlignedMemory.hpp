@@ -0,0 +1,65 @@
+﻿#ifndef HF_SIMULATOR_UTILITY_MEMORY_ALIGNEDMEMORY_HPP
+#define HF_SIMULATOR_UTILITY_MEMORY_ALIGNEDMEMORY_HPP
+
+#include <Simulator/Simulator.hpp>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+HF_BEGIN_NAMESPACE(HF)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Allocates a block of host memory whose address is a multiple of the given alignment.
+     *        The block must be released with alignedFree().
+     * \param size Size of the block, in bytes.
+     * \param alignment Alignment of the block, in bytes. Must be a power of two, and a multiple of
+     *                  sizeof(void*).
+     * \return Pointer to the allocated block.
+     */
+    HF_HINLINE void* alignedAlloc(std::size_t size, std::size_t alignment)
+    {
+        void* ptr = nullptr;
+
+        #if defined(_MSC_VER)
+        ptr = _aligned_malloc(size, alignment);
+        #else
+        if (posix_memalign(&ptr, alignment, size) != 0)
+            ptr = nullptr;
+        #endif
+
+        HF_ASSERT(ptr != nullptr || size == 0, format("Unable to allocate %zu bytes of host memory.", size));
+        return ptr;
+    }
+
+    /**
+     * \brief Releases a block of host memory acquired with alignedAlloc().
+     * \param ptr Pointer to the block. May be null.
+     */
+    HF_HINLINE void alignedFree(void* ptr)
+    {
+        #if defined(_MSC_VER)
+        _aligned_free(ptr);
+        #else
+        std::free(ptr);
+        #endif
+    }
+
+    /**
+     * \brief Deleter releasing blocks acquired with alignedAlloc(), for use with std::unique_ptr.
+     */
+    struct AlignedDeleter
+    {
+        HF_HINLINE void operator()(void* ptr) const
+        {
+            alignedFree(ptr);
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF)
+
+#endif /* HF_SIMULATOR_UTILITY_MEMORY_ALIGNEDMEMORY_HPP */
@@ -0,0 +1,171 @@
+﻿#ifndef HF_SIMULATOR_UTILITY_MEMORY_MAPPEDFILE_HPP
+#define HF_SIMULATOR_UTILITY_MEMORY_MAPPEDFILE_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Utility/Memory/AlignedMemory.hpp>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HF_FILE_MAPPING true
+#else
+#define HF_FILE_MAPPING false
+#endif
+
+HF_BEGIN_NAMESPACE(HF)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Contents of a file, mapped copy-on-write into the address space of the process:
+     *        pages are read from the file on first access, and writes to them are private to the
+     *        process, never reaching the file.
+     *
+     *        Where mapping files is unsupported, the contents are read into a host block instead.
+     *        Files that cannot be opened, mapped or read leave the object invalid (see isValid)
+     *        rather than failing, so callers can report the error as they see fit.
+     */
+    class MappedFile
+    {
+    public:
+        using Ref = HF::Ref<MappedFile>;
+
+    protected:
+        MappedFile(const std::string& filename)
+            : _data(nullptr)
+            , _size(0)
+            , _mapped(false)
+            , _valid(false)
+        {
+            #if HF_FILE_MAPPING == true
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+
+            if (fd < 0)
+                return;
+
+            struct stat status;
+
+            if (fstat(fd, &status) == 0)
+            {
+                void* data = status.st_size > 0 ? mmap(nullptr, std::size_t(status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) : nullptr;
+
+                if (data != MAP_FAILED)
+                {
+                    _data = static_cast<char*>(data);
+                    _size = _data != nullptr ? std::size_t(status.st_size) : 0;
+                    _mapped = _data != nullptr;
+                    _valid = true;
+                }
+            }
+
+            ::close(fd);
+            #else
+            std::ifstream stream(filename, std::ifstream::binary | std::ifstream::ate);
+
+            if (!stream.good())
+                return;
+
+            _size = std::size_t(stream.tellg());
+            _data = static_cast<char*>(alignedAlloc(_size, 64));
+
+            stream.seekg(0);
+            stream.read(_data, std::streamsize(_size));
+
+            _valid = stream.good();
+            #endif
+        }
+
+    public:
+        ~MappedFile()
+        {
+            #if HF_FILE_MAPPING == true
+            if (_mapped)
+                munmap(_data, _size);
+            #else
+            alignedFree(_data);
+            #endif
+        }
+
+        HF_COPY_IMPLEMENTATION(MappedFile, delete)
+        HF_MOVE_IMPLEMENTATION(MappedFile, delete)
+
+    public:
+        /**
+         * \brief Returns whether the file could be opened and its contents mapped or read.
+         *        Invalid files have no usable contents.
+         */
+        bool isValid() const
+        {
+            return _valid;
+        }
+
+        /**
+         * \brief Returns the contents of the file. Null for empty files.
+         */
+        char* getData() const
+        {
+            return _data;
+        }
+
+        /**
+         * \brief Returns the size of the file, in bytes.
+         */
+        std::size_t getSize() const
+        {
+            return _size;
+        }
+
+        /**
+         * \brief Returns whether the contents are mapped from the file, rather than read.
+         */
+        bool isMapped() const
+        {
+            return _mapped;
+        }
+
+        /**
+         * \brief Hints that the given range of the file will be read sequentially and soon, so
+         *        its pages can be read ahead. Does nothing if the contents are not mapped.
+         * \param offset Offset of the range, in bytes.
+         * \param size Size of the range, in bytes.
+         */
+        void adviseSequential(std::size_t offset, std::size_t size) const
+        {
+            #if HF_FILE_MAPPING == true && defined(MADV_SEQUENTIAL) && defined(MADV_WILLNEED)
+            if (!_mapped || size == 0)
+                return;
+
+            // Advice must start on a page boundary.
+
+            const std::size_t pageSize = std::size_t(sysconf(_SC_PAGESIZE));
+            const std::size_t begin = offset / pageSize * pageSize;
+
+            madvise(_data + begin, offset + size - begin, MADV_SEQUENTIAL);
+            madvise(_data + begin, offset + size - begin, MADV_WILLNEED);
+            #endif
+        }
+
+    private:
+        char*       _data;
+        std::size_t _size;
+        bool        _mapped;
+        bool        _valid;
+
+    public:
+        /**
+         * \brief Maps the contents of the given file.
+         * \param filename Path to the file.
+         */
+        static Ref Create(const std::string& filename)
+        {
+            return Ref(new MappedFile(filename));
+        }
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF)
+
+#endif /* HF_SIMULATOR_UTILITY_MEMORY_MAPPEDFILE_HPP */
@@ -0,0 +1,145 @@
+﻿#ifndef HF_SIMULATOR_UTILITY_THREADING_NUMATOPOLOGY_HPP
+#define HF_SIMULATOR_UTILITY_THREADING_NUMATOPOLOGY_HPP
+
+#include <Simulator/Simulator.hpp>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+HF_BEGIN_NAMESPACE(HF)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Description of the NUMA nodes of the host, and of the CPUs belonging to each of
+     *        them. Read from sysfs on Linux; every other platform (or a Linux host without NUMA
+     *        support) is described as a single node holding every hardware thread.
+     */
+    class NumaTopology
+    {
+    public:
+        NumaTopology() = delete;
+
+    public:
+        /**
+         * \brief Returns the no. of NUMA nodes with at least one CPU.
+         */
+        static uint getNodeCount()
+        {
+            return uint(getNodes().size());
+        }
+
+        /**
+         * \brief Returns the CPUs belonging to the given NUMA node.
+         * \param node Index of the node, in [0, getNodeCount()).
+         */
+        static const std::vector<uint>& getNodeCpus(uint node)
+        {
+            HF_ASSERT(node < getNodeCount(), format("NUMA node %u does not exist.", node));
+            return getNodes()[node];
+        }
+
+        /**
+         * \brief Restricts the calling thread to run on the given CPU.
+         * \param cpu Index of the CPU.
+         * \return Whether the thread could be pinned.
+         */
+        static bool pinCurrentThread(uint cpu)
+        {
+            #if defined(__linux__)
+            if (cpu >= CPU_SETSIZE)
+                return false;
+
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+
+            return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+            #else
+            return false;
+            #endif
+        }
+
+    private:
+        static const std::vector<std::vector<uint>>& getNodes()
+        {
+            static const std::vector<std::vector<uint>> nodes = readNodes();
+            return nodes;
+        }
+
+        static std::vector<std::vector<uint>> readNodes()
+        {
+            std::vector<std::vector<uint>> nodes;
+
+            #if defined(__linux__)
+            // Node indices may have gaps (e.g. offline or memory-only nodes), so probe a
+            // reasonable range instead of stopping at the first missing one.
+
+            for (uint node = 0; node < MaxNodeCount; ++node)
+            {
+                std::ifstream file(format("/sys/devices/system/node/node%u/cpulist", node));
+                std::string cpuList;
+
+                if (!std::getline(file, cpuList))
+                    continue;
+
+                std::vector<uint> cpus = parseCpuList(cpuList);
+
+                if (!cpus.empty())
+                    nodes.push_back(std::move(cpus));
+            }
+            #endif
+
+            if (nodes.empty())
+            {
+                std::vector<uint> cpus(std::max(1u, std::thread::hardware_concurrency()));
+
+                for (uint cpu = 0; cpu < cpus.size(); ++cpu)
+                    cpus[cpu] = cpu;
+
+                nodes.push_back(std::move(cpus));
+            }
+
+            return nodes;
+        }
+
+        static std::vector<uint> parseCpuList(const std::string& cpuList)
+        {
+            // The list is made of comma separated ranges, such as "0-3,8-11,16".
+
+            std::vector<uint> cpus;
+            std::istringstream stream(cpuList);
+            std::string range;
+
+            while (std::getline(stream, range, ','))
+            {
+                uint first, last;
+                const int count = std::sscanf(range.c_str(), "%u-%u", &first, &last);
+
+                if (count < 1)
+                    continue;
+
+                if (count == 1)
+                    last = first;
+
+                for (uint cpu = first; cpu <= last; ++cpu)
+                    cpus.push_back(cpu);
+            }
+
+            return cpus;
+        }
+
+    private:
+        /**
+         * \brief Max. index of the NUMA nodes probed on Linux.
+         */
+        static constexpr uint MaxNodeCount = 64;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF)
+
+#endif /* HF_SIMULATOR_UTILITY_THREADING_NUMATOPOLOGY_HPP */
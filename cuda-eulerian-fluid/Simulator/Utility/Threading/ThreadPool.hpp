@@ -0,0 +1,447 @@
+﻿#ifndef HF_SIMULATOR_UTILITY_THREADING_THREADPOOL_HPP
+#define HF_SIMULATOR_UTILITY_THREADING_THREADPOOL_HPP
+
+#include <Simulator/Simulator.hpp>
+#include <Simulator/Utility/Threading/NumaTopology.hpp>
+
+HF_BEGIN_NAMESPACE(HF)
+{
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+
+    /**
+     * \brief Pool of persistent worker threads used to execute data-parallel jobs on the host.
+     *        The thread submitting a job always takes part in its execution, so a pool with a
+     *        worker count of N keeps N - 1 background threads alive.
+     *
+     *        Every job is split into one contiguous range of tasks per worker. Workers consume
+     *        their own range front to back in chunks of the job grain size and, once it runs
+     *        dry, steal the back half of the largest range left.
+     *
+     *        Workers may be pinned to a list of CPUs. Pinned pools hand range i of every job to
+     *        worker i (the submitting thread being worker 0), so that consecutive jobs over the
+     *        same data keep touching it from the same CPUs.
+     */
+    class ThreadPool
+    {
+    private:
+        /**
+         * \brief Range of pending tasks, packed as [begin, end) in a single word so that owners
+         *        and thieves can update it with a single compare-and-swap.
+         */
+        struct alignas(64) Slot
+        {
+            std::atomic<ulonglong> range;
+        };
+
+        struct Job
+        {
+            using Function = void (*)(void* context, uint begin, uint end);
+
+            Job(Function function, void* context, uint taskCount, uint grainSize, uint slotCount)
+                : function(function)
+                , context(context)
+                , taskCount(taskCount)
+                , grainSize(grainSize)
+                , slots(slotCount)
+                , nextSlot(0)
+                , finishedTasks(0)
+                , userCount(0)
+            {
+                for (uint i = 0; i < slotCount; ++i)
+                {
+                    const uint begin = uint(ulonglong(taskCount) * i / slotCount);
+                    const uint end = uint(ulonglong(taskCount) * (i + 1) / slotCount);
+                    slots[i].range.store(pack(begin, end), std::memory_order_relaxed);
+                }
+            }
+
+            Function           function;
+            void*              context;
+            uint               taskCount;
+            uint               grainSize;
+            std::vector<Slot>  slots;
+            std::atomic<uint>  nextSlot;
+            std::atomic<uint>  finishedTasks;
+            uint               userCount;
+            std::exception_ptr exception;
+        };
+
+    public:
+        /**
+         * \brief Creates a new thread pool.
+         * \param workerCount No. of threads taking part in each job, including the calling thread.
+         * \param affinity CPU each worker is pinned to, or empty to leave them unpinned. The first
+         *                 entry corresponds to the submitting thread, which is never pinned.
+         */
+        explicit ThreadPool(uint workerCount, const std::vector<uint>& affinity = {})
+            : _affinity(affinity)
+            , _stopping(false)
+        {
+            startWorkers(workerCount);
+        }
+
+        ~ThreadPool()
+        {
+            stopWorkers();
+        }
+
+        HF_COPY_IMPLEMENTATION(ThreadPool, delete)
+        HF_MOVE_IMPLEMENTATION(ThreadPool, delete)
+
+    public:
+        /**
+         * \brief Returns the no. of threads taking part in each job, including the calling thread.
+         */
+        uint getWorkerCount() const
+        {
+            return uint(_threads.size()) + 1;
+        }
+
+        /**
+         * \brief Changes the no. of threads taking part in each job. Must not be called while
+         *        any job is being executed by the pool.
+         * \param workerCount No. of threads taking part in each job, including the calling thread.
+         */
+        void setWorkerCount(uint workerCount)
+        {
+            if (workerCount == getWorkerCount())
+                return;
+
+            stopWorkers();
+            startWorkers(workerCount);
+        }
+
+        /**
+         * \brief Returns the CPU each worker is pinned to, or an empty list if they are unpinned.
+         */
+        const std::vector<uint>& getAffinity() const
+        {
+            return _affinity;
+        }
+
+        /**
+         * \brief Changes the CPUs the workers are pinned to. Must not be called while any job is
+         *        being executed by the pool.
+         * \param affinity CPU each worker is pinned to, or empty to leave them unpinned. The first
+         *                 entry corresponds to the submitting thread, which is never pinned.
+         */
+        void setAffinity(const std::vector<uint>& affinity)
+        {
+            const uint workerCount = getWorkerCount();
+
+            stopWorkers();
+            _affinity = affinity;
+            startWorkers(workerCount);
+        }
+
+        /**
+         * \brief Executes the given function over every task index in [0, taskCount), sharing
+         *        the tasks between the pool workers and the calling thread. Returns once every
+         *        task has finished. Exceptions thrown by the tasks are rethrown on the caller.
+         * \tparam Function Type of the function to execute. Must be callable as func(begin, end),
+         *                  and process every task in the range [begin, end).
+         * \param taskCount No. of tasks to execute.
+         * \param grainSize Max. no. of tasks handed to a worker at once.
+         * \param func Function to execute.
+         */
+        template <typename Function>
+        void parallelFor(uint taskCount, uint grainSize, Function&& func)
+        {
+            if (taskCount == 0)
+                return;
+
+            grainSize = std::max(1u, grainSize);
+
+            if (taskCount <= grainSize || _threads.empty())
+            {
+                func(0u, taskCount);
+                return;
+            }
+
+            using FunctionType = typename std::remove_reference<Function>::type;
+
+            auto invoker = [](void* context, uint begin, uint end)
+            {
+                (*static_cast<FunctionType*>(context))(begin, end);
+            };
+
+            void* context = const_cast<void*>(static_cast<const void*>(&func));
+            const uint slotCount = std::min(getWorkerCount(), (taskCount + grainSize - 1) / grainSize);
+
+            Job job(invoker, context, taskCount, grainSize, slotCount);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _jobs.push_back(&job);
+            }
+
+            _wakeUp.notify_all();
+
+            runTasks(job, getWorkerIndex());
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+
+                _jobDone.wait(lock, [&job]
+                {
+                    return job.finishedTasks.load() == job.taskCount && job.userCount == 0;
+                });
+
+                removeJob(job);
+            }
+
+            if (job.exception)
+                std::rethrow_exception(job.exception);
+        }
+
+        /**
+         * \brief Executes the given function once for every task index in [0, taskCount),
+         *        handing tasks to the workers one at a time.
+         * \tparam Function Type of the function to execute. Must be callable as func(uint).
+         * \param taskCount No. of tasks to execute.
+         * \param func Function to execute.
+         */
+        template <typename Function>
+        void parallelFor(uint taskCount, Function&& func)
+        {
+            parallelFor(taskCount, 1u, [&func](uint begin, uint end)
+            {
+                for (uint task = begin; task < end; ++task)
+                    func(task);
+            });
+        }
+
+    private:
+        static ulonglong pack(uint begin, uint end)
+        {
+            return (ulonglong(begin) << 32) | ulonglong(end);
+        }
+
+        static uint getBegin(ulonglong range)
+        {
+            return uint(range >> 32);
+        }
+
+        static uint getEnd(ulonglong range)
+        {
+            return uint(range & 0xFFFFFFFFull);
+        }
+
+    private:
+        void startWorkers(uint workerCount)
+        {
+            const uint threadCount = workerCount > 1 ? workerCount - 1 : 0;
+
+            _stopping = false;
+            _threads.reserve(threadCount);
+
+            for (uint i = 0; i < threadCount; ++i)
+                _threads.emplace_back(&ThreadPool::workerMain, this, i + 1);
+        }
+
+        void stopWorkers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+
+            _wakeUp.notify_all();
+
+            for (auto& thread : _threads)
+                thread.join();
+
+            _threads.clear();
+        }
+
+        void workerMain(uint workerIndex)
+        {
+            getWorkerIndex() = workerIndex;
+
+            if (workerIndex < _affinity.size())
+                NumaTopology::pinCurrentThread(_affinity[workerIndex]);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (true)
+            {
+                _wakeUp.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+
+                if (_stopping)
+                    return;
+
+                // Register as a user of the job, so the submitting thread does not release it
+                // while we are still looking at it.
+
+                Job& job = *_jobs.front();
+                job.userCount++;
+
+                lock.unlock();
+                runTasks(job, workerIndex);
+                lock.lock();
+
+                job.userCount--;
+                removeJob(job);
+
+                _jobDone.notify_all();
+            }
+        }
+
+        void runTasks(Job& job, uint workerIndex)
+        {
+            // Pinned workers always start from the same range, otherwise the first to arrive
+            // takes the first one.
+
+            const uint slot = _affinity.empty() ? job.nextSlot.fetch_add(1) : workerIndex;
+            const uint slotCount = uint(job.slots.size());
+
+            uint begin, end;
+
+            // Drain our own range first, then keep stealing until every range is empty.
+
+            if (slot < slotCount)
+            {
+                while (popChunk(job, job.slots[slot], begin, end))
+                    runChunk(job, begin, end);
+            }
+
+            while (stealRange(job, begin, end))
+            {
+                if (slot < slotCount)
+                {
+                    // Publish the stolen range, so it can be stolen from us in turn.
+
+                    job.slots[slot].range.store(pack(begin, end));
+
+                    while (popChunk(job, job.slots[slot], begin, end))
+                        runChunk(job, begin, end);
+                }
+                else
+                {
+                    for (uint chunk = begin; chunk < end; chunk += job.grainSize)
+                        runChunk(job, chunk, std::min(chunk + job.grainSize, end));
+                }
+            }
+        }
+
+        void runChunk(Job& job, uint begin, uint end)
+        {
+            try
+            {
+                job.function(job.context, begin, end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_exceptionMutex);
+
+                if (!job.exception)
+                    job.exception = std::current_exception();
+            }
+
+            job.finishedTasks.fetch_add(end - begin);
+        }
+
+        bool popChunk(Job& job, Slot& slot, uint& begin, uint& end)
+        {
+            ulonglong range = slot.range.load();
+
+            while (true)
+            {
+                const uint rangeBegin = getBegin(range);
+                const uint rangeEnd = getEnd(range);
+
+                if (rangeBegin >= rangeEnd)
+                    return false;
+
+                const uint chunkEnd = std::min(rangeBegin + job.grainSize, rangeEnd);
+
+                if (slot.range.compare_exchange_weak(range, pack(chunkEnd, rangeEnd)))
+                {
+                    begin = rangeBegin;
+                    end = chunkEnd;
+                    return true;
+                }
+            }
+        }
+
+        bool stealRange(Job& job, uint& begin, uint& end)
+        {
+            while (true)
+            {
+                // Pick the victim with the most pending tasks.
+
+                Slot* victim = nullptr;
+                ulonglong victimRange = 0;
+                uint victimSize = 0;
+
+                for (Slot& slot : job.slots)
+                {
+                    const ulonglong range = slot.range.load();
+                    const uint size = getEnd(range) > getBegin(range) ? getEnd(range) - getBegin(range) : 0;
+
+                    if (size > victimSize)
+                    {
+                        victim = &slot;
+                        victimRange = range;
+                        victimSize = size;
+                    }
+                }
+
+                if (victim == nullptr)
+                    return false;
+
+                // Take the back half of the range, or all of it if it does not exceed a chunk.
+
+                const uint rangeBegin = getBegin(victimRange);
+                const uint rangeEnd = getEnd(victimRange);
+                const uint stolenSize = victimSize > job.grainSize ? victimSize / 2 : victimSize;
+
+                if (victim->range.compare_exchange_strong(victimRange, pack(rangeBegin, rangeEnd - stolenSize)))
+                {
+                    begin = rangeEnd - stolenSize;
+                    end = rangeEnd;
+                    return true;
+                }
+            }
+        }
+
+        void removeJob(Job& job)
+        {
+            // Jobs whose tasks have all been claimed are of no use to idle workers anymore.
+
+            for (const Slot& slot : job.slots)
+            {
+                const ulonglong range = slot.range.load();
+
+                if (getBegin(range) < getEnd(range))
+                    return;
+            }
+
+            const auto it = std::find(_jobs.begin(), _jobs.end(), &job);
+
+            if (it != _jobs.end())
+                _jobs.erase(it);
+        }
+
+        static uint& getWorkerIndex()
+        {
+            static thread_local uint workerIndex = 0;
+            return workerIndex;
+        }
+
+    private:
+        std::vector<uint>        _affinity;
+        std::vector<std::thread> _threads;
+        std::deque<Job*>         _jobs;
+        std::mutex               _mutex;
+        std::mutex               _exceptionMutex;
+        std::condition_variable  _wakeUp;
+        std::condition_variable  _jobDone;
+        bool                     _stopping;
+    };
+
+    //─────────────────────────────────────────────────────────────────────────────────────────────
+}
+HF_END_NAMESPACE(HF)
+
+#endif /* HF_SIMULATOR_UTILITY_THREADING_THREADPOOL_HPP */
@@ -71,13 +71,19 @@ HF_BEGIN_NAMESPACE(HF)
 
     template <typename Vec> struct Traits;
 
+    #if HF_CPU_ONLY == true
+    #define HF_DEFINE_BUILT_IN_TYPE(B)
+    #else
+    #define HF_DEFINE_BUILT_IN_TYPE(B) using BuiltInType = B;
+    #endif
+
     #define HF_DEFINE_TRAITS(T, S, D, FP, B)                                                      \
         template <> struct Traits<T>                                                              \
         {                                                                                         \
             using ScalarType = S;                                                                 \
             static constexpr uint Dims = D;                                                       \
             static constexpr bool IsFloatingPoint = FP;                                           \
-            using BuiltInType = B;                                                                \
+            HF_DEFINE_BUILT_IN_TYPE(B)                                                            \
         }                            
     
     HF_DEFINE_TRAITS(bool,   bool,  1, false, uchar1);
@@ -107,6 +113,7 @@ HF_BEGIN_NAMESPACE(HF)
     HF_DEFINE_TRAITS(Float4, float, 4, true,  float4);
 
     #undef HF_DEFINE_TRAITS
+    #undef HF_DEFINE_BUILT_IN_TYPE
 
     template <typename T> struct ScalarOf
     {